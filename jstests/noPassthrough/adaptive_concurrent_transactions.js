@@ -0,0 +1,62 @@
+/**
+ * Tests that the numbers of concurrent read and write transactions are adjusted automatically
+ * within bounds when wiredTigerAdaptiveConcurrentTransactions is set, and that the decisions are
+ * reported in serverStatus.
+ *
+ * @tags: [
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        wiredTigerConcurrentReadTransactions: 64,
+        wiredTigerConcurrentWriteTransactions: 64,
+        wiredTigerAdaptiveConcurrentTransactionsIntervalMillis: 50,
+    }
+});
+const admin = conn.getDB('admin');
+
+function getConcurrentTransactions() {
+    return assert.commandWorked(admin.runCommand({serverStatus: 1}))
+        .wiredTiger.concurrentTransactions;
+}
+
+// The numbers of tickets are left alone until the adjustment is enabled.
+let stats = getConcurrentTransactions();
+for (let kind of ['read', 'write']) {
+    assert.eq(64, stats[kind].totalTickets, tojson(stats));
+    assert.eq('hold', stats[kind].adaptive.lastDecision, tojson(stats));
+}
+
+// Bounds which exclude the current numbers of tickets bring them within the bounds.
+assert.commandWorked(admin.runCommand({
+    setParameter: 1,
+    wiredTigerAdaptiveConcurrentTransactionsMin: 20,
+    wiredTigerAdaptiveConcurrentTransactionsMax: 20,
+}));
+assert.commandWorked(
+    admin.runCommand({setParameter: 1, wiredTigerAdaptiveConcurrentTransactions: true}));
+assert.soon(() => {
+    stats = getConcurrentTransactions();
+    return stats.read.totalTickets === 20 && stats.write.totalTickets === 20;
+}, () => tojson(stats));
+
+// Operations keep running while the adjustment is enabled.
+const coll = conn.getDB(jsTestName()).coll;
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+assert.eq(100, coll.find().itcount());
+
+stats = getConcurrentTransactions();
+for (let kind of ['read', 'write']) {
+    const adaptive = stats[kind].adaptive;
+    assert.gte(adaptive.decreases, 1, tojson(stats));
+    assert.gte(adaptive.lastThroughputPerSec, 0, tojson(stats));
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,58 @@
+/**
+ * Tests that index builds which scan the collection on multiple threads build the same indexes as
+ * a single-threaded collection scan.
+ *
+ * @tags: [
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {setParameter: {maxIndexBuildCollectionScanThreads: 4}},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.getCollection(jsTestName());
+
+const numDocs = 50 * 1000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, a: numDocs - i, b: [i % 7, i % 11], c: i % 3, d: "x" + i});
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandWorked(coll.createIndexes([
+    {a: 1},
+    {b: 1},
+    {c: -1, d: 1},
+    {d: 1},
+]));
+assert.commandWorked(coll.createIndex({a: -1}, {partialFilterExpression: {c: 0}}));
+assert.commandWorked(coll.createIndex({d: -1}, {unique: true}));
+
+checkLog.containsJson(primary, 5962000);
+
+// Every key of every document must be present in each index.
+assert.eq(numDocs, coll.find().hint({a: 1}).itcount());
+assert.eq(numDocs, coll.find().hint({c: -1, d: 1}).itcount());
+assert.eq(numDocs, coll.find().hint({d: 1}).itcount());
+assert.eq(numDocs, coll.find().hint({d: -1}).itcount());
+assert.eq(Math.ceil(numDocs / 3), coll.find({c: 0}).hint({a: -1}).itcount());
+assert.eq(numDocs, coll.find({b: {$gte: 0}}).hint({b: 1}).itcount());
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+
+// A unique index build still reports duplicate keys that fall in different ranges.
+assert.commandWorked(coll.insert({_id: numDocs, a: 1}));
+assert.commandFailedWithCode(coll.createIndex({a: 1, e: 1}, {unique: true}),
+                             ErrorCodes.DuplicateKey);
+
+rst.stopSet();
+})();
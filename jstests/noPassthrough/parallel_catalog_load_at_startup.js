@@ -0,0 +1,49 @@
+/**
+ * Tests that the collections and indexes opened on several threads at startup are all usable, and
+ * that serverStatus reports the time taken by each phase of startup.
+ *
+ * @tags: [
+ *   requires_persistence,
+ * ]
+ */
+(function() {
+'use strict';
+
+const numCollections = 50;
+
+let conn = MongoRunner.runMongod({setParameter: {storageEngineCatalogLoadThreads: 8}});
+let testDB = conn.getDB(jsTestName());
+for (let i = 0; i < numCollections; i++) {
+    const coll = testDB.getCollection('coll' + i);
+    assert.commandWorked(coll.insert({_id: i, a: i, b: -i}));
+    assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+}
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({
+    dbpath: conn.dbpath,
+    noCleanData: true,
+    setParameter: {storageEngineCatalogLoadThreads: 8},
+});
+testDB = conn.getDB(jsTestName());
+
+for (let i = 0; i < numCollections; i++) {
+    const coll = testDB.getCollection('coll' + i);
+    assert.eq(3, coll.getIndexes().length, tojson(coll.getIndexes()));
+    assert.eq({_id: i, a: i, b: -i}, coll.findOne({a: i}));
+    assert.eq({_id: i, a: i, b: -i}, coll.find({b: -i}).hint({b: 1}).next());
+}
+
+const startupTimings = assert.commandWorked(testDB.adminCommand({serverStatus: 1})).startupTimings;
+assert(startupTimings.startupComplete, tojson(startupTimings));
+assert.gte(startupTimings.totalMillis, 0, tojson(startupTimings));
+for (let phase of ['initializeStorageEngine',
+                   'loadCatalogReadEntries',
+                   'loadCatalogOpenCollections',
+                   'loadCatalogRegisterCollections',
+                   'repairAndRecoverDatabases']) {
+    assert.gte(startupTimings.phaseMillis[phase], 0, tojson(startupTimings));
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,51 @@
+// Test that the TTL monitor expires documents from several collections using multiple workers and
+// a per-collection time budget, and reports the collections left with expired documents in the
+// 'ttl' serverStatus section.
+(function() {
+"use strict";
+
+const runner = MongoRunner.runMongod({
+    setParameter: {
+        ttlMonitorSleepSecs: 1,
+        ttlMonitorNumWorkers: 4,
+        ttlMonitorCollectionTimeBudgetMS: 1,
+    }
+});
+const db = runner.getDB("test");
+
+const ttlStatus = db.serverStatus().ttl;
+assert.eq(4, ttlStatus.workers, tojson(ttlStatus));
+
+// Pause the TTL monitor while the expired documents are inserted.
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: false}));
+
+const numDocs = 5000;
+const now = new Date();
+const collNames = ["a", "b", "c"];
+for (const collName of collNames) {
+    const coll = db[collName];
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; i++) {
+        bulk.insert({x: now});
+    }
+    assert.commandWorked(bulk.execute());
+}
+
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+// With a one millisecond budget each collection takes several passes to empty.
+assert.soon(function() {
+    return collNames.every(collName => db[collName].find().itcount() === 0);
+}, "TTL monitor didn't expire all documents before timing out.");
+
+// Once every expired document has been removed, no collection is reported with a backlog.
+const ttlPass = db.serverStatus().metrics.ttl.passes;
+assert.soon(function() {
+    return db.serverStatus().metrics.ttl.passes >= ttlPass + 2;
+}, "TTL monitor didn't run before timing out.");
+assert.docEq({}, db.serverStatus().ttl.collections);
+
+MongoRunner.stopMongod(runner);
+})();
@@ -0,0 +1,81 @@
+/**
+ * Tests that a column store index answers queries whose filter, projection and sort only reference
+ * the indexed paths, reading documents the index does not cover from the collection instead.
+ *
+ * @tags: [featureFlagColumnstoreIndexes]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.column_store_index;
+coll.drop();
+
+const numDocs = 100;
+let docs = [];
+for (let i = 0; i < numDocs; i++) {
+    // Every tenth document has an array in the middle of the 'b.c' path, which the index cannot
+    // store in a single cell.
+    const b = (i % 10 === 0) ? [{c: i}, {c: -i}] : {c: i, d: "unindexed"};
+    docs.push({_id: i, a: i % 7, b: b, pad: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Only column store paths may appear in the key pattern, and the index cannot be unique, sparse or
+// partial.
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(
+    coll.createIndex({a: "columnstore"}, {partialFilterExpression: {a: {$gt: 1}}}),
+    ErrorCodes.CannotCreateIndex);
+
+assert.commandWorked(coll.createIndex({_id: "columnstore", a: "columnstore", "b.c": "columnstore"}));
+
+function assertColumnScanMatchesCollScan(filter, projection, expectColumnScan) {
+    const expected = coll.find(filter, projection).hint({$natural: 1}).toArray();
+    assert.sameMembers(expected, coll.find(filter, projection).toArray());
+
+    const explain = coll.find(filter, projection).explain("executionStats");
+    const columnScan = getPlanStage(getWinningPlan(explain.queryPlanner), "COLUMN_SCAN");
+    if (expectColumnScan) {
+        assert.neq(null, columnScan, tojson(explain));
+        assert.eq(expected.length, explain.executionStats.nReturned, tojson(explain));
+    } else {
+        assert.eq(null, columnScan, tojson(explain));
+    }
+}
+
+assertColumnScanMatchesCollScan({}, {a: 1}, true);
+assertColumnScanMatchesCollScan({a: {$gte: 3}}, {_id: 0, a: 1}, true);
+assertColumnScanMatchesCollScan({"b.c": {$lt: 50}}, {a: 1, "b.c": 1}, true);
+
+// The documents with an array along 'b.c' are read from the collection.
+let explain = coll.find({}, {"b.c": 1}).explain("executionStats");
+let columnScan = getPlanStage(explain.executionStats.executionStages, "COLUMN_SCAN");
+assert.neq(null, columnScan, tojson(explain));
+assert.eq(numDocs / 10, columnScan.docsFetched, tojson(columnScan));
+assert.eq(numDocs - numDocs / 10, columnScan.docsAssembled, tojson(columnScan));
+
+// Queries which reference a path outside the index, or which return whole documents, scan the
+// collection.
+assertColumnScanMatchesCollScan({}, {a: 1, pad: 1}, false);
+assertColumnScanMatchesCollScan({pad: {$exists: true}}, {a: 1}, false);
+assertColumnScanMatchesCollScan({a: 1}, {}, false);
+
+// Writes are reflected in the index columns.
+assert.commandWorked(coll.update({_id: 1}, {$set: {a: 100, "b.c": "updated"}}));
+assert.commandWorked(coll.remove({_id: 2}));
+assert.commandWorked(coll.insert({_id: numDocs, a: 100}));
+assertColumnScanMatchesCollScan({a: 100}, {a: 1, "b.c": 1}, true);
+assert.sameMembers([{_id: 1, a: 100, b: {c: "updated"}}, {_id: numDocs, a: 100}],
+                   coll.find({a: 100}, {a: 1, "b.c": 1}).toArray());
+
+// The index is still consistent with the collection.
+const validateRes = coll.validate({full: true});
+assert(validateRes.valid, tojson(validateRes));
+})();
@@ -738,14 +738,18 @@ public:
         OperationContext* opCtx, const std::vector<BSONObj>& indexSpecs) const = 0;
 
     /**
-     * Returns a plan executor for a collection scan over this collection.
+     * Returns a plan executor for a collection scan over this collection. If 'minRecord' or
+     * 'maxRecord' are given, the scan is limited to the RecordIds between them, inclusively. They
+     * cannot be combined with 'resumeAfterRecordId'.
      */
     virtual std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> makePlanExecutor(
         OperationContext* opCtx,
         const CollectionPtr& yieldableCollection,
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         ScanDirection scanDirection,
-        boost::optional<RecordId> resumeAfterRecordId = boost::none) const = 0;
+        boost::optional<RecordId> resumeAfterRecordId = boost::none,
+        boost::optional<RecordId> minRecord = boost::none,
+        boost::optional<RecordId> maxRecord = boost::none) const = 0;
 
     virtual void indexBuildSuccess(OperationContext* opCtx, IndexCatalogEntry* index) = 0;
 
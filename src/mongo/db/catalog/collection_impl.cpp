@@ -74,7 +74,9 @@
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/ttl_collection_cache.h"
+#include "mongo/db/update/document_diff_applier.h"
 #include "mongo/db/update/update_driver.h"
+#include "mongo/db/update/update_oplog_entry_serialization.h"
 
 #include "mongo/db/auth/user_document_parser.h"  // XXX-ANDY
 #include "mongo/logv2/log.h"
@@ -242,6 +244,63 @@ bool indexTypeSupportsPathLevelMultikeyTracking(StringData accessMethod) {
     return accessMethod == IndexNames::BTREE || accessMethod == IndexNames::GEO_2DSPHERE;
 }
 
+// Record stores only write documents up to this size in full, so computing damage events for
+// them is wasted work. Matches the threshold below which WiredTiger does not attempt a modify.
+const int kMinDocSizeForDamageHint = 1024;
+
+/**
+ * Translates the $v:2 delta in 'update' into damage events which turn 'oldDoc' into 'newDoc', with
+ * source offsets referring to 'newDoc'. Returns false if 'update' is not a delta or if applying the
+ * events would not reproduce 'newDoc' exactly, as happens when the update stage reorders or adds
+ * the _id field after logging the diff.
+ */
+bool computeDamagesFromDelta(const BSONObj& oldDoc,
+                             const BSONObj& newDoc,
+                             const BSONObj& update,
+                             mutablebson::DamageVector* damages) {
+    if (update.isEmpty() ||
+        update_oplog_entry::extractUpdateType(update) != update_oplog_entry::UpdateType::kV2Delta)
+        return false;
+
+    auto diff = update[update_oplog_entry::kDiffObjectFieldName];
+    if (diff.type() != BSONType::Object)
+        return false;
+
+    auto output = doc_diff::computeDamages(oldDoc, diff.embeddedObject(), true);
+    const char* source = output.damageSource.get();
+    const char* pre = oldDoc.objdata();
+    const char* post = newDoc.objdata();
+    const size_t preSize = oldDoc.objsize();
+    const size_t postSize = newDoc.objsize();
+
+    // Walk the events in order, checking both the bytes they write and the unchanged bytes between
+    // them against 'newDoc'. Offsets are cumulative, so 'preOffset' tracks where the unchanged
+    // bytes at 'postOffset' came from in 'oldDoc'.
+    size_t preOffset = 0;
+    size_t postOffset = 0;
+    for (auto& damage : output.damages) {
+        if (damage.targetOffset < postOffset)
+            return false;
+        const size_t gap = damage.targetOffset - postOffset;
+        if (preOffset + gap + damage.targetSize > preSize ||
+            damage.targetOffset + damage.sourceSize > postSize ||
+            std::memcmp(pre + preOffset, post + postOffset, gap) != 0 ||
+            std::memcmp(
+                source + damage.sourceOffset, post + damage.targetOffset, damage.sourceSize) != 0)
+            return false;
+
+        preOffset += gap + damage.targetSize;
+        postOffset = damage.targetOffset + damage.sourceSize;
+        damage.sourceOffset = damage.targetOffset;
+    }
+    if (preSize - preOffset != postSize - postOffset ||
+        std::memcmp(pre + preOffset, post + postOffset, postSize - postOffset) != 0)
+        return false;
+
+    *damages = std::move(output.damages);
+    return true;
+}
+
 }  // namespace
 
 CollectionImpl::SharedState::SharedState(CollectionImpl* collection,
@@ -1177,8 +1236,18 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
     }
     args->preImageRecordingEnabledForCollection = getRecordPreImages();
 
-    uassertStatusOK(_shared->_recordStore->updateRecord(
-        opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    // When the update is logged as a delta, hand the storage engine the changed byte ranges so it
+    // does not need to compare the whole document to find them.
+    mutablebson::DamageVector damages;
+    if (newDoc.objsize() > kMinDocSizeForDamageHint &&
+        _shared->_recordStore->updateWithDamagesSupported() &&
+        computeDamagesFromDelta(oldDoc.value(), newDoc, args->update, &damages)) {
+        uassertStatusOK(_shared->_recordStore->updateRecordWithDamageHint(
+            opCtx, oldLocation, newDoc.objdata(), newDoc.objsize(), damages));
+    } else {
+        uassertStatusOK(_shared->_recordStore->updateRecord(
+            opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    }
 
     if (indexesAffected) {
         int64_t keysInserted, keysDeleted;
@@ -1611,11 +1680,18 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> CollectionImpl::makePlanExe
     const CollectionPtr& yieldableCollection,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     ScanDirection scanDirection,
-    boost::optional<RecordId> resumeAfterRecordId) const {
+    boost::optional<RecordId> resumeAfterRecordId,
+    boost::optional<RecordId> minRecord,
+    boost::optional<RecordId> maxRecord) const {
     auto isForward = scanDirection == ScanDirection::kForward;
     auto direction = isForward ? InternalPlanner::FORWARD : InternalPlanner::BACKWARD;
-    return InternalPlanner::collectionScan(
-        opCtx, &yieldableCollection, yieldPolicy, direction, resumeAfterRecordId);
+    return InternalPlanner::collectionScan(opCtx,
+                                           &yieldableCollection,
+                                           yieldPolicy,
+                                           direction,
+                                           resumeAfterRecordId,
+                                           minRecord,
+                                           maxRecord);
 }
 
 Status CollectionImpl::rename(OperationContext* opCtx, const NamespaceString& nss, bool stayTemp) {
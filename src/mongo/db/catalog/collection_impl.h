@@ -403,7 +403,9 @@ public:
         const CollectionPtr& yieldableCollection,
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         ScanDirection scanDirection,
-        boost::optional<RecordId> resumeAfterRecordId) const final;
+        boost::optional<RecordId> resumeAfterRecordId,
+        boost::optional<RecordId> minRecord,
+        boost::optional<RecordId> maxRecord) const final;
 
     void indexBuildSuccess(OperationContext* opCtx, IndexCatalogEntry* index) final;
 
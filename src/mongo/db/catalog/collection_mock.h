@@ -339,7 +339,9 @@ public:
         const CollectionPtr& yieldableCollection,
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         ScanDirection scanDirection,
-        boost::optional<RecordId> resumeAfterRecordId) const {
+        boost::optional<RecordId> resumeAfterRecordId,
+        boost::optional<RecordId> minRecord,
+        boost::optional<RecordId> maxRecord) const {
         std::abort();
     }
 
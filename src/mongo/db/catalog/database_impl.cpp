@@ -49,6 +49,7 @@
 #include "mongo/db/catalog/drop_indexes.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
+#include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
 #include "mongo/db/concurrency/d_concurrency.h"
@@ -72,12 +73,14 @@
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/system_index.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/random.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -127,6 +130,52 @@ void assertMovePrimaryInProgress(OperationContext* opCtx, NamespaceString const&
     }
 }
 
+/**
+ * Initializes 'collections', which opens the tables of their indexes, on up to 'numThreads'
+ * threads. Each thread uses its own operation and takes no locks, so the caller must hold the
+ * global lock in exclusive mode. Throws the first error of any thread.
+ */
+void initCollectionsInParallel(const std::vector<Collection*>& collections, size_t numThreads) {
+    AtomicWord<size_t> nextToInit{0};
+    Mutex mutex = MONGO_MAKE_LATCH("DatabaseImpl::initCollectionsInParallel::mutex");
+    Status status = Status::OK();
+
+    auto initCollections = [&] {
+        auto opCtx = cc().makeOperationContext();
+        for (size_t i = nextToInit.fetchAndAdd(1); i < collections.size();
+             i = nextToInit.fetchAndAdd(1)) {
+            try {
+                collections[i]->init(opCtx.get());
+            } catch (const DBException& ex) {
+                stdx::lock_guard<Latch> lk(mutex);
+                if (status.isOK()) {
+                    status = ex.toStatus();
+                }
+                nextToInit.store(collections.size());
+                return;
+            }
+        }
+    };
+
+    ThreadPool::Options options;
+    options.poolName = "CollectionInit";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) { Client::initThread(threadName); };
+    ThreadPool pool(options);
+    pool.startup();
+    for (size_t i = 0; i < numThreads; ++i) {
+        pool.schedule([&](Status scheduleStatus) {
+            invariant(scheduleStatus);
+            initCollections();
+        });
+    }
+    pool.shutdown();
+    pool.join();
+
+    uassertStatusOK(status);
+}
+
 }  // namespace
 
 Status DatabaseImpl::validateDBName(StringData dbname) {
@@ -169,6 +218,13 @@ void DatabaseImpl::init(OperationContext* const opCtx) const {
         uasserted(10028, status.toString());
     }
 
+    // Under the global exclusive lock, as at startup, the collections are modified in place, and
+    // nothing else can access them until this returns. They are then initialized on several
+    // threads.
+    const bool initInParallel =
+        opCtx->lockState()->isW() && !opCtx->lockState()->inAWriteUnitOfWork();
+    std::vector<Collection*> collectionsToInit;
+
     auto catalog = CollectionCatalog::get(opCtx);
     for (const auto& uuid : catalog->getAllCollectionUUIDsFromDb(_name)) {
         CollectionWriter collection(
@@ -179,7 +235,21 @@ void DatabaseImpl::init(OperationContext* const opCtx) const {
         invariant(collection);
         // If this is called from the repair path, the collection is already initialized.
         if (!collection->isInitialized()) {
-            collection.getWritableCollection()->init(opCtx);
+            if (initInParallel) {
+                collectionsToInit.push_back(collection.getWritableCollection());
+            } else {
+                collection.getWritableCollection()->init(opCtx);
+            }
+        }
+    }
+
+    const size_t numThreads = std::min(
+        static_cast<size_t>(gStorageEngineCatalogLoadThreads.load()), collectionsToInit.size());
+    if (numThreads > 1) {
+        initCollectionsInParallel(collectionsToInit, numThreads);
+    } else {
+        for (auto collection : collectionsToInit) {
+            collection->init(opCtx);
         }
     }
 
@@ -56,6 +56,7 @@
 #include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
+#include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/delete.h"
@@ -699,6 +700,34 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx,
         }
     }
 
+    if (pluginName == IndexNames::COLUMN) {
+        // Binaries of an older FCV cannot read a column store index, so one may only be created
+        // once the FCV has been upgraded. The FCV is not yet known during startup recovery and
+        // initial sync, which only rebuild indexes that were allowed when they were first built.
+        const auto& fcv = serverGlobalParams.featureCompatibility;
+        if (!feature_flags::gColumnstoreIndexes.isEnabledAndIgnoreFCV() ||
+            (fcv.isVersionInitialized() && !feature_flags::gColumnstoreIndexes.isEnabled(fcv))) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' requires featureFlagColumnstoreIndexes to be enabled "
+                                           "and the latest feature compatibility version");
+        }
+
+        if (isSparse || spec["unique"].trueValue() ||
+            spec.getField("partialFilterExpression") || spec.getField("expireAfterSeconds")) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the sparse, unique, partial or "
+                                           "TTL options");
+        }
+
+        if (collection->isClustered()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' is not supported on clustered collections");
+        }
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
@@ -1361,6 +1390,25 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
                                                const IndexCatalogEntry* index,
                                                const std::vector<BsonRecord>& bsonRecords,
                                                int64_t* keysInsertedOut) const {
+    const auto minRecordsForBatch = gInternalIndexBatchedKeyInsertionMinRecords.load();
+    if (minRecordsForBatch > 0 && bsonRecords.size() >= static_cast<size_t>(minRecordsForBatch) &&
+        !index->isHybridBuilding()) {
+        // Keys are written out of record order, so each record must not be timestamped earlier
+        // than the one before it. Otherwise a key could be written at a timestamp older than the
+        // first timestamp of the storage transaction. Records without a timestamp are written at
+        // the current timestamp of the transaction, so they cannot be mixed with timestamped ones.
+        auto isTimestampOrdered = [](const BsonRecord& lhs, const BsonRecord& rhs) {
+            return lhs.ts.isNull() == rhs.ts.isNull() && lhs.ts <= rhs.ts;
+        };
+        if (std::adjacent_find(bsonRecords.begin(),
+                               bsonRecords.end(),
+                               [&](const BsonRecord& lhs, const BsonRecord& rhs) {
+                                   return !isTimestampOrdered(lhs, rhs);
+                               }) == bsonRecords.end()) {
+            return _indexFilteredRecordsBatched(opCtx, coll, index, bsonRecords, keysInsertedOut);
+        }
+    }
+
     auto& executionCtx = StorageExecutionContext::get(opCtx);
 
     InsertDeleteOptions options;
@@ -1409,6 +1457,107 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsBatched(OperationContext* opCtx,
+                                                      const CollectionPtr& coll,
+                                                      const IndexCatalogEntry* index,
+                                                      const std::vector<BsonRecord>& bsonRecords,
+                                                      int64_t* keysInsertedOut) const {
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    auto accessMethod = index->accessMethod();
+
+    InsertDeleteOptions options;
+    prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
+
+    // The keys of all the records, each paired with the timestamp of its record.
+    std::vector<std::pair<KeyString::Value, Timestamp>> timestampedKeys;
+
+    // The union of the multikey metadata keys and paths of the records which make the index
+    // multikey, and the timestamp of the first such record.
+    KeyStringSet multikeyMetadataKeys;
+    MultikeyPaths multikeyPaths;
+    boost::optional<Timestamp> multikeyTimestamp;
+    int64_t numMultikeyMetadataKeys = 0;
+
+    for (auto&& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto recordMultikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto recordMultikeyPaths = executionCtx.multikeyPaths();
+
+        accessMethod->getKeys(opCtx,
+                              coll,
+                              executionCtx.pooledBufferBuilder(),
+                              *bsonRecord.docPtr,
+                              options.getKeysMode,
+                              IndexAccessMethod::GetKeysContext::kAddingKeys,
+                              keys.get(),
+                              recordMultikeyMetadataKeys.get(),
+                              recordMultikeyPaths.get(),
+                              bsonRecord.id,
+                              IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        for (auto&& key : *keys) {
+            timestampedKeys.emplace_back(key, bsonRecord.ts);
+        }
+        numMultikeyMetadataKeys += recordMultikeyMetadataKeys->size();
+
+        if (accessMethod->shouldMarkIndexAsMultikey(
+                keys->size(), *recordMultikeyMetadataKeys, *recordMultikeyPaths)) {
+            if (!multikeyTimestamp) {
+                multikeyTimestamp = bsonRecord.ts;
+                multikeyPaths = *recordMultikeyPaths;
+            } else {
+                MultikeyPathTracker::mergeMultikeyPaths(&multikeyPaths, *recordMultikeyPaths);
+            }
+            multikeyMetadataKeys.insert(recordMultikeyMetadataKeys->begin(),
+                                        recordMultikeyMetadataKeys->end());
+        }
+    }
+
+    std::sort(timestampedKeys.begin(), timestampedKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.compare(rhs.first) < 0;
+    });
+
+    std::vector<KeyString::Value> sortedKeys;
+    std::vector<Timestamp> timestamps;
+    sortedKeys.reserve(timestampedKeys.size());
+    timestamps.reserve(timestampedKeys.size());
+    for (auto&& [key, ts] : timestampedKeys) {
+        sortedKeys.push_back(std::move(key));
+        timestamps.push_back(ts);
+    }
+
+    // Mark the index multikey at the timestamp of the first record which made it multikey, as
+    // inserting the records one at a time would.
+    if (multikeyTimestamp) {
+        if (!multikeyTimestamp->isNull()) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(*multikeyTimestamp);
+            if (!status.isOK())
+                return status;
+        }
+        index->setMultikey(opCtx, coll, multikeyMetadataKeys, multikeyPaths);
+    }
+
+    int64_t numInserted;
+    Status status =
+        accessMethod->insertSortedKeys(opCtx, sortedKeys, timestamps, options, &numInserted);
+    if (!status.isOK()) {
+        return status;
+    }
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted + numMultikeyMetadataKeys;
+    }
+
+    // Leave the storage transaction at the timestamp of the last record, as inserting the records
+    // one at a time would.
+    const auto& lastTimestamp = bsonRecords.back().ts;
+    if (!lastTimestamp.isNull()) {
+        return opCtx->recoveryUnit()->setTimestamp(lastTimestamp);
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        const IndexCatalogEntry* index,
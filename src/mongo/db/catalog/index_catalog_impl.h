@@ -336,6 +336,17 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut) const;
 
+    /**
+     * Inserts the keys of all of 'bsonRecords' into 'index' in key order, rather than record by
+     * record, so that the index is written with a single pass. Each key is written at the
+     * timestamp of its record.
+     */
+    Status _indexFilteredRecordsBatched(OperationContext* opCtx,
+                                        const CollectionPtr& coll,
+                                        const IndexCatalogEntry* index,
+                                        const std::vector<BsonRecord>& bsonRecords,
+                                        int64_t* keysInsertedOut) const;
+
     Status _indexRecords(OperationContext* opCtx,
                          const CollectionPtr& coll,
                          const IndexCatalogEntry* index,
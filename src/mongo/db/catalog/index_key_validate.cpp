@@ -153,7 +153,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -194,6 +194,15 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                         << "' index must be a non-zero number, not a string.");
         }
 
+        // Every path of a column store index is stored as its own column, so the key pattern
+        // cannot mix column paths with ascending or descending fields.
+        if (pluginName == IndexNames::COLUMN && keyElement.type() != String) {
+            return Status(code,
+                          str::stream() << "Every field of a '" << IndexNames::COLUMN
+                                        << "' index key pattern must have the value '"
+                                        << IndexNames::COLUMN << "'");
+        }
+
         // Check if the wildcard index is compounded. If it is the key is invalid because
         // compounded wildcard indexes are disallowed.
         if (pluginName == IndexNames::WILDCARD && key.nFields() != 1) {
@@ -31,6 +31,8 @@
 
 #include "mongo/db/catalog/local_oplog_info.h"
 
+#include <utility>
+
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/flow_control.h"
@@ -99,18 +101,14 @@ std::vector<OplogSlot> LocalOplogInfo::getNextOpTimes(OperationContext* opCtx, s
 
     // Allow the storage engine to start the transaction outside the critical section.
     opCtx->recoveryUnit()->preallocateSnapshot();
-    {
-        stdx::lock_guard<Latch> lk(_newOpMutex);
-
-        ts = VectorClockMutable::get(opCtx)->tickClusterTime(count).asTimestamp();
-        const bool orderedCommit = false;
 
-        // The local oplog collection pointer must already be established by this point.
-        // We can't establish it here because that would require locking the local database, which
-        // would be a lock order violation.
-        invariant(_oplog);
-        fassert(28560, _oplog->getRecordStore()->oplogDiskLocRegister(opCtx, ts, orderedCommit));
+    PendingReservation reservation{opCtx, count};
+    if (!_tryReserveOpTimesDirectly(&reservation)) {
+        _waitForReservation(&reservation);
     }
+    uassertStatusOK(reservation.status);
+    ts = reservation.ts;
+
     std::vector<OplogSlot> oplogSlots(count);
     for (std::size_t i = 0; i < count; i++) {
         oplogSlots[i] = {Timestamp(ts.asULL() + i), term};
@@ -125,4 +123,91 @@ std::vector<OplogSlot> LocalOplogInfo::getNextOpTimes(OperationContext* opCtx, s
     return oplogSlots;
 }
 
+bool LocalOplogInfo::_tryReserveOpTimesDirectly(PendingReservation* reservation) {
+    // Without a call serving reservations, _newOpMutex is most likely free, and taking it directly
+    // saves the round trip through _pendingReservationsMutex.
+    if (_servingReservations.load()) {
+        return false;
+    }
+
+    stdx::unique_lock<Latch> lk(_newOpMutex, stdx::try_to_lock);
+    if (!lk.owns_lock()) {
+        return false;
+    }
+    _reserveOpTimes(lk, &reservation, 1);
+    return true;
+}
+
+void LocalOplogInfo::_waitForReservation(PendingReservation* reservation) {
+    // Under load, serving every pending reservation in one critical section replaces a convoy of
+    // handoffs of _newOpMutex with one acquisition and one tick of the cluster time per batch.
+    stdx::unique_lock<Latch> lk(_pendingReservationsMutex);
+    _pendingReservations.push_back(reservation);
+    while (!reservation->served) {
+        if (_servingReservations.load()) {
+            reservation->cv.wait(
+                lk, [&] { return reservation->served || !_servingReservations.load(); });
+            continue;
+        }
+
+        _servingReservations.store(true);
+        auto batch = std::exchange(_pendingReservations, {});
+        lk.unlock();
+        {
+            stdx::lock_guard<Latch> newOpLk(_newOpMutex);
+            _reserveOpTimes(newOpLk, batch.data(), batch.size());
+        }
+        lk.lock();
+
+        // Only wake the members of the batch. Each waits on its own condition variable and
+        // cannot return, destroying it, before this releases _pendingReservationsMutex.
+        for (auto pending : batch) {
+            pending->served = true;
+            pending->cv.notify_one();
+        }
+        _servingReservations.store(false);
+
+        // The reservations which arrived while this batch was served still wait for a call to
+        // serve them. The oldest is woken to serve them all.
+        if (!_pendingReservations.empty()) {
+            _pendingReservations.front()->cv.notify_one();
+        }
+    }
+}
+
+void LocalOplogInfo::_reserveOpTimes(WithLock,
+                                     PendingReservation* const* batch,
+                                     std::size_t batchSize) {
+    std::size_t totalCount = 0;
+    for (std::size_t i = 0; i < batchSize; ++i) {
+        totalCount += batch[i]->count;
+    }
+
+    try {
+        auto ts = VectorClockMutable::get(batch[0]->opCtx)
+                      ->tickClusterTime(totalCount)
+                      .asTimestamp();
+        const bool orderedCommit = false;
+
+        // The local oplog collection pointer must already be established by this point.
+        // We can't establish it here because that would require locking the local database, which
+        // would be a lock order violation.
+        invariant(_oplog);
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            // The operations of the other reservations are blocked until they are served, so their
+            // recovery units may be used from this thread.
+            auto pending = batch[i];
+            pending->ts = ts;
+            fassert(28560,
+                    _oplog->getRecordStore()->oplogDiskLocRegister(
+                        pending->opCtx, ts, orderedCommit));
+            ts = Timestamp(ts.asULL() + pending->count);
+        }
+    } catch (const DBException& ex) {
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            batch[i]->status = ex.toStatus();
+        }
+    }
+}
+
 }  // namespace mongo
@@ -32,12 +32,16 @@
 #include <cstddef>
 #include <vector>
 
+#include "mongo/base/status.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
-#include "mongo/stdx/mutex.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -66,10 +70,47 @@ public:
     /**
      * Allocates optimes for new entries in the oplog. Returns the new optimes in a vector along
      * with their terms.
+     *
+     * An uncontended call allocates its optimes directly. Contended calls are grouped: the first
+     * one to find no other call serving reservations allocates the optimes of every pending call
+     * at once, while the others wait to be served.
      */
     std::vector<OplogSlot> getNextOpTimes(OperationContext* opCtx, std::size_t count);
 
 private:
+    struct PendingReservation {
+        OperationContext* const opCtx;
+        const std::size_t count;
+
+        // Set by the call serving the reservation before it sets 'served'.
+        Timestamp ts;
+        Status status = Status::OK();
+        bool served = false;
+
+        // Signaled when the reservation has been served, or when its call should serve the next
+        // batch.
+        stdx::condition_variable cv;
+    };
+
+    /**
+     * Serves 'reservation' alone if no call is serving reservations and _newOpMutex is free.
+     * Returns false, without waiting, otherwise.
+     */
+    bool _tryReserveOpTimesDirectly(PendingReservation* reservation);
+
+    /**
+     * Queues 'reservation' and waits until it is served, serving the pending reservations itself
+     * whenever no other call does.
+     */
+    void _waitForReservation(PendingReservation* reservation);
+
+    /**
+     * Allocates a contiguous range of optimes for the 'batchSize' reservations starting at
+     * 'batch', in order, and registers the first optime of each of them in the storage engine for
+     * its operation.
+     */
+    void _reserveOpTimes(WithLock, PendingReservation* const* batch, std::size_t batchSize);
+
     // Name of the oplog collection.
     NamespaceString _oplogName;
 
@@ -81,6 +122,18 @@ private:
     // Synchronizes the section where a new Timestamp is generated and when it is registered in the
     // storage engine.
     mutable Mutex _newOpMutex = MONGO_MAKE_LATCH("LocaloplogInfo::_newOpMutex");
+
+    // Protects the state below, which groups concurrent calls to getNextOpTimes().
+    Mutex _pendingReservationsMutex =
+        MONGO_MAKE_LATCH("LocalOplogInfo::_pendingReservationsMutex");
+
+    // The reservations waiting for the next batch, in arrival order. Each is owned by the stack of
+    // the waiting call.
+    std::vector<PendingReservation*> _pendingReservations;
+
+    // Whether a call is currently serving a batch of reservations. Only changed while holding
+    // _pendingReservationsMutex, and read without it by calls trying to reserve directly.
+    AtomicWord<bool> _servingReservations{false};
 };
 
 }  // namespace mongo
@@ -37,10 +37,12 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/multikey_paths.h"
@@ -55,6 +57,7 @@
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/progress_meter.h"
@@ -83,6 +86,62 @@ size_t getEachIndexBuildMaxMemoryUsageBytes(size_t numIndexSpecs) {
         numIndexSpecs;
 }
 
+// A parallel collection scan splits the collection into this many RecordId ranges per thread, so
+// that threads which finish their ranges early take over the remaining ones.
+const size_t kScanRangesPerThread = 4;
+
+// Number of random RecordIds sampled for each range of a parallel collection scan.
+const size_t kSamplesPerScanRange = 16;
+
+// Collections with fewer records per range than this are scanned on a single thread.
+const long long kMinRecordsPerScanRange = 1000;
+
+/**
+ * Returns the sorted, distinct RecordIds that split 'collection' into at most 'numRanges' ranges of
+ * similar size, estimated from a random sample. Returns an empty vector if the collection cannot be
+ * split.
+ */
+std::vector<RecordId> sampleScanRangeBoundaries(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                size_t numRanges) {
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return {};
+    }
+
+    std::vector<RecordId> samples;
+    while (samples.size() < numRanges * kSamplesPerScanRange) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        samples.push_back(record->id);
+    }
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+
+    std::vector<RecordId> boundaries;
+    for (size_t i = 1; i < numRanges && !samples.empty(); i++) {
+        const auto& boundary = samples[i * samples.size() / numRanges];
+        if (boundaries.empty() || boundaries.back() < boundary) {
+            boundaries.push_back(boundary);
+        }
+    }
+    return boundaries;
+}
+
+ThreadPool::Options makeCollectionScanPoolOptions(size_t numThreads) {
+    ThreadPool::Options options;
+    options.poolName = "IndexBuildCollectionScan";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName);
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+    };
+    return options;
+}
+
 }  // namespace
 
 MultiIndexBlock::~MultiIndexBlock() {
@@ -428,12 +487,24 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
         Timer timer;
 
         try {
+            // Only hybrid builds that start from the beginning of the collection, and that read
+            // from a source every scan thread can use, are split across several threads.
+            const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+            const size_t numScanThreads = maxIndexBuildCollectionScanThreads.load();
+            const bool canScanInParallel = numScanThreads > 1 && isBackgroundBuilding() &&
+                !collection->isCapped() && (numScanRestarts > 0 || !resumeAfterRecordId) &&
+                (readSource == RecoveryUnit::ReadSource::kNoTimestamp ||
+                 readSource == RecoveryUnit::ReadSource::kMajorityCommitted);
+
             // Resumable index builds can only be resumed prior to the oplog recovery phase of
             // startup. When restarting the collection scan, any saved index build progress is lost.
-            _doCollectionScan(opCtx,
-                              collection,
-                              numScanRestarts == 0 ? resumeAfterRecordId : boost::none,
-                              &progress);
+            if (!canScanInParallel ||
+                !_doParallelCollectionScan(opCtx, collection, numScanThreads, &progress)) {
+                _doCollectionScan(opCtx,
+                                  collection,
+                                  numScanRestarts == 0 ? resumeAfterRecordId : boost::none,
+                                  &progress);
+            }
 
             LOGV2(20391,
                   "Index build: collection scan done",
@@ -470,6 +541,7 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
                     "error"_attr = ex);
 
                 _lastRecordIdInserted = boost::none;
+                _scannedInParallel = false;
                 for (auto& index : _indexes) {
                     index.bulk = index.real->initiateBulk(
                         getEachIndexBuildMaxMemoryUsageBytes(_indexes.size()),
@@ -608,6 +680,266 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
     }
 }
 
+bool MultiIndexBlock::_doParallelCollectionScan(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                size_t numThreads,
+                                                ProgressMeterHolder* progress) {
+    const size_t maxRanges = numThreads * kScanRangesPerThread;
+    const long long minRecords = static_cast<long long>(maxRanges) * kMinRecordsPerScanRange;
+    if (collection->numRecords(opCtx) < minRecords) {
+        return false;
+    }
+
+    // Range i covers the RecordIds from boundaries[i - 1], inclusive, up to boundaries[i],
+    // exclusive. The first and last ranges are unbounded below and above.
+    const auto boundaries = sampleScanRangeBoundaries(opCtx, collection, maxRanges);
+    if (boundaries.empty()) {
+        return false;
+    }
+    const size_t numRanges = boundaries.size() + 1;
+
+    invariant(_phase == IndexBuildPhaseEnum::kInitialized ||
+                  _phase == IndexBuildPhaseEnum::kCollectionScan,
+              IndexBuildPhase_serializer(_phase).toString());
+    _phase = IndexBuildPhaseEnum::kCollectionScan;
+
+    LOGV2(5962000,
+          "Index build: scanning collection on multiple threads",
+          "buildUUID"_attr = _buildUUID,
+          "collectionUUID"_attr = _collectionUUID,
+          logAttrs(collection->ns()),
+          "numThreads"_attr = numThreads,
+          "numRanges"_attr = numRanges);
+
+    // The memory budget of each index is shared between the sorters of the scan threads. The
+    // first thread inserts into the BulkBuilders of this index build, which are still empty, and
+    // every other thread into its own.
+    const size_t eachThreadMaxMemoryUsageBytes =
+        getEachIndexBuildMaxMemoryUsageBytes(_indexes.size()) / numThreads;
+    struct ScanThreadState {
+        std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>> ownedBulks;
+        std::vector<IndexAccessMethod::BulkBuilder*> bulks;
+        boost::optional<RecordId> lastRecordId;
+    };
+    std::vector<ScanThreadState> threadStates(numThreads);
+    for (auto& index : _indexes) {
+        invariant(index.bulk->getKeysInserted() == 0);
+        index.bulk = index.real->initiateBulk(
+            eachThreadMaxMemoryUsageBytes, /*stateInfo=*/boost::none, collection->ns().db());
+        threadStates[0].bulks.push_back(index.bulk.get());
+    }
+    for (size_t t = 1; t < numThreads; t++) {
+        auto& threadState = threadStates[t];
+        for (auto& index : _indexes) {
+            threadState.ownedBulks.push_back(index.real->initiateBulk(
+                eachThreadMaxMemoryUsageBytes, /*stateInfo=*/boost::none, collection->ns().db()));
+            threadState.bulks.push_back(threadState.ownedBulks.back().get());
+        }
+    }
+
+    Mutex mutex = MONGO_MAKE_LATCH("MultiIndexBlock::parallelCollectionScan");
+    stdx::condition_variable scanThreadsDoneCV;
+    size_t numRunning = numThreads;
+    Status scanStatus = Status::OK();
+    std::vector<OperationContext*> scanOpCtxs;
+    AtomicWord<size_t> nextRange{0};
+    AtomicWord<int> numScanned{0};
+
+    // Numbers the documents across every scan thread for the failpoints which hang the collection
+    // scan at a given iteration.
+    AtomicWord<unsigned long long> nextIteration{(*progress)->hits()};
+
+    // Stops every scan thread. Called with the first error of a thread, or when this index build
+    // is interrupted.
+    auto killScanThreads = [&](WithLock, Status status) {
+        invariant(!status.isOK());
+        if (!scanStatus.isOK()) {
+            return;
+        }
+        scanStatus = status;
+        for (auto scanOpCtx : scanOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*scanOpCtx->getClient());
+            scanOpCtx->getServiceContext()->killOperation(
+                clientLock, scanOpCtx, ErrorCodes::Interrupted);
+        }
+    };
+
+    const NamespaceStringOrUUID nssOrUUID(collection->ns().db().toString(), collection->uuid());
+    const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+    const bool readOnce = opCtx->recoveryUnit()->getReadOnce();
+    const auto prepareConflictBehavior = opCtx->recoveryUnit()->getPrepareConflictBehavior();
+    const auto admissionPriority = opCtx->lockState()->getAdmissionPriority();
+
+    auto scanRanges = [&](ScanThreadState* threadState) {
+        auto scanOpCtxHolder = cc().makeOperationContext();
+        auto scanOpCtx = scanOpCtxHolder.get();
+
+        // Like the operation of the index build, the scan threads must never take the PBWM lock.
+        // On a secondary, oplog application holds it in MODE_X while it waits for this index build
+        // to commit.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(scanOpCtx->lockState());
+        scanOpCtx->lockState()->setAdmissionPriority(admissionPriority);
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            scanOpCtxs.push_back(scanOpCtx);
+        }
+
+        Status status = Status::OK();
+        try {
+            // A scan thread that starts after another one failed stops right away.
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                uassertStatusOK(scanStatus.withContext("collection scan thread stopped"));
+            }
+
+            scanOpCtx->recoveryUnit()->setTimestampReadSource(readSource);
+            scanOpCtx->recoveryUnit()->setReadOnce(readOnce);
+            scanOpCtx->recoveryUnit()->setPrepareConflictBehavior(prepareConflictBehavior);
+
+            AutoGetCollection scanColl(scanOpCtx, nssOrUUID, MODE_IS);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nssOrUUID.toString()
+                                  << " was dropped during the index build collection scan",
+                    scanColl);
+
+            for (size_t range = nextRange.fetchAndAdd(1); range < numRanges;
+                 range = nextRange.fetchAndAdd(1)) {
+                auto rangeStart =
+                    range == 0 ? boost::none : boost::make_optional(boundaries[range - 1]);
+                auto rangeEnd = range == numRanges - 1 ? boost::none
+                                                       : boost::make_optional(boundaries[range]);
+                auto exec = scanColl->makePlanExecutor(scanOpCtx,
+                                                       scanColl.getCollection(),
+                                                       PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                       Collection::ScanDirection::kForward,
+                                                       /*resumeAfterRecordId=*/boost::none,
+                                                       rangeStart,
+                                                       rangeEnd);
+
+                BSONObj objToIndex;
+                RecordId loc;
+                while (PlanExecutor::ADVANCED == exec->getNext(&objToIndex, &loc)) {
+                    // The scan starts by seeking near the start of the range, which lands on the
+                    // record before it if the boundary record has been deleted. That record
+                    // belongs to the previous range.
+                    if (rangeStart && loc < *rangeStart) {
+                        continue;
+                    }
+
+                    // The bounds of the scan are inclusive, but the end of a range belongs to the
+                    // next one.
+                    if (rangeEnd && loc >= *rangeEnd) {
+                        break;
+                    }
+
+                    scanOpCtx->checkForInterrupt();
+
+                    const auto iteration = nextIteration.fetchAndAdd(1);
+                    uassertStatusOK(_failPointHangDuringBuild(
+                        scanOpCtx,
+                        &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
+                        "before",
+                        objToIndex,
+                        iteration));
+
+                    for (size_t i = 0; i < _indexes.size(); i++) {
+                        if (_indexes[i].filterExpression &&
+                            !_indexes[i].filterExpression->matchesBSON(objToIndex)) {
+                            continue;
+                        }
+                        uassertStatusOK(threadState->bulks[i]->insert(scanOpCtx,
+                                                                      scanColl.getCollection(),
+                                                                      objToIndex,
+                                                                      loc,
+                                                                      _indexes[i].options));
+                    }
+
+                    _failPointHangDuringBuild(
+                        scanOpCtx,
+                        &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
+                        "after",
+                        objToIndex,
+                        iteration)
+                        .ignore();
+
+                    if (!threadState->lastRecordId || *threadState->lastRecordId < loc) {
+                        threadState->lastRecordId = loc;
+                    }
+                    numScanned.fetchAndAdd(1);
+                }
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        stdx::lock_guard<Latch> lk(mutex);
+        scanOpCtxs.erase(std::find(scanOpCtxs.begin(), scanOpCtxs.end(), scanOpCtx));
+        if (!status.isOK()) {
+            killScanThreads(lk, status);
+        }
+        if (--numRunning == 0) {
+            scanThreadsDoneCV.notify_all();
+        }
+    };
+
+    ThreadPool pool(makeCollectionScanPoolOptions(numThreads));
+    pool.startup();
+
+    // The scan threads take their own collection locks. Release the locks of this operation while
+    // they run, so that a conflicting lock request queued behind these locks cannot block them.
+    collection.yield();
+    Locker::LockSnapshot lockInfo;
+    invariant(opCtx->lockState()->saveLockStateAndUnlock(&lockInfo));
+
+    for (auto& threadState : threadStates) {
+        pool.schedule([&scanRanges, state = &threadState](Status status) {
+            invariant(status);
+            scanRanges(state);
+        });
+    }
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        while (numRunning > 0) {
+            try {
+                opCtx->waitForConditionOrInterruptFor(
+                    scanThreadsDoneCV, lk, Seconds(1), [&] { return numRunning == 0; });
+            } catch (const DBException& ex) {
+                killScanThreads(lk, ex.toStatus());
+                scanThreadsDoneCV.wait(lk, [&] { return numRunning == 0; });
+            }
+
+            lk.unlock();
+            progress->hit(numScanned.swap(0));
+            lk.lock();
+        }
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    opCtx->lockState()->restoreLockState(opCtx, lockInfo);
+    opCtx->recoveryUnit()->abandonSnapshot();
+    collection.restore();
+
+    uassertStatusOK(scanStatus);
+
+    // Every range has been scanned, so every record up to the highest RecordId scanned has been
+    // indexed. That RecordId is the position a resumed collection scan continues from.
+    for (auto& threadState : threadStates) {
+        for (size_t i = 0; i < threadState.ownedBulks.size(); i++) {
+            _indexes[i].bulk->mergeFrom(std::move(threadState.ownedBulks[i]));
+        }
+        if (threadState.lastRecordId &&
+            (!_lastRecordIdInserted || *_lastRecordIdInserted < *threadState.lastRecordId)) {
+            _lastRecordIdInserted = threadState.lastRecordId;
+        }
+    }
+    _scannedInParallel = true;
+
+    return true;
+}
+
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(
     OperationContext* opCtx,
     const CollectionPtr& collection,
@@ -949,9 +1281,18 @@ void MultiIndexBlock::_writeStateToDisk(OperationContext* opCtx,
 
 BSONObj MultiIndexBlock::_constructStateObject(OperationContext* opCtx,
                                                const CollectionPtr& collection) const {
+    // The keys of a parallel collection scan cannot be persisted once the bulk load has started
+    // to consume them. Record such builds as not started, so that they restart from the beginning
+    // of the collection.
+    const bool restartFromCollectionScan =
+        _scannedInParallel && _phase == IndexBuildPhaseEnum::kBulkLoad;
+
     BSONObjBuilder builder;
     _buildUUID->appendToBuilder(&builder, "_id");
-    builder.append("phase", IndexBuildPhase_serializer(_phase));
+    builder.append("phase",
+                   IndexBuildPhase_serializer(restartFromCollectionScan
+                                                  ? IndexBuildPhaseEnum::kInitialized
+                                                  : _phase));
 
     if (_collectionUUID) {
         _collectionUUID->appendToBuilder(&builder, "collectionUUID");
@@ -967,7 +1308,7 @@ BSONObj MultiIndexBlock::_constructStateObject(OperationContext* opCtx,
     for (const auto& index : _indexes) {
         BSONObjBuilder indexInfo(indexesArray.subobjStart());
 
-        if (_phase != IndexBuildPhaseEnum::kDrainWrites) {
+        if (_phase != IndexBuildPhaseEnum::kDrainWrites && !restartFromCollectionScan) {
             // Persist the data to disk so that we see all of the data that has been inserted into
             // the Sorter.
             auto state = index.bulk->persistDataForShutdown();
@@ -326,6 +326,20 @@ private:
                            boost::optional<RecordId> resumeAfterRecordId,
                            ProgressMeterHolder* progress);
 
+    /**
+     * Performs the collection scan on 'numThreads' threads. The collection is split into RecordId
+     * ranges from a random sample. Each thread scans ranges with its own operation and inserts the
+     * index keys into its own external sorters, which are merged into the sorters of this index
+     * build once every range has been scanned. The locks of 'opCtx' are released while the threads
+     * run.
+     *
+     * Returns false, without scanning anything, if the collection is too small to be split.
+     */
+    bool _doParallelCollectionScan(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   size_t numThreads,
+                                   ProgressMeterHolder* progress);
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
@@ -349,5 +363,10 @@ private:
 
     // The current phase of the index build.
     IndexBuildPhaseEnum _phase = IndexBuildPhaseEnum::kInitialized;
+
+    // Set when the keys of the collection scan were generated by several threads. The sorters of
+    // those threads cannot be persisted once the bulk load has consumed them, so a resumable index
+    // build interrupted during the bulk load phase restarts from the collection scan.
+    bool _scannedInParallel = false;
 };
 }  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/truncate_range.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/lock_state.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/op_observer.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+namespace mongo {
+
+StatusWith<TruncateRangeResult> truncateRange(OperationContext* opCtx,
+                                              const CollectionPtr& collection,
+                                              const RecordId& minRecordId,
+                                              const RecordId& maxRecordId,
+                                              int64_t maxRecords) {
+    if (!collection->isClustered() || collection->isCapped() ||
+        collection->getRecordPreImages()) {
+        return {ErrorCodes::IllegalOperation,
+                str::stream() << "Cannot truncate a range of records in collection "
+                              << collection->ns()};
+    }
+
+    dassert(opCtx->lockState()->isCollectionLockedForMode(collection->ns(), MODE_IX));
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(maxRecords > 0);
+
+    // Scan the range to find the bounds and size of what is removed, deleting the index keys of
+    // each record on the way, since the record store truncate does not return the documents.
+    TruncateRangeResult result;
+    const auto indexCatalog = collection->getIndexCatalog();
+    const bool hasIndexes = indexCatalog->numIndexesTotal(opCtx) > 0;
+    const bool isTimeseriesBuckets = collection->ns().isTimeseriesBucketsCollection();
+    int64_t keysDeleted = 0;
+    {
+        auto cursor = collection->getCursor(opCtx);
+        for (auto record = minRecordId.isNull() ? cursor->next() : cursor->seekNear(minRecordId);
+             record && record->id <= maxRecordId && result.numRecords < maxRecords;
+             record = cursor->next()) {
+            if (record->id < minRecordId) {
+                continue;
+            }
+
+            const auto doc = record->data.toBson();
+            if (hasIndexes) {
+                int64_t keysDeletedForRecord = 0;
+                indexCatalog->unindexRecord(opCtx,
+                                            collection,
+                                            doc,
+                                            record->id,
+                                            false /* noWarn */,
+                                            &keysDeletedForRecord);
+                keysDeleted += keysDeletedForRecord;
+            }
+
+            // As for a delete, prevent further inserts into a bucket that is being removed.
+            if (isTimeseriesBuckets) {
+                BucketCatalog::get(opCtx).clear(doc["_id"].OID());
+            }
+
+            if (!result.firstRecordId) {
+                result.firstRecordId = record->id;
+            }
+            result.lastRecordId = record->id;
+            result.numRecords++;
+            result.dataSize += record->data.size();
+        }
+    }
+
+    if (result.numRecords == 0) {
+        return result;
+    }
+
+    auto status = collection->getRecordStore()->rangeTruncate(opCtx,
+                                                              *result.firstRecordId,
+                                                              *result.lastRecordId,
+                                                              result.numRecords,
+                                                              result.dataSize);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    opCtx->getServiceContext()->getOpObserver()->onTruncateRange(opCtx,
+                                                                 collection->ns(),
+                                                                 collection->uuid(),
+                                                                 *result.firstRecordId,
+                                                                 *result.lastRecordId,
+                                                                 result.numRecords);
+
+    CurOp::get(opCtx)->debug().additiveMetrics.incrementKeysDeleted(keysDeleted);
+    return result;
+}
+
+}  // namespace mongo
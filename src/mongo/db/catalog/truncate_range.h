@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status_with.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+class CollectionPtr;
+class OperationContext;
+
+/**
+ * Describes the records removed by truncateRange().
+ */
+struct TruncateRangeResult {
+    int64_t numRecords = 0;
+    int64_t dataSize = 0;
+
+    // Ids of the first and last records removed. Not set if no records were removed.
+    boost::optional<RecordId> firstRecordId;
+    boost::optional<RecordId> lastRecordId;
+};
+
+/**
+ * Removes up to 'maxRecords' records of 'collection', in id order, whose ids fall in the inclusive
+ * range ['minRecordId', 'maxRecordId']. A null 'minRecordId' starts from the first record. The
+ * records are removed from the record store with a single range truncate and their index keys are
+ * deleted as the range is scanned. One 'truncateRange' oplog entry describes the removed range in
+ * place of a delete entry per record.
+ *
+ * Only collections clustered by _id which are not capped and do not record pre-images are
+ * supported. The caller must hold the collection lock in MODE_IX and be in a WriteUnitOfWork.
+ */
+StatusWith<TruncateRangeResult> truncateRange(OperationContext* opCtx,
+                                              const CollectionPtr& collection,
+                                              const RecordId& minRecordId,
+                                              const RecordId& maxRecordId,
+                                              int64_t maxRecords);
+
+}  // namespace mongo
@@ -633,9 +633,20 @@ void ValidateAdaptor::validateIndexKeyCount(OperationContext* opCtx,
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
     // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
-    if (results.valid && !index->isMultikey(opCtx, _validateState->getCollection()) &&
-        desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
+    // multiple paths within a single document. Column store indexes are never multikey, and have
+    // exactly one entry per path for each document.
+    if (desc->getIndexType() == IndexType::INDEX_COLUMN) {
+        const long long numPaths = desc->keyPattern().nFields();
+        if (results.valid && numTotalKeys != _numRecords * numPaths) {
+            std::string err = str::stream()
+                << "column store index " << desc->indexName() << " has " << numTotalKeys
+                << " entries, but should have one for each of its " << numPaths
+                << " paths in each of the " << _numRecords << " documents";
+            results.errors.push_back(err);
+            results.valid = false;
+        }
+    } else if (results.valid && !index->isMultikey(opCtx, _validateState->getCollection()) &&
+               desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << desc->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
@@ -48,6 +48,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/explain_options.h"
 #include "mongo/db/read_concern_support_result.h"
+#include "mongo/db/read_write_type.h"
 #include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/request_execution_context.h"
 #include "mongo/db/write_concern.h"
@@ -529,7 +530,7 @@ public:
      * Commands which implement database read or write logic should override this to return kRead
      * or kWrite as appropriate.
      */
-    enum class ReadWriteType { kCommand, kRead, kWrite, kTransaction };
+    using ReadWriteType = mongo::ReadWriteType;
     virtual ReadWriteType getReadWriteType() const {
         return ReadWriteType::kCommand;
     }
@@ -29,8 +29,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
+#include <fmt/format.h>
+#include <map>
+
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/service_executor_fixed.h"
@@ -39,6 +44,7 @@
 #include "mongo/util/net/hostname_canonicalization.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/net/ssl_manager.h"
+#include "mongo/util/stacktrace.h"
 
 namespace mongo {
 
@@ -167,6 +173,124 @@ public:
 } tlsVersionStatus;
 #endif
 
+#ifndef MONGO_CONFIG_USE_RAW_LATCHES
+/**
+ * Status section reporting, for each latch name with contended acquisitions, how many there were,
+ * a histogram of how long they waited and the call sites found holding the latch by a sample of
+ * them.
+ *
+ * The histogram always has every bucket, named after the shortest wait it counts in microseconds,
+ * so that its shape does not change between samples. Each holder site is reported like a stack
+ * trace frame: as the base address "b" of the executable or shared object containing it and its
+ * offset "o" from there, which can be symbolized with the "somap" of a stack trace's processInfo.
+ * The holder sites vary between samples, and can be omitted with
+ * {latchContention: {holderSites: false}}.
+ */
+class LatchContention final : public ServerStatusSection {
+public:
+    LatchContention() : ServerStatusSection("latchContention") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        bool includeHolderSites = true;
+        if (configElement.type() == BSONType::Object) {
+            includeHolderSites = configElement.Obj()["holderSites"].trueValue();
+        }
+
+        using ContentionStats = latch_detail::ContentionStats;
+        struct Aggregate {
+            long long contended = 0;
+            long long totalWaitMicros = 0;
+            std::array<long long, ContentionStats::kNumWaitBuckets> waitCounts{};
+            std::map<uintptr_t, long long> holderSites;
+            long long otherHolderSites = 0;
+        };
+
+        // Latches of the same name, such as those of every instance of a class, are reported
+        // together.
+        std::map<std::string, Aggregate> aggregates;
+        for (auto iter = latch_detail::Catalog::get().iter(); iter.more();) {
+            auto data = iter.next();
+            if (!data) {
+                continue;
+            }
+
+            const long long contended = data->counts().contended.loadRelaxed();
+            if (contended == 0) {
+                continue;
+            }
+
+            auto& aggregate = aggregates[data->identity().name().toString()];
+            auto& stats = data->contentionStats();
+            aggregate.contended += contended;
+            aggregate.totalWaitMicros += stats.totalWaitMicros();
+            for (size_t i = 0; i < ContentionStats::kNumWaitBuckets; ++i) {
+                aggregate.waitCounts[i] += stats.waitCount(i);
+            }
+
+            if (includeHolderSites) {
+                long long otherHolderSites = 0;
+                for (auto& site : stats.holderSites(&otherHolderSites)) {
+                    aggregate.holderSites[site.address] += site.count;
+                }
+                aggregate.otherHolderSites += otherHolderSites;
+            }
+        }
+
+        BSONObjBuilder result;
+        for (auto& [name, aggregate] : aggregates) {
+            BSONObjBuilder latchBuilder(result.subobjStart(name));
+            latchBuilder.append("contended", aggregate.contended);
+            latchBuilder.append("totalWaitMicros", aggregate.totalWaitMicros);
+
+            {
+                BSONObjBuilder histogramBuilder(latchBuilder.subobjStart("waitHistogram"));
+                for (size_t i = 0; i < ContentionStats::kNumWaitBuckets; ++i) {
+                    histogramBuilder.append(
+                        fmt::format("{}us", ContentionStats::bucketLowerBoundMicros(i)),
+                        aggregate.waitCounts[i]);
+                }
+            }
+
+            if (includeHolderSites) {
+                BSONArrayBuilder sitesBuilder(latchBuilder.subarrayStart("holderSites"));
+                for (auto& [address, count] : aggregate.holderSites) {
+                    BSONObjBuilder siteBuilder(sitesBuilder.subobjStart());
+                    appendHolderSite(&siteBuilder, address);
+                    siteBuilder.append("count", count);
+                }
+                sitesBuilder.done();
+                latchBuilder.append("otherHolderSites", aggregate.otherHolderSites);
+            }
+        }
+        return result.obj();
+    }
+
+private:
+    static void appendHolderSite(BSONObjBuilder* b, uintptr_t address) {
+        using stack_trace_detail::Hex;
+#ifndef _WIN32
+        StackTraceAddressMetadataGenerator metaGen;
+        const auto& meta = metaGen.load(reinterpret_cast<void*>(address));
+        if (const auto& file = meta.file(); file) {
+            b->append("b", Hex(file.base()));
+            b->append("o", Hex(address - file.base()));
+            if (const auto& symbol = meta.symbol(); symbol) {
+                b->append("s", symbol.name());
+            }
+            return;
+        }
+#endif
+        // Without the object containing the site, only its absolute address can be reported.
+        b->append("a", Hex(address));
+    }
+} latchContention;
+#endif
+
 class AdvisoryHostFQDNs final : public ServerStatusSection {
 public:
     AdvisoryHostFQDNs() : ServerStatusSection("advisoryHostFQDNs") {}
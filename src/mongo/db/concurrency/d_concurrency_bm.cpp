@@ -42,6 +42,10 @@ namespace {
 
 const int kMaxPerfThreads = 16;  // max number of threads to use for lock perf
 
+// Intent locks are taken by every operation, so their scalability is measured up to many more
+// threads
+const int kMaxIntentPerfThreads = 128;
+
 
 class DConcurrencyTest : public benchmark::Fixture {
 public:
@@ -122,6 +126,26 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)(benchmark
     }
 }
 
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionIntentSharedLockWithExclusiveWriter)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        makeKClientsWithLockers(state.threads);
+    }
+
+    // The first thread repeatedly locks the collection exclusively, which makes the intent locks of
+    // the other threads conflict and drain
+    const LockMode collMode = state.thread_index == 0 ? MODE_X : MODE_IS;
+    for (auto keepRunning : state) {
+        Lock::DBLock dlk(clients[state.thread_index].second.get(), "test", MODE_IX);
+        Lock::CollectionLock clk(
+            clients[state.thread_index].second.get(), NamespaceString("test.coll"), collMode);
+    }
+
+    if (state.thread_index == 0) {
+        clients.clear();
+    }
+}
+
 BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionSharedLock)(benchmark::State& state) {
     if (state.thread_index == 0) {
         makeKClientsWithLockers(state.threads);
@@ -160,9 +184,11 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexShared)->ThreadRange(1, k
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexExclusive)->ThreadRange(1, kMaxPerfThreads);
 
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLock)
-    ->ThreadRange(1, kMaxPerfThreads);
+    ->ThreadRange(1, kMaxIntentPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
-    ->ThreadRange(1, kMaxPerfThreads);
+    ->ThreadRange(1, kMaxIntentPerfThreads);
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLockWithExclusiveWriter)
+    ->ThreadRange(2, kMaxIntentPerfThreads);
 
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionSharedLock)->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionExclusiveLock)->ThreadRange(1, kMaxPerfThreads);
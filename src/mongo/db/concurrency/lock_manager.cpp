@@ -36,6 +36,10 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
@@ -46,6 +50,7 @@
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/decorable.h"
 #include "mongo/util/str.h"
@@ -117,6 +122,13 @@ uint32_t modeMask(LockMode mode) {
     return 1 << mode;
 }
 
+// The resources which are locked in intent modes by nearly every operation, and for which intent
+// requests may be granted through a fast path slot.
+bool isFastPathResource(ResourceType resourceType) {
+    return resourceType == RESOURCE_GLOBAL || resourceType == RESOURCE_DATABASE ||
+        resourceType == RESOURCE_COLLECTION;
+}
+
 /**
  * Maps the LockRequest status to a human-readable string.
  */
@@ -162,6 +174,9 @@ struct LockHead {
 
         conversionsCount = 0;
         compatibleFirstCount = 0;
+
+        fastPathSlot = nullptr;
+        fastPathModes = 0;
     }
 
     /**
@@ -207,7 +222,7 @@ struct LockHead {
 
         // New lock request. Queue after all granted modes and after any already requested
         // conflicting modes
-        if (conflicts(request->mode, grantedModes) ||
+        if (conflicts(request->mode, grantedModes | fastPathModes) ||
             (!compatibleFirstCount && conflicts(request->mode, conflictModes))) {
             request->status = LockRequest::STATUS_WAITING;
 
@@ -242,6 +257,13 @@ struct LockHead {
      */
     void migratePartitionedLockHeads();
 
+    /**
+     * Stops granting intent requests through the fast path slot and refreshes fastPathModes with
+     * the intent modes which are still held through it. May be called on an already disabled slot
+     * to refresh fastPathModes.
+     */
+    void disableFastPath();
+
     // Methods to maintain the granted queue
     void incGrantedModeCount(LockMode mode) {
         invariant(grantedCounts[mode] >= 0);
@@ -319,6 +341,19 @@ struct LockHead {
     // TODO: Remove this vector and make LockHead a POD
     std::vector<LockManager::Partition*> partitions;
 
+    //
+    // Intent fast path
+    //
+
+    // The fast path slot owned by this lock, or null if it has none. While the slot is enabled,
+    // the lock has no granted or pending modes other than the intent modes.
+    IntentFastPathSlot* fastPathSlot;
+
+    // Bit-mask of the intent modes held through the fast path slot, as of the last time they were
+    // counted. Only maintained while the slot is disabled, and may include modes of requests which
+    // have since been released, until they notify this lock.
+    uint32_t fastPathModes;
+
     //
     // Conversion
     //
@@ -409,6 +444,112 @@ void LockHead::migratePartitionedLockHeads() {
     }
 }
 
+/**
+ * The IntentFastPathSlot optimizes the case where a resource is locked in the intent modes by many
+ * threads at once, such as the global, database and collection locks taken by every read and
+ * write. Even with PartitionedLockHeads every such request takes a partition mutex, so the
+ * partition mutexes and the LockHead's cache lines become contended at high thread counts.
+ *
+ * While a slot is enabled for a resource, intent requests for it are granted by incrementing the
+ * counter of the slot's shard for the current CPU, without taking any mutex, and released by
+ * decrementing the same counter. Before a request in a conflicting mode is granted or queued on
+ * the owning LockHead, the slot is disabled and the counts are summed into the LockHead's
+ * fastPathModes. The requests still holding the resource through the slot then drain one by one,
+ * and each of them which sees the slot disabled notifies the LockHead, so that the requests waiting
+ * for the intent modes to drain can be granted.
+ *
+ * A request checks that the slot is still enabled, in the same generation, after incrementing its
+ * counter, and backs out otherwise. The LockHead sums the counters after marking the slot disabled.
+ * All these operations are sequentially consistent, so either the request backs out or its count
+ * is seen by the LockHead.
+ *
+ * A slot is owned by at most one LockHead at a time, which enables and disables it under its bucket
+ * mutex. The slot can only be given up while it is disabled and no requests are counted on it.
+ */
+struct IntentFastPathSlot {
+    // Power of two, so that CPU numbers are spread evenly
+    static constexpr unsigned kNumShards = 32;
+
+    // The lowest bit of 'state' is set while the slot is enabled, the rest is the generation
+    static constexpr uint64_t kEnabled = 1;
+
+    // Counts the requests granted through this slot for MODE_IS and MODE_IX respectively. Each
+    // shard is on a separate cache line in order to avoid false sharing.
+    struct alignas(stdx::hardware_destructive_interference_size) Shard {
+        AtomicWord<int64_t> counts[2];
+    };
+
+    static unsigned countIndex(LockMode mode) {
+        invariant(mode == MODE_IS || mode == MODE_IX);
+        return mode == MODE_IS ? 0 : 1;
+    }
+
+    /**
+     * Picks the shard which the request should increment, based on the CPU the calling thread is
+     * running on, or on the request's locker where the CPU is not known.
+     */
+    static unsigned shardFor(const LockRequest* request) {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        if (cpu >= 0) {
+            return static_cast<unsigned>(cpu) % kNumShards;
+        }
+#endif
+        return request->locker->getId() % kNumShards;
+    }
+
+    bool enabled() const {
+        return state.load() & kEnabled;
+    }
+
+    /**
+     * Must only be called by the owning LockHead under its bucket mutex. Enabling always starts a
+     * new generation, so that requests which saw the slot before it was disabled back out.
+     */
+    void enable() {
+        state.store((((state.load() >> 1) + 1) << 1) | kEnabled);
+    }
+
+    void disable() {
+        state.store(state.load() & ~kEnabled);
+    }
+
+    /**
+     * Returns the number of requests counted on this slot for the given intent mode, which includes
+     * requests that are about to back out.
+     */
+    int64_t count(LockMode mode) const {
+        const unsigned index = countIndex(mode);
+        int64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.counts[index].load();
+        }
+        return total;
+    }
+
+    /**
+     * Returns the bit-mask of the intent modes with requests counted on this slot.
+     */
+    uint32_t countedModes() const {
+        return (count(MODE_IS) ? modeMask(MODE_IS) : 0) | (count(MODE_IX) ? modeMask(MODE_IX) : 0);
+    }
+
+    // The resource whose LockHead owns this slot, or an invalid ResourceId if the slot is free.
+    // Only changes while the slot is disabled.
+    AtomicWord<ResourceId> resourceId;
+
+    // Enabled bit and generation, see kEnabled
+    AtomicWord<uint64_t> state{0};
+
+    Shard shards[kNumShards];
+};
+
+void LockHead::disableFastPath() {
+    invariant(fastPathSlot);
+    fastPathSlot->disable();
+    fastPathModes = fastPathSlot->countedModes();
+}
+
 //
 // LockManager
 //
@@ -420,6 +561,10 @@ const unsigned LockManager::_numLockBuckets(128);
 // The exact value doesn't appear very important, but should be power of two
 const unsigned LockManager::_numPartitions = 32;
 
+// Only the hottest resources need a fast path slot, and each slot takes one cache line per shard.
+// Resources whose slot is taken by another resource use the partitions instead.
+const unsigned LockManager::_numFastPathSlots = 64;
+
 // static
 LockManager* LockManager::get(ServiceContext* service) {
     return &getLockManager(service);
@@ -465,6 +610,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
 LockManager::LockManager() {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
+    _fastPathSlots = new IntentFastPathSlot[_numFastPathSlots];
 }
 
 LockManager::~LockManager() {
@@ -475,8 +621,13 @@ LockManager::~LockManager() {
         invariant(_lockBuckets[i].data.empty());
     }
 
+    for (unsigned i = 0; i < _numFastPathSlots; i++) {
+        invariant(!_fastPathSlots[i].resourceId.load().isValid());
+    }
+
     delete[] _lockBuckets;
     delete[] _partitions;
+    delete[] _fastPathSlots;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -486,8 +637,12 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     request->partitioned = (mode == MODE_IX || mode == MODE_IS);
     request->mode = mode;
 
-    // For intent modes, try the PartitionedLockHead
+    // For intent modes, try the fast path slot and then the PartitionedLockHead
     if (request->partitioned) {
+        if (_tryLockFastPath(resId, request)) {
+            return LOCK_OK;
+        }
+
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
         invariant(request->status == LockRequest::STATUS_NEW);
@@ -511,8 +666,14 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     LockHead* lock = bucket->findOrInsert(resId);
 
-    // Start a partitioned lock if possible
+    // Grant through the fast path slot or start a partitioned lock if possible
     if (request->partitioned && !(lock->grantedModes & (~intentModes)) && !lock->conflictModes) {
+        // The slot cannot be disabled again while the bucket mutex is held, so once it is enabled
+        // the request is always granted through it.
+        if (_enableFastPath(lock) && _tryLockFastPath(resId, request)) {
+            return LOCK_OK;
+        }
+
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
         PartitionedLockHead* partitionedLock = partition->findOrInsert(resId);
@@ -522,7 +683,12 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
         return LOCK_OK;
     }
 
-    // For the first lock with a non-intent mode, migrate requests from partitioned lock heads
+    // For the first lock with a non-intent mode, stop granting requests through the fast path slot
+    // and migrate requests from partitioned lock heads
+    if (lock->fastPathSlot) {
+        lock->disableFastPath();
+    }
+
     if (lock->partitioned()) {
         lock->migratePartitionedLockHeads();
     }
@@ -562,13 +728,22 @@ LockResult LockManager::convert(ResourceId resId, LockRequest* request, LockMode
 
     LockHead* const lock = it->second;
 
+    // Intent modes never conflict with the requests held through the fast path slot
+    if (lock->fastPathSlot && !(modeMask(newMode) & intentModes)) {
+        lock->disableFastPath();
+    }
+
+    if (request->fastPathSlot) {
+        _migrateFastPathRequest(lock, request);
+    }
+
     if (lock->partitioned()) {
         lock->migratePartitionedLockHeads();
     }
 
     // Construct granted mask without our current mode, so that it is not counted as
-    // conflicting
-    uint32_t grantedModesWithoutCurrentRequest = 0;
+    // conflicting. The modes held through the fast path slot are all held by other requests.
+    uint32_t grantedModesWithoutCurrentRequest = lock->fastPathModes;
 
     // We start the counting at 1 below, because LockModesCount also includes MODE_NONE
     // at position 0, which can never be acquired/granted.
@@ -609,6 +784,21 @@ bool LockManager::unlock(LockRequest* request) {
     invariant(request->recursiveCount > 0);
     request->recursiveCount--;
 
+    if (request->fastPathSlot) {
+        // Requests granted through the fast path only move to the LockHead when converted or
+        // downgraded, which happens on the same thread, so no synchronization is needed here.
+        invariant(request->status == LockRequest::STATUS_GRANTED);
+        if (request->recursiveCount > 0)
+            return false;
+
+        IntentFastPathSlot* slot = std::exchange(request->fastPathSlot, nullptr);
+        slot->shards[request->fastPathShard]
+            .counts[IntentFastPathSlot::countIndex(request->mode)]
+            .fetchAndSubtract(1);
+        _onFastPathReleased(slot);
+        return true;
+    }
+
     if (request->partitioned) {
         // Unlocking a lock that was acquired as partitioned. The lock request may since have
         // moved to the lock head, but there is no safe way to find out without synchronizing
@@ -686,7 +876,7 @@ bool LockManager::unlock(LockRequest* request) {
 }
 
 void LockManager::downgrade(LockRequest* request, LockMode newMode) {
-    invariant(request->lock);
+    invariant(request->lock || request->fastPathSlot);
     invariant(request->recursiveCount > 0);
 
     // The conflict set of the newMode should be a subset of the conflict set of the old mode.
@@ -694,12 +884,22 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
     invariant((LockConflictsTable[request->mode] | LockConflictsTable[newMode]) ==
               LockConflictsTable[request->mode]);
 
-    LockHead* lock = request->lock;
+    // The fast path slot cannot be given up while this request is counted on it
+    const ResourceId resId =
+        request->lock ? request->lock->resourceId : request->fastPathSlot->resourceId.load();
 
-    LockBucket* bucket = _getBucket(lock->resourceId);
+    LockBucket* bucket = _getBucket(resId);
     stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
     invariant(request->status == LockRequest::STATUS_GRANTED);
 
+    if (request->fastPathSlot) {
+        LockBucket::Map::iterator it = bucket->data.find(resId);
+        invariant(it != bucket->data.end());
+        _migrateFastPathRequest(it->second, request);
+    }
+
+    LockHead* lock = request->lock;
+
     lock->incGrantedModeCount(newMode);
     lock->decGrantedModeCount(request->mode);
     request->mode = newMode;
@@ -725,7 +925,22 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
             lock->migratePartitionedLockHeads();
         }
 
-        if (lock->grantedModes == 0) {
+        if (lock->fastPathSlot) {
+            // Only give up the slot if no requests are held through it. Once disabled, any request
+            // which raced with the check is either counted below or backs out.
+            if (lock->grantedModes == 0 && !lock->fastPathSlot->countedModes()) {
+                lock->disableFastPath();
+            }
+
+            // Requests held through a disabled slot may have drained without their notification
+            // having reached this lock yet.
+            if (!lock->fastPathSlot->enabled()) {
+                _onLockModeChanged(lock, true);
+            }
+        }
+
+        if (lock->grantedModes == 0 && lock->fastPathModes == 0 &&
+            !(lock->fastPathSlot && lock->fastPathSlot->enabled())) {
             invariant(lock->grantedModes == 0);
             invariant(lock->grantedList._front == nullptr);
             invariant(lock->grantedList._back == nullptr);
@@ -735,6 +950,10 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
             invariant(lock->conversionsCount == 0);
             invariant(lock->compatibleFirstCount == 0);
 
+            if (lock->fastPathSlot) {
+                lock->fastPathSlot->resourceId.store(ResourceId());
+            }
+
             bucket->data.erase(it++);
             deletedLockHeads++;
             delete lock;
@@ -745,6 +964,12 @@ void LockManager::_cleanupUnusedLocksInBucket(LockBucket* bucket) {
 }
 
 void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
+    // Requests held through a disabled fast path slot drain without taking the bucket mutex, so
+    // count which intent modes are still held through it.
+    if (lock->fastPathSlot && !lock->fastPathSlot->enabled()) {
+        lock->fastPathModes = lock->fastPathSlot->countedModes();
+    }
+
     // Unblock any converting requests (because conversions are still counted as granted and
     // are on the granted queue).
     for (LockRequest* iter = lock->grantedList._front;
@@ -756,7 +981,7 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
 
             // Construct granted mask without our current mode, so that it is not accounted as
             // a conflict
-            uint32_t grantedModesWithoutCurrentRequest = 0;
+            uint32_t grantedModesWithoutCurrentRequest = lock->fastPathModes;
 
             // We start the counting at 1 below, because LockModesCount also includes
             // MODE_NONE at position 0, which can never be acquired/granted.
@@ -814,7 +1039,7 @@ void LockManager::_onLockModeChanged(LockHead* lock, bool checkConflictQueue) {
         // the granted queue.
         iterNext = iter->next;
 
-        if (conflicts(iter->mode, lock->grantedModes)) {
+        if (conflicts(iter->mode, lock->grantedModes | lock->fastPathModes)) {
             // If iter doesn't have a previous pointer, this means that it is at the front of the
             // queue. If we continue scanning the queue beyond this point, we will starve it by
             // granting more and more requests. However, if we newly transition to compatibleFirst
@@ -862,6 +1087,106 @@ LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
     return &_partitions[request->locker->getId() % _numPartitions];
 }
 
+IntentFastPathSlot* LockManager::_getFastPathSlot(ResourceId resId) const {
+    return &_fastPathSlots[resId % _numFastPathSlots];
+}
+
+bool LockManager::_tryLockFastPath(ResourceId resId, LockRequest* request) {
+    invariant(request->status == LockRequest::STATUS_NEW);
+    if (!isFastPathResource(resId.getType())) {
+        return false;
+    }
+
+    IntentFastPathSlot* slot = _getFastPathSlot(resId);
+    const uint64_t state = slot->state.load();
+    if (!(state & IntentFastPathSlot::kEnabled) || slot->resourceId.load() != resId) {
+        return false;
+    }
+
+    const unsigned shard = IntentFastPathSlot::shardFor(request);
+    auto& count = slot->shards[shard].counts[IntentFastPathSlot::countIndex(request->mode)];
+    count.fetchAndAdd(1);
+
+    if (slot->state.load() != state) {
+        // The slot was disabled, and possibly re-enabled or given to another resource, after it
+        // was checked. Its owner may have counted this request and be waiting for it to drain.
+        count.fetchAndSubtract(1);
+        _onFastPathReleased(slot);
+        return false;
+    }
+
+    request->fastPathSlot = slot;
+    request->fastPathShard = shard;
+    request->partitioned = false;
+    request->status = LockRequest::STATUS_GRANTED;
+    return true;
+}
+
+bool LockManager::_enableFastPath(LockHead* lock) {
+    invariant(!(lock->grantedModes & ~intentModes) && !lock->conflictModes);
+
+    if (!lock->fastPathSlot) {
+        if (!isFastPathResource(lock->resourceId.getType())) {
+            return false;
+        }
+
+        IntentFastPathSlot* slot = _getFastPathSlot(lock->resourceId);
+        ResourceId unowned;
+        if (!slot->resourceId.compareAndSwap(&unowned, lock->resourceId)) {
+            return false;
+        }
+        lock->fastPathSlot = slot;
+    }
+
+    if (!lock->fastPathSlot->enabled()) {
+        lock->fastPathSlot->enable();
+        lock->fastPathModes = 0;
+    }
+    return true;
+}
+
+void LockManager::_migrateFastPathRequest(LockHead* lock, LockRequest* request) {
+    invariant(request->fastPathSlot == lock->fastPathSlot);
+    invariant(request->status == LockRequest::STATUS_GRANTED);
+
+    // Same as granting through newRequest(), which cannot be used because there may be pending
+    // requests waiting for this one to drain.
+    request->lock = lock;
+    lock->grantedList.push_back(request);
+    lock->incGrantedModeCount(request->mode);
+    if (request->compatibleFirst) {
+        lock->compatibleFirstCount++;
+    }
+
+    IntentFastPathSlot* slot = std::exchange(request->fastPathSlot, nullptr);
+    slot->shards[request->fastPathShard]
+        .counts[IntentFastPathSlot::countIndex(request->mode)]
+        .fetchAndSubtract(1);
+    if (!slot->enabled()) {
+        lock->fastPathModes = slot->countedModes();
+    }
+}
+
+void LockManager::_onFastPathReleased(IntentFastPathSlot* slot) {
+    if (slot->enabled()) {
+        return;
+    }
+
+    // The slot may have been given to another resource since the count was released, in which case
+    // the previous owner has already counted the requests held through it.
+    const ResourceId resId = slot->resourceId.load();
+    if (!resId.isValid()) {
+        return;
+    }
+
+    LockBucket* bucket = _getBucket(resId);
+    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    LockBucket::Map::iterator it = bucket->data.find(resId);
+    if (it != bucket->data.end() && it->second->fastPathSlot == slot) {
+        _onLockModeChanged(it->second, true);
+    }
+}
+
 void LockManager::dump() const {
     BSONArrayBuilder locks;
     _buildLocksArray(getLockToClientMap(getGlobalServiceContext()), true, nullptr, &locks);
@@ -892,12 +1217,22 @@ void LockManager::_buildLocksArray(const std::map<LockerId, BSONObj>& lockToClie
         }
         for (auto&& kv : bucket.data) {
             const auto& lock = kv.second;
-            if (lock->grantedList.empty())
+            const bool fastPathGranted =
+                lock->fastPathSlot && lock->fastPathSlot->countedModes() != 0;
+            if (lock->grantedList.empty() && !fastPathGranted)
                 continue;
             auto o = BSONObjBuilder(locks->subobjStart());
             if (forLogging)
                 o.append("lockAddr", formatPtr(lock));
             o.append("resourceId", lock->resourceId.toString());
+            if (fastPathGranted) {
+                // Requests granted through the fast path are only counted, per intent mode
+                auto counts = BSONObjBuilder(o.subobjStart("fastPathGranted"));
+                for (auto mode : {MODE_IS, MODE_IX}) {
+                    counts.append(modeName(mode),
+                                  static_cast<long long>(lock->fastPathSlot->count(mode)));
+                }
+            }
             struct {
                 StringData key;
                 LockRequest* iter;
@@ -1000,6 +1335,8 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
 
     lock = nullptr;
     partitionedLock = nullptr;
+    fastPathSlot = nullptr;
+    fastPathShard = 0;
     prev = nullptr;
     next = nullptr;
     status = STATUS_NEW;
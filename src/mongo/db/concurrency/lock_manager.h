@@ -160,6 +160,8 @@ public:
      *             "resourceId": <string>,
      *             "granted": [ {...}, ... ],  // array of lock requests
      *             "pending": [ {...}, ... ],  // array of lock requests
+     *             // only present while requests hold the resource through its fast path slot
+     *             "fastPathGranted": {"IS": <number>, "IX": <number>},
      *         },
      *         ...
      *     ]
@@ -203,6 +205,44 @@ private:
      */
     Partition* _getPartition(LockRequest* request) const;
 
+    /**
+     * Retrieves the only fast path slot which the particular resource may use, whether or not it
+     * currently owns it. There is no need to hold a lock when calling this function.
+     */
+    IntentFastPathSlot* _getFastPathSlot(ResourceId resId) const;
+
+    /**
+     * Attempts to grant an intent mode request through the fast path slot of the resource, which
+     * only increments a counter and does not take any mutex. Returns false if the slot is not
+     * enabled for the resource, in which case the request must go through the regular LockHead.
+     */
+    bool _tryLockFastPath(ResourceId resId, LockRequest* request);
+
+    /**
+     * Assigns the fast path slot of the resource to the lock if it is free, and enables it for
+     * intent requests. Returns false if the slot is owned by another resource.
+     *
+     * MUST be called under the lock bucket's mutex, and only while the lock has no granted or
+     * pending requests in modes which conflict with the intent modes.
+     */
+    bool _enableFastPath(LockHead* lock);
+
+    /**
+     * Moves a request granted through the fast path to the granted queue of its lock, so that it
+     * can be converted or downgraded.
+     *
+     * MUST be called under the lock bucket's mutex.
+     */
+    void _migrateFastPathRequest(LockHead* lock, LockRequest* request);
+
+    /**
+     * Should be invoked after a count is released from a fast path slot. If the slot has been
+     * disabled, the lock which owns it may have requests waiting for the counts to drain.
+     *
+     * MUST NOT be called under any lock bucket's mutex.
+     */
+    void _onFastPathReleased(IntentFastPathSlot* slot);
+
     /**
      * The backend of `dump` and `getLockInfoBSON`.
      * If `mutableThis`, then we also clean the unused locks in the buckets while iterating.
@@ -237,5 +277,8 @@ private:
 
     static const unsigned _numPartitions;
     Partition* _partitions;
+
+    static const unsigned _numFastPathSlots;
+    IntentFastPathSlot* _fastPathSlots;
 };
 }  // namespace mongo
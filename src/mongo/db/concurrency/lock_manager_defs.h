@@ -46,6 +46,7 @@ namespace mongo {
 
 class Locker;
 
+struct IntentFastPathSlot;
 struct LockHead;
 struct PartitionedLockHead;
 
@@ -408,9 +409,10 @@ struct LockRequest {
     unsigned recursiveCount;
 
     // Pointer to the lock to which this request belongs, or null if this request has not yet been
-    // assigned to a lock or if it belongs to the PartitionedLockHead for locker (in which case
-    // partitionedLock must be set). The LockHead should be alive as long as there are LockRequests
-    // on it, so it is safe to have this pointer hanging around.
+    // assigned to a lock, if it belongs to the PartitionedLockHead for locker (in which case
+    // partitionedLock must be set) or if it was granted through an intent fast path slot (in which
+    // case fastPathSlot must be set). The LockHead should be alive as long as there are
+    // LockRequests on it, so it is safe to have this pointer hanging around.
     //
     // Written by LockManager on any thread
     // Read by LockManager on any thread
@@ -426,6 +428,24 @@ struct LockRequest {
     // Protected by LockHead bucket's mutex
     PartitionedLockHead* partitionedLock;
 
+    // Pointer to the intent fast path slot through which this request was granted, or null if it
+    // was granted on a LockHead or PartitionedLockHead. A request can only transition from
+    // 'fastPathSlot' to 'lock', never the other way around. The slot stays assigned to the
+    // request's resource for as long as the request holds it.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    IntentFastPathSlot* fastPathSlot;
+
+    // Index of the counter shard of 'fastPathSlot' which counts this request. Only meaningful while
+    // 'fastPathSlot' is set.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    unsigned fastPathShard;
+
     // The linked list chain on which this request hangs off the owning lock head. The reason
     // intrusive linked list is used instead of the std::list class is to allow for entries to be
     // removed from the middle of the list in O(1) time, if they are known instead of having to
@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/concurrency/lock_manager_test_help.h"
 #include "mongo/unittest/unittest.h"
@@ -952,4 +953,146 @@ TEST(LockManager, Fairness) {
     ASSERT(lockMgr.unlock(&requestIX1));
 }
 
+/**
+ * Returns the counts of the requests holding the only locked resource through its fast path slot,
+ * as reported by lockInfo.
+ */
+BSONObj getFastPathGranted(LockManager& lockMgr) {
+    BSONObjBuilder builder;
+    lockMgr.getLockInfoBSON({}, &builder);
+    const BSONObj lockInfo = builder.obj();
+    const auto locks = lockInfo["lockInfo"].Array();
+    ASSERT_EQ(1U, locks.size());
+    return locks[0].Obj().getObjectField("fastPathGranted").getOwned();
+}
+
+TEST(LockManager, FastPathIntentModesDrainBeforeExclusive) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    LockerImpl locker1;
+    LockerImpl locker2;
+    LockerImpl locker3;
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+    LockRequestCombo request3(&locker3);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_IS));
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request2, MODE_IX));
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request3, MODE_IS));
+    ASSERT_BSONOBJ_EQ(BSON("IS" << 2LL << "IX" << 1LL), getFastPathGranted(lockMgr));
+
+    LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestX, MODE_X));
+
+    // Intent requests queue up behind the exclusive request instead of using the fast path
+    LockerImpl lockerIS;
+    LockRequestCombo requestIS(&lockerIS);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestIS, MODE_IS));
+
+    // The exclusive request is only granted once all intent requests held through the fast path
+    // have been released
+    ASSERT(lockMgr.unlock(&request1));
+    ASSERT(lockMgr.unlock(&request2));
+    ASSERT_EQ(0, requestX.numNotifies);
+    ASSERT(lockMgr.unlock(&request3));
+    ASSERT_EQ(LOCK_OK, requestX.lastResult);
+    ASSERT_EQ(1, requestX.numNotifies);
+    ASSERT_EQ(0, requestIS.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestX));
+    ASSERT_EQ(LOCK_OK, requestIS.lastResult);
+    ASSERT_EQ(1, requestIS.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestIS));
+}
+
+TEST(LockManager, FastPathSharedCompatibleWithIntentShared) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    LockerImpl lockerIS;
+    LockRequestCombo requestIS(&lockerIS);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS, MODE_IS));
+
+    LockerImpl lockerS;
+    LockRequestCombo requestS(&lockerS);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestS, MODE_S));
+
+    // While S is held, intent shared requests are granted on the LockHead
+    LockerImpl lockerIS2;
+    LockRequestCombo requestIS2(&lockerIS2);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS2, MODE_IS));
+
+    LockerImpl lockerIX;
+    LockRequestCombo requestIX(&lockerIX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestIX, MODE_IX));
+
+    ASSERT(lockMgr.unlock(&requestS));
+    ASSERT_EQ(LOCK_OK, requestIX.lastResult);
+    ASSERT_EQ(1, requestIX.numNotifies);
+
+    ASSERT(lockMgr.unlock(&requestIS));
+    ASSERT(lockMgr.unlock(&requestIS2));
+    ASSERT(lockMgr.unlock(&requestIX));
+}
+
+TEST(LockManager, FastPathReenabledAfterConflictingRequestReleased) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    LockerImpl lockerIX;
+    LockRequestCombo requestIX(&lockerIX);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIX, MODE_IX));
+
+    LockerImpl lockerS;
+    LockRequestCombo requestS(&lockerS);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestS, MODE_S));
+    ASSERT(lockMgr.unlock(&requestIX));
+    ASSERT_EQ(LOCK_OK, requestS.lastResult);
+    ASSERT(lockMgr.unlock(&requestS));
+
+    // Once the conflicting request is gone, intent requests use the fast path again
+    LockerImpl lockerIS;
+    LockRequestCombo requestIS(&lockerIS);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &requestIS, MODE_IS));
+    ASSERT_BSONOBJ_EQ(BSON("IS" << 1LL << "IX" << 0LL), getFastPathGranted(lockMgr));
+
+    ASSERT(lockMgr.unlock(&requestIS));
+}
+
+TEST(LockManager, FastPathConvertAndDowngrade) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_GLOBAL, 0);
+
+    LockerImpl locker1;
+    LockerImpl locker2;
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_IS));
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request2, MODE_IX));
+
+    // Converting to another intent mode does not conflict with the fast path
+    ASSERT(LOCK_OK == lockMgr.convert(resId, &request1, MODE_IX));
+    ASSERT(request1.mode == MODE_IX);
+
+    // Converting to a conflicting mode waits for the other fast path request
+    LockerImpl locker3;
+    LockRequestCombo request3(&locker3);
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request3, MODE_IS));
+    ASSERT(LOCK_WAITING == lockMgr.convert(resId, &request3, MODE_S));
+    ASSERT(lockMgr.unlock(&request1) == false);
+    ASSERT(lockMgr.unlock(&request1));
+
+    // Downgrading the fast path request lets the conversion through
+    lockMgr.downgrade(&request2, MODE_IS);
+    ASSERT_EQ(LOCK_OK, request3.lastResult);
+    ASSERT_EQ(1, request3.numNotifies);
+    ASSERT(request3.mode == MODE_S);
+
+    ASSERT(lockMgr.unlock(&request2));
+    ASSERT(lockMgr.unlock(&request3) == false);
+    ASSERT(lockMgr.unlock(&request3));
+}
+
 }  // namespace mongo
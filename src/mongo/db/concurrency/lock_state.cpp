@@ -377,8 +377,8 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, getAdmissionPriority());
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, getAdmissionPriority())) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
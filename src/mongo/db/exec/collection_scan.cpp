@@ -62,6 +62,7 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
+      _compiledFilter(CompiledMatcher::compile(_filter)),
       _params(params) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
@@ -70,12 +71,11 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     _specificStats.tailable = params.tailable;
     if (params.minRecord || params.maxRecord) {
         // The 'minRecord' and 'maxRecord' parameters are used for a special optimization that
-        // applies only to forwards scans of the oplog and scans on collections clustered by _id.
+        // applies only to forwards scans of the oplog, scans on collections clustered by _id and
+        // the RecordId range partitions scanned by parallel index builds.
         invariant(!params.resumeAfterRecordId);
         if (collection->ns().isOplog()) {
             invariant(params.direction == CollectionScanParams::FORWARD);
-        } else {
-            invariant(collection->isClustered());
         }
     }
     LOGV2_DEBUG(5400802,
@@ -126,6 +126,9 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             _cursor = collection()->getCursor(opCtx(), forward);
+            if (!_params.tailable) {
+                _cursor->enableReadAhead();
+            }
 
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
@@ -275,9 +278,13 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
         return PlanStage::IS_EOF;
     }
 
-    if (Filter::passes(member, _filter)) {
+    const bool passes = (_compiledFilter && member->hasObj())
+        ? _compiledFilter->matches(member->doc.value().toBson())
+        : Filter::passes(member, _filter);
+    if (passes) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
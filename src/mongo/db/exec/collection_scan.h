@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/compiled_matcher.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -123,6 +124,10 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Single-pass form of '_filter', used when the filter is a conjunction of several path
+    // predicates.
+    std::unique_ptr<CompiledMatcher> _compiledFilter;
+
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
     CollectionScanParams _params;
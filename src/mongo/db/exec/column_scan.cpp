@@ -0,0 +1,274 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/column_store_access_method.h"
+
+namespace mongo {
+
+namespace {
+
+const ColumnStoreAccessMethod* asColumnStore(const IndexAccessMethod* accessMethod) {
+    return static_cast<const ColumnStoreAccessMethod*>(accessMethod);
+}
+
+}  // namespace
+
+// static
+const char* ColumnScan::kStageType = "COLUMN_SCAN";
+
+ColumnScan::ColumnScan(ExpressionContext* expCtx,
+                       const CollectionPtr& collection,
+                       const IndexDescriptor* indexDescriptor,
+                       WorkingSet* workingSet,
+                       const MatchExpression* filter)
+    : RequiresIndexStage(kStageType, expCtx, collection, indexDescriptor, workingSet),
+      _workingSet(workingSet),
+      _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
+      _paths(asColumnStore(indexAccessMethod())->getPaths()) {
+    _specificStats.indexName = indexDescriptor->indexName();
+    _specificStats.keyPattern = indexDescriptor->keyPattern().getOwned();
+}
+
+void ColumnScan::initColumnCursors() {
+    auto sortedData = indexAccessMethod()->getSortedDataInterface();
+
+    _columnCursors.clear();
+    _currentCells.clear();
+    for (size_t pathIndex = 0; pathIndex < _paths.size(); ++pathIndex) {
+        const BSONObj prefix = ColumnStoreAccessMethod::makeColumnPrefix(pathIndex);
+
+        auto cursor = indexAccessMethod()->newCursor(opCtx(), true /* forward */);
+        cursor->setEndPosition(prefix, true /* inclusive */);
+        auto cell = cursor->seek(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+            prefix,
+            sortedData->getKeyStringVersion(),
+            sortedData->getOrdering(),
+            true /* forward */,
+            true /* inclusive */));
+        if (cell) {
+            ++_specificStats.keysExamined;
+            cell->key = cell->key.getOwned();
+        }
+
+        _columnCursors.push_back(std::move(cursor));
+        _currentCells.push_back(std::move(cell));
+    }
+    _needsAdvance.assign(_paths.size(), false);
+}
+
+void ColumnScan::advanceColumns() {
+    for (size_t i = 0; i < _columnCursors.size(); ++i) {
+        if (!_needsAdvance[i]) {
+            continue;
+        }
+
+        // An update made while the scan was yielded can move a cell of a document which has
+        // already been consumed further along its column, where the cursor finds it again. Skip
+        // such cells so that no document is returned twice.
+        auto cell = _columnCursors[i]->next();
+        while (cell && _lastRecordId && cell->loc <= *_lastRecordId) {
+            ++_specificStats.keysExamined;
+            cell = _columnCursors[i]->next();
+        }
+        if (cell) {
+            ++_specificStats.keysExamined;
+            cell->key = cell->key.getOwned();
+        }
+        _currentCells[i] = std::move(cell);
+        _needsAdvance[i] = false;
+    }
+}
+
+PlanStage::StageState ColumnScan::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    try {
+        if (!_initialized) {
+            initColumnCursors();
+            _initialized = true;
+        } else {
+            advanceColumns();
+        }
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    // Every document has a cell in every column, so the columns normally move in lockstep. They
+    // can only diverge when documents are inserted or deleted while the scan is yielded.
+    boost::optional<RecordId> recordId;
+    for (auto&& cell : _currentCells) {
+        if (cell && (!recordId || cell->loc < *recordId)) {
+            recordId = cell->loc;
+        }
+    }
+
+    if (!recordId) {
+        _commonStats.isEOF = true;
+        _columnCursors.clear();
+        _fetchCursor.reset();
+        return PlanStage::IS_EOF;
+    }
+
+    bool covered = true;
+    for (auto&& cell : _currentCells) {
+        if (!cell || cell->loc != *recordId ||
+            ColumnStoreAccessMethod::decodeCell(cell->key).kind ==
+                ColumnStoreAccessMethod::CellKind::kUncovered) {
+            covered = false;
+            break;
+        }
+    }
+
+    // This RecordId has been consumed by every column that holds it.
+    auto consumeRecordId = [&] {
+        for (size_t i = 0; i < _currentCells.size(); ++i) {
+            _needsAdvance[i] = _currentCells[i] && _currentCells[i]->loc == *recordId;
+        }
+        _lastRecordId = *recordId;
+    };
+
+    BSONObj obj;
+    if (covered) {
+        MutableDocument assembled;
+        for (size_t i = 0; i < _currentCells.size(); ++i) {
+            auto cell = ColumnStoreAccessMethod::decodeCell(_currentCells[i]->key);
+            if (cell.kind == ColumnStoreAccessMethod::CellKind::kValue) {
+                assembled.setNestedField(FieldPath(_paths[i]), Value(cell.value));
+            }
+        }
+        obj = assembled.freeze().toBson();
+        ++_specificStats.docsAssembled;
+    } else {
+        boost::optional<Record> record;
+        try {
+            if (!_fetchCursor) {
+                _fetchCursor = collection()->getCursor(opCtx());
+            }
+            record = _fetchCursor->seekExact(*recordId);
+        } catch (const WriteConflictException&) {
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
+        }
+        ++_specificStats.docsFetched;
+
+        // The document may have been deleted since its cells were read.
+        if (!record) {
+            consumeRecordId();
+            return PlanStage::NEED_TIME;
+        }
+        obj = record->data.releaseToBson().getOwned();
+    }
+    consumeRecordId();
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), obj);
+    _workingSet->transitionToOwnedObj(id);
+
+    ++_specificStats.docsTested;
+    if (!Filter::passes(member, _filter)) {
+        _workingSet->free(id);
+        return PlanStage::NEED_TIME;
+    }
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+bool ColumnScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScan::doSaveStateRequiresIndex() {
+    for (auto&& cursor : _columnCursors) {
+        cursor->save();
+    }
+    if (_fetchCursor) {
+        _fetchCursor->saveUnpositioned();
+    }
+}
+
+void ColumnScan::doRestoreStateRequiresIndex() {
+    for (auto&& cursor : _columnCursors) {
+        cursor->restore();
+    }
+    if (_fetchCursor) {
+        const bool couldRestore = _fetchCursor->restore();
+        uassert(5962102, "could not restore cursor for COLUMN_SCAN stage", couldRestore);
+    }
+}
+
+void ColumnScan::doDetachFromOperationContext() {
+    for (auto&& cursor : _columnCursors) {
+        cursor->detachFromOperationContext();
+    }
+    if (_fetchCursor) {
+        _fetchCursor->detachFromOperationContext();
+    }
+}
+
+void ColumnScan::doReattachToOperationContext() {
+    for (auto&& cursor : _columnCursors) {
+        cursor->reattachToOperationContext(opCtx());
+    }
+    if (_fetchCursor) {
+        _fetchCursor->reattachToOperationContext(opCtx());
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScan::getStats() {
+    // Add a BSON representation of the filter to the stats tree, if there is one.
+    if (nullptr != _filter) {
+        BSONObjBuilder bob;
+        _filter->serialize(&bob);
+        _commonStats.filter = bob.obj();
+    }
+
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = std::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+/**
+ * Scans the columns of a column store index side by side and assembles, for each RecordId, a
+ * document holding the index's paths. Documents whose cells are uncovered, or missing from some
+ * of the columns, are read from the record store instead. Returns the documents that pass the
+ * provided filter as owned objects.
+ *
+ * The assembled documents only hold the paths of the index, in key pattern order, so the filter
+ * and any projection or sort applied on top of this stage must only depend on those paths.
+ *
+ * Sub-stage preconditions: None. Is a leaf and consumes no stage data.
+ */
+class ColumnScan final : public RequiresIndexStage {
+public:
+    ColumnScan(ExpressionContext* expCtx,
+               const CollectionPtr& collection,
+               const IndexDescriptor* indexDescriptor,
+               WorkingSet* workingSet,
+               const MatchExpression* filter);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    /**
+     * Opens one cursor per path and positions each at the start of its column.
+     */
+    void initColumnCursors();
+
+    /**
+     * Moves every column flagged in '_needsAdvance' to its next cell.
+     */
+    void advanceColumns();
+
+    // The WorkingSet we fill with results. Not owned by us.
+    WorkingSet* const _workingSet;
+
+    // Not owned by us.
+    const MatchExpression* const _filter;
+
+    const std::vector<std::string> _paths;
+
+    // One cursor per path, together with the cell it is positioned on. A column is exhausted once
+    // its current entry is boost::none.
+    std::vector<std::unique_ptr<SortedDataInterface::Cursor>> _columnCursors;
+    std::vector<boost::optional<IndexKeyEntry>> _currentCells;
+
+    // Columns whose current cell has been consumed. They are advanced at the start of the next
+    // call to work() so that a WriteConflictException cannot leave the columns out of step.
+    std::vector<bool> _needsAdvance;
+
+    // The last RecordId consumed. RecordIds are consumed in increasing order, so cells at or
+    // before it belong to documents which have already been consumed.
+    boost::optional<RecordId> _lastRecordId;
+
+    // Reads the documents which the index does not cover.
+    std::unique_ptr<SeekableRecordCursor> _fetchCursor;
+
+    bool _initialized = false;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
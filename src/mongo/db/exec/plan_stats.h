@@ -254,6 +254,36 @@ struct CollectionScanStats : public SpecificStats {
     boost::optional<RecordId> maxRecord;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        auto specific = std::make_unique<ColumnScanStats>(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // How many column cells did we read?
+    size_t keysExamined{0};
+
+    // How many documents did we assemble from the index columns?
+    size_t docsAssembled{0};
+
+    // How many documents did we have to read from the record store because the index did not
+    // cover them?
+    size_t docsFetched{0};
+
+    // How many documents did we check against our filter?
+    size_t docsTested{0};
+};
+
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
@@ -260,6 +260,10 @@ void ScanStage::open(bool reOpen) {
 
         if (!_cursor || !_seekKeyAccessor) {
             _cursor = _coll->getCursor(_opCtx, _forward);
+            if (!_seekKeyAccessor) {
+                // Without a seek key this stage scans the whole collection.
+                _cursor->enableReadAhead();
+            }
         }
     } else {
         _cursor.reset();
@@ -144,26 +144,16 @@ std::pair<TypeTags, Value> makeCopyPcreRegex(const PcreRegex& regex) {
 
 void PcreRegex::_compile() {
     const auto pcreOptions = regex_util::flagsToPcreOptions(_options.c_str()).all_options();
-    const char* compile_error;
-    int eoffset;
-    _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
-    uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
+    _regex = RegexCache::get().getOrCompile(_pattern, pcreOptions);
+    uassert(5073402, str::stream() << "Invalid Regex: " << _regex->error(), _regex->error().empty());
 }
 
 int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& buf) {
-    return pcre_exec(_pcrePtr,
-                     nullptr,
-                     stringView.rawData(),
-                     stringView.size(),
-                     startPos,
-                     0,
-                     &(buf.front()),
-                     buf.size());
+    return _regex->execute(stringView, startPos, &(buf.front()), buf.size());
 }
 
 size_t PcreRegex::getNumberCaptures() const {
-    int numCaptures;
-    pcre_fullinfo(_pcrePtr, nullptr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
+    int numCaptures = _regex->numCaptures();
     invariant(numCaptures >= 0);
     return static_cast<size_t>(numCaptures);
 }
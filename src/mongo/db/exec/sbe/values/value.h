@@ -36,7 +36,6 @@
 #include <boost/predef/hardware/simd.h>
 #include <cstdint>
 #include <ostream>
-#include <pcre.h>
 #include <string>
 #include <utility>
 #include <vector>
@@ -48,6 +47,7 @@
 #include "mongo/db/fts/fts_matcher.h"
 #include "mongo/db/query/bson_typemask.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/regex_cache.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/platform/endian.h"
@@ -621,9 +621,8 @@ private:
 
 /**
  * Implements a wrapper of PCRE regular expression.
- * Storing the pattern and the options allows for copying of the sbe::value::PcreRegex expression,
- * which includes recompilation.
- * The compiled expression pcre* allows for direct usage of the pcre C library functionality.
+ * The compiled expression is obtained from the process-wide RegexCache and is immutable, so copies
+ * of a sbe::value::PcreRegex share it rather than recompiling the pattern.
  */
 class PcreRegex {
 public:
@@ -631,22 +630,6 @@ public:
         _compile();
     }
 
-    PcreRegex(const PcreRegex& other) : PcreRegex(other._pattern, other._options) {}
-
-    PcreRegex& operator=(const PcreRegex& other) {
-        if (this != &other) {
-            (*pcre_free)(_pcrePtr);
-            _pattern = other._pattern;
-            _options = other._options;
-            _compile();
-        }
-        return *this;
-    }
-
-    ~PcreRegex() {
-        (*pcre_free)(_pcrePtr);
-    }
-
     const std::string& pattern() const {
         return _pattern;
     }
@@ -676,7 +659,7 @@ private:
     std::string _pattern;
     std::string _options;
 
-    pcre* _pcrePtr = nullptr;
+    std::shared_ptr<const CompiledRegex> _regex;
 };
 
 constexpr size_t kSmallStringMaxLength = 7;
@@ -231,6 +231,10 @@ public:
         // frequent schema changes.
         commandBuilder.append("transactions", BSON("includeLastCommitted" << false));
 
+        // Exclude 'serverStatus.latchContention.<name>.holderSites' because the set of sites varies
+        // between samples, and FTDC does not record the strings describing them.
+        commandBuilder.append("latchContention", BSON("holderSites" << false));
+
         if (gDiagnosticDataCollectionEnableLatencyHistograms.load()) {
             BSONObjBuilder subObjBuilder(commandBuilder.subobjStart("opLatencies"));
             subObjBuilder.append("histograms", true);
@@ -152,6 +152,14 @@ public:
         return (*this = (*this & other));
     }
 
+    ByteVector operator^(ByteVector other) const {
+        return (Native)vec_xor(_data, other._data);
+    }
+
+    ByteVector& operator^=(ByteVector other) {
+        return (*this = (*this ^ other));
+    }
+
 private:
     ByteVector(Native data) : _data(data) {}
 
@@ -148,6 +148,14 @@ public:
         return (*this = (*this & other));
     }
 
+    ByteVector operator^(ByteVector other) const {
+        return veorq_u8(_data, other._data);
+    }
+
+    ByteVector& operator^=(ByteVector other) {
+        return (*this = (*this ^ other));
+    }
+
 private:
     ByteVector(Native data) : _data(data) {}
 
@@ -175,6 +175,32 @@ TEST(ByteVector, BitAndAssign) {
     }
 }
 
+TEST(ByteVector, BitXor) {
+    uint8_t inputBuf[ByteVector::size];
+    uint8_t outputBuf[ByteVector::size] = {};
+    std::iota(std::begin(inputBuf), std::end(inputBuf), 0);
+
+    (ByteVector::load(inputBuf) ^ ByteVector(3)).store(outputBuf);
+
+    for (size_t i = 0; i < ByteVector::size; i++) {
+        ASSERT_EQ(outputBuf[i], inputBuf[i] ^ 3);
+    }
+}
+
+TEST(ByteVector, BitXorAssign) {
+    uint8_t inputBuf[ByteVector::size];
+    uint8_t outputBuf[ByteVector::size] = {};
+    std::iota(std::begin(inputBuf), std::end(inputBuf), 0);
+
+    auto vec = ByteVector::load(inputBuf);
+    vec ^= ByteVector(3);
+    vec.store(outputBuf);
+
+    for (size_t i = 0; i < ByteVector::size; i++) {
+        ASSERT_EQ(outputBuf[i], inputBuf[i] ^ 3);
+    }
+}
+
 }  // namespace unicode
 }  // namespace mongo
 #else
@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_store_access_method.h"
+
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/index/index_descriptor.h"
+
+namespace mongo {
+
+namespace dps = ::mongo::dotted_path_support;
+
+ColumnStoreAccessMethod::ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                                                 std::unique_ptr<SortedDataInterface> btree)
+    : AbstractIndexAccessMethod(columnState, std::move(btree)) {
+    uassert(5962100, "Column store indexes cannot be unique", !_descriptor->unique());
+    uassert(5962101,
+            "Column store indexes are only supported on collections with integer record ids",
+            getSortedDataInterface()->rsKeyFormat() == KeyFormat::Long);
+
+    for (auto&& elem : _descriptor->keyPattern()) {
+        _paths.push_back(elem.fieldName());
+    }
+}
+
+bool ColumnStoreAccessMethod::shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                                        const KeyStringSet& multikeyMetadataKeys,
+                                                        const MultikeyPaths& multikeyPaths) const {
+    return false;
+}
+
+BSONObj ColumnStoreAccessMethod::makeColumnPrefix(size_t pathIndex) {
+    return BSON("" << static_cast<long long>(pathIndex));
+}
+
+ColumnStoreAccessMethod::Cell ColumnStoreAccessMethod::decodeCell(const BSONObj& key) {
+    BSONObjIterator it(key);
+    Cell cell;
+    cell.pathIndex = static_cast<size_t>(it.next().numberLong());
+    cell.recordId = RecordId(it.next().numberLong());
+    cell.kind = static_cast<CellKind>(it.next().numberLong());
+    if (cell.kind == CellKind::kValue) {
+        cell.value = it.next();
+    }
+    return cell;
+}
+
+void ColumnStoreAccessMethod::doGetKeys(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const BSONObj& obj,
+                                        GetKeysContext context,
+                                        KeyStringSet* keys,
+                                        KeyStringSet* multikeyMetadataKeys,
+                                        MultikeyPaths* multikeyPaths,
+                                        boost::optional<RecordId> id) const {
+    // The RecordId leads every cell after the path position so that each column is ordered by
+    // RecordId. Keys generated without a RecordId are never inserted, so any value will do.
+    const long long recordId = id ? id->getLong() : 0;
+
+    auto keySequence = keys->extract_sequence();
+    for (size_t pathIndex = 0; pathIndex < _paths.size(); ++pathIndex) {
+        const char* remainingPath = _paths[pathIndex].c_str();
+        auto value = dps::extractElementAtPathOrArrayAlongPath(obj, remainingPath);
+
+        CellKind kind = CellKind::kValue;
+        if (value.eoo()) {
+            kind = CellKind::kMissing;
+        } else if (value.type() == BSONType::Array && *remainingPath != '\0') {
+            // An array in the middle of the path may hold any number of values for the rest of
+            // the path, which a single cell cannot represent.
+            kind = CellKind::kUncovered;
+        }
+
+        KeyString::PooledBuilder keyString(pooledBufferBuilder,
+                                           getSortedDataInterface()->getKeyStringVersion(),
+                                           getSortedDataInterface()->getOrdering());
+        keyString.appendNumberLong(static_cast<long long>(pathIndex));
+        keyString.appendNumberLong(recordId);
+        keyString.appendNumberLong(static_cast<long long>(kind));
+        if (kind == CellKind::kValue) {
+            keyString.appendBSONElement(value);
+        } else {
+            keyString.appendNull();
+        }
+        if (id) {
+            keyString.appendRecordId(*id);
+        }
+        keySequence.push_back(keyString.release());
+    }
+    keys->adopt_sequence(std::move(keySequence));
+}
+
+}  // namespace mongo
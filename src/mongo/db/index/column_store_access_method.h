@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * This is the access method for "columnstore" indexes, created with a key pattern such as
+ * { a: "columnstore", "b.c": "columnstore" }.
+ *
+ * Rather than storing one key per document, a column store index stores one cell per document for
+ * each path in its key pattern. Each cell is a KeyString of the form
+ *
+ *     { "": <path position>, "": <RecordId>, "": <CellKind>, "": <value or null> }
+ *
+ * so that the cells of one path form a column ordered by RecordId. A query that only references
+ * the indexed paths can assemble its documents by walking the columns side by side, without
+ * reading the full documents from the record store.
+ *
+ * Values reached through an array in the middle of a path are not stored; the cell is marked as
+ * uncovered and readers must fetch the document from the record store instead. Because the
+ * RecordId is part of the key, only collections with integer RecordIds are supported.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    /**
+     * Describes what a column holds for a particular document.
+     */
+    enum class CellKind : long long {
+        // The document has no value at this path.
+        kMissing = 0,
+        // The cell holds the document's value at this path.
+        kValue = 1,
+        // The path traverses an array, so the value must be read from the record store.
+        kUncovered = 2,
+    };
+
+    /**
+     * A cell decoded from an index key returned by a SortedDataInterface cursor.
+     */
+    struct Cell {
+        size_t pathIndex;
+        RecordId recordId;
+        CellKind kind;
+        // Points into the key object and is only valid for cells of kind 'kValue'.
+        BSONElement value;
+    };
+
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                            std::unique_ptr<SortedDataInterface> btree);
+
+    /**
+     * Column store indexes always generate one key per path, and store array values whole, so the
+     * index is never marked multikey.
+     */
+    bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                   const KeyStringSet& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final;
+
+    /**
+     * Returns the paths of this index, in key pattern order.
+     */
+    const std::vector<std::string>& getPaths() const {
+        return _paths;
+    }
+
+    /**
+     * Returns the key prefix which positions a cursor at the start of the column for the path at
+     * 'pathIndex'.
+     */
+    static BSONObj makeColumnPrefix(size_t pathIndex);
+
+    /**
+     * Decodes a key returned by a cursor over a column store index.
+     */
+    static Cell decodeCell(const BSONObj& key);
+
+private:
+    void doGetKeys(OperationContext* opCtx,
+                   const CollectionPtr& collection,
+                   SharedBufferFragmentBuilder& pooledBufferBuilder,
+                   const BSONObj& obj,
+                   GetKeysContext context,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    std::vector<std::string> _paths;
+};
+
+}  // namespace mongo
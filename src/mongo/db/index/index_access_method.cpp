@@ -36,6 +36,7 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/error_codes.h"
 #include "mongo/base/status.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -216,6 +217,27 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertSortedKeys(OperationContext* opCtx,
+                                                   const std::vector<KeyString::Value>& keys,
+                                                   const std::vector<Timestamp>& timestamps,
+                                                   const InsertDeleteOptions& options,
+                                                   int64_t* numInserted) {
+    if (numInserted) {
+        *numInserted = 0;
+    }
+    // Without an 'onDuplicateKey' handler, retrying a duplicate key with dupsAllowed as
+    // insertKeys() does is the same as allowing duplicates in the first place.
+    const bool dupsAllowed = !_descriptor->unique() || options.dupsAllowed;
+    Status status = _newInterface->insertBatch(opCtx, keys, timestamps, dupsAllowed);
+    if (!status.isOK()) {
+        return status;
+    }
+    if (numInserted) {
+        *numInserted = keys.size();
+    }
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const KeyString::Value& keyString,
                                              const RecordId& loc,
@@ -514,9 +536,13 @@ public:
 
     Sorter::PersistedState persistDataForShutdown() final;
 
+    void mergeFrom(std::unique_ptr<BulkBuilder> other) final;
+
 private:
     void _insertMultikeyMetadataKeysIntoSorter();
 
+    void _mergeMultikeyPaths(const MultikeyPaths& multikeyPaths);
+
     Sorter* _makeSorter(
         size_t maxMemoryUsageBytes,
         StringData dbName,
@@ -526,9 +552,15 @@ private:
     Sorter::Settings _makeSorterSettings() const;
 
     const IndexCatalogEntry* _indexCatalogEntry;
+    const size_t _maxMemoryUsageBytes;
+    const std::string _dbName;
     std::unique_ptr<Sorter> _sorter;
     int64_t _keysInserted = 0;
 
+    // BulkBuilders whose keys were handed to this one by mergeFrom(). Their sorted keys are merged
+    // with the keys of '_sorter' by done().
+    std::vector<std::unique_ptr<BulkBuilderImpl>> _mergedBuilders;
+
     // Set to true if any document added to the BulkBuilder causes the index to become multikey.
     bool _isMultiKey = false;
 
@@ -555,13 +587,18 @@ std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initi
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(const IndexCatalogEntry* index,
                                                             size_t maxMemoryUsageBytes,
                                                             StringData dbName)
-    : _indexCatalogEntry(index), _sorter(_makeSorter(maxMemoryUsageBytes, dbName)) {}
+    : _indexCatalogEntry(index),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _dbName(dbName.toString()),
+      _sorter(_makeSorter(maxMemoryUsageBytes, dbName)) {}
 
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(const IndexCatalogEntry* index,
                                                             size_t maxMemoryUsageBytes,
                                                             const IndexStateInfo& stateInfo,
                                                             StringData dbName)
     : _indexCatalogEntry(index),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _dbName(dbName.toString()),
       _sorter(
           _makeSorter(maxMemoryUsageBytes, dbName, stateInfo.getFileName(), stateInfo.getRanges())),
       _keysInserted(stateInfo.getNumKeys().value_or(0)),
@@ -609,18 +646,7 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
-                _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
-            }
-        }
-    }
+    _mergeMultikeyPaths(*multikeyPaths);
 
     for (const auto& keyString : *keys) {
         _sorter->add(keyString, mongo::NullValue());
@@ -642,10 +668,56 @@ bool AbstractIndexAccessMethod::BulkBuilderImpl::isMultikey() const {
     return _isMultiKey;
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::_mergeMultikeyPaths(
+    const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (_indexMultikeyPaths.empty()) {
+        _indexMultikeyPaths = multikeyPaths;
+        return;
+    }
+
+    invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
+                                      multikeyPaths[i].begin(),
+                                      multikeyPaths[i].end());
+    }
+}
+
 IndexAccessMethod::BulkBuilder::Sorter::Iterator*
 AbstractIndexAccessMethod::BulkBuilderImpl::done() {
     _insertMultikeyMetadataKeysIntoSorter();
-    return _sorter->done();
+    if (_mergedBuilders.empty()) {
+        return _sorter->done();
+    }
+
+    std::vector<std::shared_ptr<Sorter::Iterator>> iterators;
+    iterators.emplace_back(_sorter->done());
+    for (auto& builder : _mergedBuilders) {
+        iterators.emplace_back(builder->_sorter->done());
+    }
+    return Sorter::Iterator::merge(
+        iterators, makeSortOptions(_maxMemoryUsageBytes, _dbName), BtreeExternalSortComparison());
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::mergeFrom(std::unique_ptr<BulkBuilder> other) {
+    std::unique_ptr<BulkBuilderImpl> otherImpl(checked_cast<BulkBuilderImpl*>(other.release()));
+    invariant(otherImpl->_indexCatalogEntry == _indexCatalogEntry);
+
+    // Multikey metadata keys are only added to the sorter by done(). Take them over here so that a
+    // key generated by several builders is only inserted once.
+    for (auto& keyString : otherImpl->_multikeyMetadataKeys) {
+        _multikeyMetadataKeys.insert(keyString);
+    }
+    otherImpl->_multikeyMetadataKeys.clear();
+
+    _keysInserted += otherImpl->_keysInserted;
+    _isMultiKey = _isMultiKey || otherImpl->_isMultiKey;
+    _mergeMultikeyPaths(otherImpl->_indexMultikeyPaths);
+    _mergedBuilders.push_back(std::move(otherImpl));
 }
 
 int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
@@ -654,6 +726,17 @@ int64_t AbstractIndexAccessMethod::BulkBuilderImpl::getKeysInserted() const {
 
 AbstractIndexAccessMethod::BulkBuilder::Sorter::PersistedState
 AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForShutdown() {
+    // The persisted state describes a single sorter, so move the keys of any merged builders into
+    // '_sorter' first.
+    for (auto& builder : _mergedBuilders) {
+        std::unique_ptr<Sorter::Iterator> it(builder->_sorter->done());
+        while (it->more()) {
+            auto data = it->next();
+            _sorter->add(data.first, data.second);
+        }
+    }
+    _mergedBuilders.clear();
+
     _insertMultikeyMetadataKeysIntoSorter();
     return _sorter->persistDataForShutdown();
 }
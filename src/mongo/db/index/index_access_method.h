@@ -123,6 +123,20 @@ public:
                               KeyHandlerFn&& onDuplicateKey,
                               int64_t* numInserted) = 0;
 
+    /**
+     * Inserts 'keys', which may have been generated for several documents, into the index with a
+     * single pass over it. 'keys' must be in ascending order. If 'timestamps' is not empty,
+     * 'timestamps[i]' is the timestamp at which 'keys[i]' is written. Does not attempt to determine
+     * whether the insertion of these keys should cause the index to become multikey. The
+     * 'numInserted' output parameter, if non-nullptr, will be set to the number of keys inserted,
+     * or to zero in the case of a non-OK return Status.
+     */
+    virtual Status insertSortedKeys(OperationContext* opCtx,
+                                    const std::vector<KeyString::Value>& keys,
+                                    const std::vector<Timestamp>& timestamps,
+                                    const InsertDeleteOptions& options,
+                                    int64_t* numInserted) = 0;
+
     /**
      * Analogous to insertKeys above, but remove the keys instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the provided keys.
@@ -268,6 +282,16 @@ public:
          * state of the underlying Sorter.
          */
         virtual Sorter::PersistedState persistDataForShutdown() = 0;
+
+        /**
+         * Takes over the keys inserted into 'other', which must have been started for the same
+         * index and must not be used afterwards. Its keys are merged with the keys of this
+         * BulkBuilder by done() and count towards getKeysInserted(). This allows several threads
+         * to generate keys for one index into their own BulkBuilders.
+         *
+         * Once done() has consumed the merged keys, persistDataForShutdown() cannot save them.
+         */
+        virtual void mergeFrom(std::unique_ptr<BulkBuilder> other) = 0;
     };
 
     /**
@@ -489,6 +513,12 @@ public:
                                             KeyHandlerFn&& onDuplicateKey,
                                             int64_t* numInserted) final;
 
+    Status insertSortedKeys(OperationContext* opCtx,
+                            const std::vector<KeyString::Value>& keys,
+                            const std::vector<Timestamp>& timestamps,
+                            const InsertDeleteOptions& options,
+                            int64_t* numInserted) final;
+
     Status removeKeys(OperationContext* opCtx,
                       const KeyStringSet& keys,
                       const RecordId& loc,
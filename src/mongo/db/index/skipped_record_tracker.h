@@ -33,6 +33,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -88,6 +89,10 @@ private:
     // kept along with it with a call to finalizeTemporaryTable().
     std::unique_ptr<TemporaryRecordStore> _skippedRecordsTable;
 
+    // Serializes the lazy creation of '_skippedRecordsTable' when several threads generate keys
+    // for the same index.
+    Mutex _tableCreationMutex = MONGO_MAKE_LATCH("SkippedRecordTracker::_tableCreationMutex");
+
     AtomicWord<std::uint32_t> _skippedRecordCounter{0};
 };
 
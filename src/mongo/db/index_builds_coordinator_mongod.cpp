@@ -338,6 +338,10 @@ IndexBuildsCoordinatorMongod::_startIndexBuild(OperationContext* opCtx,
 
         auto opCtx = Client::getCurrent()->makeOperationContext();
 
+        // An index build scans the whole collection and may run for hours, so it should not
+        // compete on equal terms with client operations for tickets throughout.
+        opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+
         // Load the external client's attributes into this thread's client for auditing.
         auto authSession = AuthorizationSession::get(Client::getCurrent());
         if (authSession) {
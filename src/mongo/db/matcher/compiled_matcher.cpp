@@ -0,0 +1,217 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_matcher.h"
+
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Collects the children of 'expr', flattening nested $and nodes.
+ */
+void collectConjuncts(const MatchExpression* expr, std::vector<const MatchExpression*>* out) {
+    if (expr->matchType() != MatchExpression::AND) {
+        out->push_back(expr);
+        return;
+    }
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        collectConjuncts(expr->getChild(i), out);
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<CompiledMatcher> CompiledMatcher::compile(const MatchExpression* expr) {
+    if (!expr || expr->matchType() != MatchExpression::AND ||
+        !internalQueryEnableCompiledMatcher.load()) {
+        return nullptr;
+    }
+
+    std::vector<const MatchExpression*> conjuncts;
+    collectConjuncts(expr, &conjuncts);
+
+    std::unique_ptr<CompiledMatcher> compiled(new CompiledMatcher());
+    compiled->_nodes.emplace_back();
+    for (auto&& conjunct : conjuncts) {
+        auto pathExpr = dynamic_cast<const PathMatchExpression*>(conjunct);
+        if (pathExpr && pathExpr->fieldRef()->numParts() > 0) {
+            compiled->_addPathPredicate(pathExpr);
+        } else {
+            compiled->_residual.push_back(conjunct);
+        }
+    }
+
+    // With fewer than two path predicates there is nothing to share between them.
+    if (compiled->_numPathPredicates < 2) {
+        return nullptr;
+    }
+    return compiled;
+}
+
+void CompiledMatcher::_addPathPredicate(const PathMatchExpression* expr) {
+    const FieldRef* path = expr->fieldRef();
+    size_t nodeIdx = 0;
+    for (size_t i = 0; i < path->numParts(); ++i) {
+        auto part = path->getPart(i);
+        size_t childIdx = _findChild(_nodes[nodeIdx], part);
+        if (childIdx == 0) {
+            childIdx = _nodes.size();
+            _nodes.emplace_back();
+
+            auto& node = _nodes[nodeIdx];
+            node.children.emplace_back(part.toString(), childIdx);
+            if (node.children.size() > kMaxChildrenForLinearLookup) {
+                if (node.childIndex.empty()) {
+                    for (auto&& [name, idx] : node.children) {
+                        node.childIndex.emplace(name, idx);
+                    }
+                } else {
+                    node.childIndex.emplace(part.toString(), childIdx);
+                }
+            }
+        }
+        nodeIdx = childIdx;
+    }
+    _nodes[nodeIdx].predicates.push_back(expr);
+    ++_numPathPredicates;
+}
+
+size_t CompiledMatcher::_findChild(const Node& node, StringData fieldName) const {
+    if (!node.childIndex.empty()) {
+        auto it = node.childIndex.find(fieldName);
+        return it == node.childIndex.end() ? 0 : it->second;
+    }
+    for (auto&& [name, idx] : node.children) {
+        if (fieldName == name) {
+            return idx;
+        }
+    }
+    return 0;
+}
+
+bool CompiledMatcher::matches(const BSONObj& doc, MatchDetails* details) const {
+    // Tracks which nodes have been reached by the walk, so that only the first of several fields
+    // with the same name is considered, as BSONObj::getField() does.
+    std::vector<char> reached(_nodes.size(), 0);
+
+    if (!_walk(0, doc, doc, &reached, details)) {
+        return false;
+    }
+
+    // Predicates whose path was not found are evaluated as if their path iterator produced a
+    // single EOO element.
+    for (size_t i = 1; i < _nodes.size(); ++i) {
+        if (reached[i]) {
+            continue;
+        }
+        for (auto&& pred : _nodes[i].predicates) {
+            if (!pred->matchesSingleElement(BSONElement(), details)) {
+                return false;
+            }
+        }
+    }
+
+    for (auto&& expr : _residual) {
+        if (!expr->matchesBSON(doc, details)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatcher::_walk(size_t nodeIdx,
+                            const BSONObj& obj,
+                            const BSONObj& doc,
+                            std::vector<char>* reached,
+                            MatchDetails* details) const {
+    const Node& node = _nodes[nodeIdx];
+    size_t remaining = node.children.size();
+
+    BSONObjIterator it(obj);
+    while (remaining > 0 && it.more()) {
+        BSONElement elem = it.next();
+        size_t childIdx = _findChild(node, elem.fieldNameStringData());
+        if (childIdx == 0 || (*reached)[childIdx]) {
+            continue;
+        }
+        --remaining;
+
+        if (elem.type() == BSONType::Array) {
+            // Leave implicit array traversal to the path iterators of the affected predicates.
+            if (!_matchSubtreeAgainstDocument(childIdx, doc, reached, details)) {
+                return false;
+            }
+            continue;
+        }
+
+        (*reached)[childIdx] = 1;
+        const Node& child = _nodes[childIdx];
+        for (auto&& pred : child.predicates) {
+            if (!pred->matchesSingleElement(elem, details)) {
+                return false;
+            }
+        }
+
+        // If a non-object value is found in the middle of a path, the rest of the path is missing.
+        if (elem.type() == BSONType::Object && !child.children.empty()) {
+            if (!_walk(childIdx, elem.Obj(), doc, reached, details)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CompiledMatcher::_matchSubtreeAgainstDocument(size_t nodeIdx,
+                                                   const BSONObj& doc,
+                                                   std::vector<char>* reached,
+                                                   MatchDetails* details) const {
+    (*reached)[nodeIdx] = 1;
+    const Node& node = _nodes[nodeIdx];
+    for (auto&& pred : node.predicates) {
+        if (!pred->matchesBSON(doc, details)) {
+            return false;
+        }
+    }
+    for (auto&& [name, childIdx] : node.children) {
+        if (!_matchSubtreeAgainstDocument(childIdx, doc, reached, details)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
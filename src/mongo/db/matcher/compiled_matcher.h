@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/match_details.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class PathMatchExpression;
+
+/**
+ * A CompiledMatcher evaluates a conjunction of path predicates, such as
+ * {"a.b": 1, "a.c": {$gt: 5}, d: "x"}, with a single traversal of each document.
+ *
+ * Evaluating an AndMatchExpression directly makes each of its children look up its own path from
+ * the root of the document. Instead, the paths of all the path predicates of the conjunction are
+ * compiled into a trie, and the document is walked once, level by level, descending only into
+ * subdocuments which some predicate path passes through. Each predicate is evaluated as soon as
+ * the element at the end of its path is reached, and the walk stops at the first predicate which
+ * fails.
+ *
+ * Implicit array traversal is not handled by the walk. If an array is found at or above the end of
+ * a predicate path, every predicate under that point of the trie is instead evaluated with
+ * MatchExpression::matchesBSON() against the whole document, so the results are always the same
+ * as those of the original expression. Predicates whose path is not present in the document are
+ * evaluated against EOO, as the path iterator would do. Children of the conjunction which are not
+ * path predicates, such as $or or $expr, are evaluated after the walk.
+ *
+ * The expression which a CompiledMatcher is compiled from must outlive it and must not be
+ * modified during its lifetime.
+ */
+class CompiledMatcher {
+    CompiledMatcher(const CompiledMatcher&) = delete;
+    CompiledMatcher& operator=(const CompiledMatcher&) = delete;
+
+public:
+    /**
+     * Returns a CompiledMatcher for 'expr', or nullptr if 'expr' is not a conjunction with at
+     * least two path predicates, or if compiled matching is disabled by
+     * 'internalQueryEnableCompiledMatcher'.
+     */
+    static std::unique_ptr<CompiledMatcher> compile(const MatchExpression* expr);
+
+    /**
+     * Returns true if 'doc' satisfies the expression this matcher was compiled from.
+     */
+    bool matches(const BSONObj& doc, MatchDetails* details = nullptr) const;
+
+    /**
+     * Returns the number of path predicates evaluated by the document walk.
+     */
+    size_t numPathPredicates() const {
+        return _numPathPredicates;
+    }
+
+private:
+    /**
+     * A node of the path trie. Node 0 is the root of the trie and corresponds to the document
+     * itself.
+     */
+    struct Node {
+        // Predicates whose path ends at this node.
+        std::vector<const PathMatchExpression*> predicates;
+
+        // Child nodes, as pairs of field name and node index. Looked up by a linear scan when
+        // there are only a few children, or through 'childIndex' otherwise.
+        std::vector<std::pair<std::string, size_t>> children;
+        StringMap<size_t> childIndex;
+    };
+
+    // The number of children of a node above which they are looked up by hash.
+    static constexpr size_t kMaxChildrenForLinearLookup = 8;
+
+    CompiledMatcher() = default;
+
+    void _addPathPredicate(const PathMatchExpression* expr);
+
+    /**
+     * Returns the index of the child of 'node' named 'fieldName', or 0 if there is no such child.
+     */
+    size_t _findChild(const Node& node, StringData fieldName) const;
+
+    bool _walk(size_t nodeIdx,
+               const BSONObj& obj,
+               const BSONObj& doc,
+               std::vector<char>* reached,
+               MatchDetails* details) const;
+
+    bool _matchSubtreeAgainstDocument(size_t nodeIdx,
+                                      const BSONObj& doc,
+                                      std::vector<char>* reached,
+                                      MatchDetails* details) const;
+
+    std::vector<Node> _nodes;
+
+    // Children of the conjunction which are not path predicates.
+    std::vector<const MatchExpression*> _residual;
+
+    size_t _numPathPredicates = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/compiled_matcher.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto result = MatchExpressionParser::parse(filter, expCtx);
+    ASSERT_OK(result.getStatus());
+    return std::move(result.getValue());
+}
+
+/**
+ * Asserts that the compiled form of 'filter' agrees with the MatchExpression for every document
+ * in 'docs', and that it matches exactly 'expectedMatches' of them.
+ */
+void assertCompiledMatchesAgree(const BSONObj& filter,
+                                const std::vector<BSONObj>& docs,
+                                size_t expectedMatches) {
+    auto expr = parse(filter);
+    auto compiled = CompiledMatcher::compile(expr.get());
+    ASSERT(compiled) << filter;
+
+    size_t numMatches = 0;
+    for (auto&& doc : docs) {
+        bool expected = expr->matchesBSON(doc);
+        ASSERT_EQ(expected, compiled->matches(doc)) << "filter: " << filter << " doc: " << doc;
+        numMatches += expected;
+    }
+    ASSERT_EQ(expectedMatches, numMatches) << filter;
+}
+
+TEST(CompiledMatcherTest, DoesNotCompileSinglePredicate) {
+    auto expr = parse(fromjson("{a: 1}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+}
+
+TEST(CompiledMatcherTest, DoesNotCompileOr) {
+    auto expr = parse(fromjson("{$or: [{a: 1}, {b: 1}]}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+}
+
+TEST(CompiledMatcherTest, DoesNotCompileWhenDisabled) {
+    internalQueryEnableCompiledMatcher.store(false);
+    ON_BLOCK_EXIT([] { internalQueryEnableCompiledMatcher.store(true); });
+    auto expr = parse(fromjson("{a: 1, b: 1}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+}
+
+TEST(CompiledMatcherTest, CountsPathPredicatesOfNestedConjunctions) {
+    auto expr =
+        parse(fromjson("{'a.b': 1, 'a.c': {$gt: 5, $lt: 10}, d: 'x', $or: [{e: 1}, {f: 1}]}"));
+    auto compiled = CompiledMatcher::compile(expr.get());
+    ASSERT(compiled);
+    ASSERT_EQ(4U, compiled->numPathPredicates());
+}
+
+TEST(CompiledMatcherTest, MatchesScalarsAndSubdocuments) {
+    assertCompiledMatchesAgree(fromjson("{'a.b': 1, 'a.c': {$gt: 5}, d: 'x'}"),
+                               {fromjson("{a: {b: 1, c: 6}, d: 'x'}"),
+                                fromjson("{d: 'x', a: {c: 6, b: 1}}"),
+                                fromjson("{a: {b: 1, c: 5}, d: 'x'}"),
+                                fromjson("{a: {b: 2, c: 6}, d: 'x'}"),
+                                fromjson("{a: {b: 1, c: 6}, d: 'y'}"),
+                                fromjson("{a: {b: 1, c: 6}}"),
+                                fromjson("{a: 1, d: 'x'}"),
+                                fromjson("{}")},
+                               2);
+}
+
+TEST(CompiledMatcherTest, MatchesPredicatesOnMissingFields) {
+    assertCompiledMatchesAgree(fromjson("{'a.b': null, c: {$exists: false}, d: {$ne: 1}}"),
+                               {fromjson("{}"),
+                                fromjson("{a: 1}"),
+                                fromjson("{a: {b: null}}"),
+                                fromjson("{a: {b: 1}}"),
+                                fromjson("{c: 1}"),
+                                fromjson("{d: 1}"),
+                                fromjson("{d: 2, a: {}}")},
+                               4);
+}
+
+TEST(CompiledMatcherTest, MatchesPredicatesOnPathPrefixes) {
+    assertCompiledMatchesAgree(
+        fromjson("{a: {$type: 'object'}, 'a.b': 1, 'a.b.c': {$exists: false}}"),
+        {fromjson("{a: {b: 1}}"),
+         fromjson("{a: {b: {c: 1}}}"),
+         fromjson("{a: 1}"),
+         fromjson("{a: {b: 2}}")},
+        1);
+}
+
+TEST(CompiledMatcherTest, FallsBackForArraysAlongPaths) {
+    assertCompiledMatchesAgree(fromjson("{'a.b': 1, 'a.c': {$gt: 5}, d: 'x'}"),
+                               {fromjson("{a: [{b: 1}, {c: 6}], d: 'x'}"),
+                                fromjson("{a: {b: [2, 1], c: [6]}, d: ['y', 'x']}"),
+                                fromjson("{a: [{b: 2}, {c: 6}], d: 'x'}"),
+                                fromjson("{a: {b: [2, 3], c: 6}, d: 'x'}"),
+                                fromjson("{a: [1, 2], d: 'x'}")},
+                               2);
+}
+
+TEST(CompiledMatcherTest, FallsBackForArrayIndexPaths) {
+    assertCompiledMatchesAgree(fromjson("{'a.0': 1, 'a.1.b': 2}"),
+                               {fromjson("{a: [1, {b: 2}]}"),
+                                fromjson("{a: {'0': 1, '1': {b: 2}}}"),
+                                fromjson("{a: [1, {b: 3}]}"),
+                                fromjson("{a: {'0': 1}}")},
+                               2);
+}
+
+TEST(CompiledMatcherTest, UsesFirstOfDuplicateFields) {
+    assertCompiledMatchesAgree(
+        fromjson("{a: 1, b: 1}"), {BSON("a" << 1 << "a" << 2 << "b" << 1)}, 1);
+    assertCompiledMatchesAgree(
+        fromjson("{a: 2, b: 1}"), {BSON("a" << 1 << "a" << 2 << "b" << 1)}, 0);
+}
+
+TEST(CompiledMatcherTest, EvaluatesResidualPredicates) {
+    assertCompiledMatchesAgree(fromjson("{a: 1, b: 2, $or: [{c: 1}, {d: 1}]}"),
+                               {fromjson("{a: 1, b: 2, c: 1}"),
+                                fromjson("{a: 1, b: 2, d: 1}"),
+                                fromjson("{a: 1, b: 2}"),
+                                fromjson("{a: 1, b: 3, c: 1}")},
+                               2);
+}
+
+TEST(CompiledMatcherTest, MatchesWideDocumentsWithManyPredicates) {
+    BSONObjBuilder filter;
+    BSONObjBuilder matchingDoc;
+    BSONObjBuilder nonMatchingDoc;
+    for (int i = 0; i < 32; ++i) {
+        std::string field = str::stream() << "f" << i;
+        filter.append(field, i);
+        matchingDoc.append(field, i);
+        nonMatchingDoc.append(field, i == 31 ? 0 : i);
+    }
+    assertCompiledMatchesAgree(filter.obj(), {matchingDoc.obj(), nonMatchingDoc.obj()}, 1);
+}
+
+}  // namespace
+}  // namespace mongo
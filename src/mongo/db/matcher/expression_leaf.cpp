@@ -44,6 +44,8 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/regex_cache.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/represent_as.h"
 #include "mongo/util/str.h"
@@ -221,7 +223,8 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
       _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags))) {
+      _re(RegexCache::get().getOrCompile(
+          _regex, regex_util::flagsToPcreOptions(_flags).all_options())) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -248,10 +251,9 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
         case String:
         case Symbol: {
             // String values stored in documents can contain embedded NUL bytes. We construct a
-            // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
-            // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
-            return _re->PartialMatch(data);
+            // StringData instance using the full length of the string to avoid truncating the
+            // input early.
+            return _re->partialMatch(StringData(e.valuestr(), e.valuestrsize() - 1));
         }
         case RegEx:
             return _regex == e.regex() && _flags == e.regexFlags();
@@ -415,6 +417,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_equalityHashSet = _equalityHashSet;
     next->_originalEqualityVector = _originalEqualityVector;
     next->_equalityStorage = _equalityStorage;
     for (auto&& regex : _regexes) {
@@ -426,6 +429,9 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_equalityHashSet) {
+        return _equalityHashSet->set.find(e) != _equalityHashSet->set.end();
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -522,23 +528,16 @@ bool InMatchExpression::equivalent(const MatchExpression* other) const {
 }
 
 void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
+    // The equalities are already sorted, deduped and hashed with respect to this collator.
+    if (collator == _collator) {
+        return;
+    }
+
     _collator = collator;
     _eltCmp = BSONElementComparator(BSONElementComparator::FieldNamesMode::kIgnore, _collator);
 
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
     // We need to re-compute '_equalitySet', since our set comparator has changed.
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    _updateEqualitySet();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -558,7 +557,12 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
     }
 
     _originalEqualityVector = std::move(equalities);
+    _updateEqualitySet();
 
+    return Status::OK();
+}
+
+void InMatchExpression::_updateEqualitySet() {
     if (!std::is_sorted(_originalEqualityVector.begin(),
                         _originalEqualityVector.end(),
                         _eltCmp.makeLessThan())) {
@@ -573,7 +577,17 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
 
-    return Status::OK();
+    // For large lists, hashing each candidate once is cheaper than the log(n) BSON comparisons of
+    // a binary search. The hash is consistent with the comparator, so that for instance NumberInt 1
+    // and NumberDouble 1.0 hash alike, and strings hash by their collation comparison key.
+    _equalityHashSet.reset();
+    auto minSizeForHashSet = internalQueryMinInListSizeForHashSet.load();
+    if (minSizeForHashSet > 0 && _equalitySet.size() >= static_cast<size_t>(minSizeForHashSet)) {
+        auto hashSet = std::make_shared<EqualityHashSet>(_collator);
+        hashSet->set.reserve(_equalitySet.size());
+        hashSet->set.insert(_equalitySet.begin(), _equalitySet.end());
+        _equalityHashSet = std::move(hashSet);
+    }
 }
 
 void InMatchExpression::setBackingBSON(BSONObj equalityStorage) {
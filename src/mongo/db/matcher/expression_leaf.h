@@ -48,6 +48,7 @@ class RE;
 namespace mongo {
 
 class CollatorInterface;
+class CompiledRegex;
 
 class LeafMatchExpression : public PathMatchExpression {
 public:
@@ -151,6 +152,15 @@ public:
         _rhs = elem;
     }
 
+    /**
+     * Replaces the RHS element of this expression with 'elem', which must point into
+     * 'backingBSON'. This expression shares ownership of 'backingBSON' if it is owned.
+     */
+    void setData(BSONObj backingBSON, BSONElement elem) {
+        _backingBSON = std::move(backingBSON);
+        _rhs = elem;
+    }
+
     const CollatorInterface* getCollator() const {
         return _collator;
     }
@@ -466,7 +476,9 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+
+    // Shared with other expressions using the same pattern and flags via the RegexCache.
+    std::shared_ptr<const CompiledRegex> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -623,6 +635,25 @@ private:
     // Collator used to construct '_eltCmp';
     const CollatorInterface* _collator = nullptr;
 
+    /**
+     * A hash set over the distinct equalities, with hashing and equality defined by a comparator
+     * which owns a copy of the collator pointer, so that the set may be shared between clones.
+     */
+    struct EqualityHashSet {
+        explicit EqualityHashSet(const CollatorInterface* collator)
+            : eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+              set(eltCmp.makeBSONEltUnorderedSet()) {}
+
+        BSONElementComparator eltCmp;
+        BSONEltUnorderedSet set;
+    };
+
+    /**
+     * Re-computes '_equalitySet' and '_equalityHashSet' from '_originalEqualityVector' using the
+     * current comparator.
+     */
+    void _updateEqualitySet();
+
     // Comparator used to compare elements. By default, simple binary comparison will be used.
     BSONElementComparator _eltCmp;
 
@@ -636,11 +667,14 @@ private:
     // Deduped set of equality elements associated with this expression. Kept in sorted order to
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
-    // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
+    // doesn't pay for itself in the common case where the list is short.
     std::vector<BSONElement> _equalitySet;
 
+    // Hash set over '_equalitySet', built only when the number of distinct equalities is at least
+    // 'internalQueryMinInListSizeForHashSet'. It is immutable once built, and clones with the same
+    // collator share it rather than re-hashing the equalities.
+    std::shared_ptr<const EqualityHashSet> _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 
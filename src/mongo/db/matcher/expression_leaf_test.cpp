@@ -1372,6 +1372,81 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeListMatchesNumericallyEqualValuesOfOtherTypes) {
+    BSONArrayBuilder arrBob;
+    for (int i = 0; i < 500; ++i) {
+        arrBob.append(i * 2);
+    }
+    BSONArray operand = arrBob.arr();
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elem : operand) {
+        equalities.push_back(elem);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 4)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 4LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 4.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << Decimal128(4))["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 998)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 4.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "4")["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 1000)["a"]));
+}
+
+TEST(InMatchExpression, LargeListStringMatchingRespectsCollation) {
+    BSONArrayBuilder arrBob;
+    for (int i = 0; i < 500; ++i) {
+        arrBob.append("STRING" + std::to_string(i));
+    }
+    BSONArray operand = arrBob.arr();
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("");
+    in.setCollator(&collator);
+    std::vector<BSONElement> equalities;
+    for (auto&& elem : operand) {
+        equalities.push_back(elem);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "string42")["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "String499")["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "string500")["a"]));
+
+    // Removing the collator falls back to binary comparison of the strings.
+    in.setCollator(nullptr);
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "string42")["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a"
+                                        << "STRING42")["a"]));
+}
+
+TEST(InMatchExpression, CloneOfLargeListOutlivesOriginal) {
+    BSONArrayBuilder arrBob;
+    for (int i = 0; i < 500; ++i) {
+        arrBob.append(i);
+    }
+    BSONArray operand = arrBob.arr();
+    std::unique_ptr<MatchExpression> clone;
+    {
+        InMatchExpression in("a");
+        std::vector<BSONElement> equalities;
+        for (auto&& elem : operand) {
+            equalities.push_back(elem);
+        }
+        ASSERT_OK(in.setEqualities(std::move(equalities)));
+        clone = in.shallowClone();
+    }
+    ASSERT(clone->matchesBSON(BSON("a" << 250)));
+    ASSERT(!clone->matchesBSON(BSON("a" << 500)));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
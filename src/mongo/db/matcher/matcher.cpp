@@ -47,12 +47,16 @@ Matcher::Matcher(const BSONObj& pattern,
     : _pattern(pattern) {
     _expression = uassertStatusOK(
         MatchExpressionParser::parse(pattern, expCtx, extensionsCallback, allowedFeatures));
+    _compiled = CompiledMatcher::compile(_expression.get());
 }
 
 bool Matcher::matches(const BSONObj& doc, MatchDetails* details) const {
     if (!_expression)
         return true;
 
+    if (_compiled)
+        return _compiled->matches(doc, details);
+
     return _expression->matchesBSON(doc, details);
 }
 
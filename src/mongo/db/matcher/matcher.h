@@ -32,6 +32,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/compiled_matcher.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -81,6 +82,9 @@ private:
     BSONObj _pattern;
 
     std::unique_ptr<MatchExpression> _expression;
+
+    // Single-pass form of '_expression', if it is a conjunction of several path predicates.
+    std::unique_ptr<CompiledMatcher> _compiled;
 };
 
 }  // namespace mongo
@@ -106,6 +106,7 @@
 #include "mongo/db/op_observer_impl.h"
 #include "mongo/db/op_observer_registry.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
@@ -153,6 +154,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_entry_point_mongod.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/db/startup_phase_timings.h"
 #include "mongo/db/startup_recovery.h"
 #include "mongo/db/startup_warnings_mongod.h"
 #include "mongo/db/stats/counters.h"
@@ -212,6 +214,7 @@
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/text.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/version.h"
 #include "mongo/watchdog/watchdog_mongod.h"
 
@@ -336,6 +339,7 @@ void registerPrimaryOnlyServices(ServiceContext* serviceContext) {
 MONGO_FAIL_POINT_DEFINE(shutdownAtStartup);
 
 ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
+    Timer startupTimer;
     Client::initThread("initandlisten");
 
     serviceContext->setFastClockSource(FastClockSourceFactory::create(Milliseconds(10)));
@@ -405,7 +409,10 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
     // initialized, a noop recovery unit is used until the initialization is complete.
     auto startupOpCtx = serviceContext->makeOperationContext(&cc());
 
-    auto lastShutdownState = initializeStorageEngine(startupOpCtx.get(), StorageEngineInitFlags{});
+    auto lastShutdownState = [&] {
+        StartupPhaseTimings::ScopedPhase phase(serviceContext, "initializeStorageEngine");
+        return initializeStorageEngine(startupOpCtx.get(), StorageEngineInitFlags{});
+    }();
     StorageControl::startStorageControls(serviceContext);
 
 #ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
@@ -481,6 +488,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
     }
 
     try {
+        StartupPhaseTimings::ScopedPhase phase(serviceContext, "repairAndRecoverDatabases");
         startup_recovery::repairAndRecoverDatabases(startupOpCtx.get(), lastShutdownState);
     } catch (const ExceptionFor<ErrorCodes::MustDowngrade>& error) {
         LOGV2_FATAL_OPTIONS(
@@ -642,7 +650,10 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         uassert(ErrorCodes::BadValue,
                 str::stream() << "Cannot use queryableBackupMode in a replica set",
                 !replCoord->isReplEnabled());
-        replCoord->startup(startupOpCtx.get(), lastShutdownState);
+        {
+            StartupPhaseTimings::ScopedPhase phase(serviceContext, "startReplication");
+            replCoord->startup(startupOpCtx.get(), lastShutdownState);
+        }
     }
 
     startMongoDFTDC();
@@ -692,7 +703,10 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
             ReplicaSetNodeProcessInterface::getReplicaSetNodeExecutor(serviceContext)->startup();
         }
 
-        replCoord->startup(startupOpCtx.get(), lastShutdownState);
+        {
+            StartupPhaseTimings::ScopedPhase phase(serviceContext, "startReplication");
+            replCoord->startup(startupOpCtx.get(), lastShutdownState);
+        }
         if (getReplSetMemberInStandaloneMode(serviceContext)) {
             LOGV2_WARNING_OPTIONS(
                 20547,
@@ -782,6 +796,8 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
     }
 
     serviceContext->notifyStartupComplete();
+    StartupPhaseTimings::get(serviceContext)
+        ->onStartupComplete(Milliseconds(startupTimer.millis()));
 
 #ifndef _WIN32
     mongo::signalForkSuccess();
@@ -1345,6 +1361,11 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         }
     }
 
+    // Wait for the workers of any write split across the parallel writer pool, whose operations
+    // were killed along with the client operations which started them.
+    LOGV2_OPTIONS(5962405, {LogComponent::kWrite}, "Shutting down the parallel writer pool");
+    write_ops_exec::shutdownParallelWriters(serviceContext);
+
     LOGV2(4784925, "Shutting down free monitoring");
     stopFreeMonitoring();
 
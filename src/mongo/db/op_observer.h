@@ -350,6 +350,18 @@ public:
                                const NamespaceString& collectionName,
                                OptionalCollectionUUID uuid) = 0;
 
+    /**
+     * Called after all records with ids in the inclusive range ['minRecordId', 'maxRecordId'] have
+     * been removed from the collection in a single storage-level truncate, in place of one
+     * onDelete() call per record. 'numRecordsDeleted' is the number of records removed.
+     */
+    virtual void onTruncateRange(OperationContext* opCtx,
+                                 const NamespaceString& collectionName,
+                                 OptionalCollectionUUID uuid,
+                                 const RecordId& minRecordId,
+                                 const RecordId& maxRecordId,
+                                 int64_t numRecordsDeleted) = 0;
+
     /**
      * The onUnpreparedTransactionCommit method is called on the commit of an unprepared
      * transaction, before the RecoveryUnit onCommit() is called.  It must not be called when no
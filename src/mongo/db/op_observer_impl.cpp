@@ -135,9 +135,9 @@ void onWriteOpCompleted(OperationContext* opCtx,
 
 /**
  * Given the collection count from Collection::numRecords(), create and return the object for the
- * 'o2' field of a drop or rename oplog entry. If the collection count exceeds the upper limit of a
- * BSON NumberLong (long long), we will add a count of -1 and append a message with the original
- * collection count.
+ * 'o2' field of a drop, rename or truncateRange oplog entry. If the collection count exceeds the
+ * upper limit of a BSON NumberLong (long long), we will add a count of -1 and append a message with
+ * the original collection count.
  *
  * Replication rollback uses this field to correct correction counts on drop-pending collections.
  */
@@ -1129,6 +1129,26 @@ void OpObserverImpl::onEmptyCapped(OperationContext* opCtx,
     }
 }
 
+void OpObserverImpl::onTruncateRange(OperationContext* opCtx,
+                                     const NamespaceString& collectionName,
+                                     OptionalCollectionUUID uuid,
+                                     const RecordId& minRecordId,
+                                     const RecordId& maxRecordId,
+                                     int64_t numRecordsDeleted) {
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("truncateRange", collectionName.coll());
+    minRecordId.serializeToken("minRecordId", &cmdBuilder);
+    maxRecordId.serializeToken("maxRecordId", &cmdBuilder);
+
+    MutableOplogEntry oplogEntry;
+    oplogEntry.setOpType(repl::OpTypeEnum::kCommand);
+    oplogEntry.setNss(collectionName.getCommandNS());
+    oplogEntry.setUuid(uuid);
+    oplogEntry.setObject(cmdBuilder.obj());
+    oplogEntry.setObject2(makeObject2ForDropOrRename(numRecordsDeleted));
+    logOperation(opCtx, &oplogEntry);
+}
+
 namespace {
 // Accepts an empty BSON builder and appends the given transaction statements to an 'applyOps' array
 // field. Appends as many operations as possible until either the constructed object exceeds the
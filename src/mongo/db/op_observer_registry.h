@@ -356,6 +356,18 @@ public:
             o->onEmptyCapped(opCtx, collectionName, uuid);
     }
 
+    void onTruncateRange(OperationContext* const opCtx,
+                         const NamespaceString& collectionName,
+                         OptionalCollectionUUID uuid,
+                         const RecordId& minRecordId,
+                         const RecordId& maxRecordId,
+                         int64_t numRecordsDeleted) override {
+        ReservedTimes times{opCtx};
+        for (auto& o : _observers)
+            o->onTruncateRange(
+                opCtx, collectionName, uuid, minRecordId, maxRecordId, numRecordsDeleted);
+    }
+
     void onUnpreparedTransactionCommit(OperationContext* opCtx,
                                        std::vector<repl::ReplOperation>* statements,
                                        size_t numberOfPreImagesToWrite) override {
@@ -41,6 +41,7 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -84,7 +86,9 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/scopeguard.h"
 
@@ -593,8 +597,354 @@ bool isTimeseriesMetaFieldOnlyQuery(OperationContext* opCtx,
         });
 }
 
+/**
+ * The pool of threads on which the statements of large unordered writes are applied. It is started
+ * the first time a write is split across workers, and joined when the server shuts down.
+ */
+class ParallelWriterPool {
+public:
+    static ParallelWriterPool& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the pool, starting it if needed, or nullptr once it has been shut down.
+     */
+    ThreadPool* getPool() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_shutdown) {
+            return nullptr;
+        }
+        if (!_pool) {
+            ThreadPool::Options options;
+            options.poolName = "ParallelWriterThreadPool";
+            options.threadNamePrefix = "ParallelWriter-";
+            options.minThreads = 0;
+            options.maxThreads = static_cast<size_t>(internalParallelWriteMaxThreads.load());
+            options.onCreateThread = [](const std::string& threadName) {
+                Client::initThread(threadName);
+                auto client = Client::getCurrent();
+                AuthorizationSession::get(*client)->grantInternalAuthorization(client);
+
+                stdx::lock_guard<Client> lk(*client);
+                client->setSystemOperationKillableByStepdown(lk);
+            };
+            _pool = std::make_unique<ThreadPool>(options);
+            _pool->startup();
+        }
+        return _pool.get();
+    }
+
+    /**
+     * Shuts down the pool and waits for its threads to exit. Writes which are split after this
+     * fail with ShutdownInProgress.
+     */
+    void shutdown() {
+        ThreadPool* pool;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_shutdown) {
+                return;
+            }
+            _shutdown = true;
+            pool = _pool.get();
+        }
+
+        if (pool) {
+            pool->shutdown();
+            pool->join();
+        }
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ParallelWriterPool::_mutex");
+    std::unique_ptr<ThreadPool> _pool;
+    bool _shutdown = false;
+};
+
+const auto getParallelWriterPool = ServiceContext::declareDecoration<ParallelWriterPool>();
+
+ParallelWriterPool& ParallelWriterPool::get(ServiceContext* serviceContext) {
+    return getParallelWriterPool(serviceContext);
+}
+
+// The threads of the pool own Clients, which must be gone before the ServiceContext is destroyed.
+ServiceContext::ConstructorActionRegisterer parallelWriterPoolRegisterer{
+    "ParallelWriterPool",
+    [](ServiceContext*) {},
+    [](ServiceContext* serviceContext) { ParallelWriterPool::get(serviceContext).shutdown(); }};
+
+// Set on the operations which apply a range of the statements of a parallel write, so that they
+// are not split any further.
+const auto isParallelWriteWorker = OperationContext::declareDecoration<bool>();
+
+/**
+ * Tracks the operations of the workers applying a parallel write, so that they can be killed if
+ * the operation which started them is interrupted.
+ */
+class ParallelWriteWorkers {
+public:
+    explicit ParallelWriteWorkers(size_t numWorkers) : _opCtxs(numWorkers, nullptr) {}
+
+    void registerWorker(size_t index, OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _opCtxs[index] = opCtx;
+        if (_killCode) {
+            _kill(opCtx, *_killCode);
+        }
+    }
+
+    void unregisterWorker(size_t index) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _opCtxs[index] = nullptr;
+    }
+
+    /**
+     * Kills the operations of all running workers, and of any worker which starts later.
+     */
+    void killAll(ErrorCodes::Error killCode) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _killCode = killCode;
+        for (auto opCtx : _opCtxs) {
+            if (opCtx) {
+                _kill(opCtx, killCode);
+            }
+        }
+    }
+
+private:
+    static void _kill(OperationContext* opCtx, ErrorCodes::Error killCode) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, killCode);
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ParallelWriteWorkers::_mutex");
+    std::vector<OperationContext*> _opCtxs;
+    boost::optional<ErrorCodes::Error> _killCode;
+};
+
+/**
+ * Returns the number of workers across which a write command with 'numOps' statements should be
+ * split, or 1 if it should be applied on the client thread.
+ *
+ * Only unordered, non-transactional, non-retryable and unversioned writes received from a client
+ * are split. Retryable writes and transactions tie each statement to the session of the
+ * originating operation, and the shard version checks of a versioned write are only established on
+ * the originating operation.
+ */
+size_t getNumParallelWriteWorkers(OperationContext* opCtx,
+                                  const write_ops::WriteCommandRequestBase& wholeOp,
+                                  size_t numOps,
+                                  OperationSource source) {
+    const auto maxThreads = static_cast<size_t>(internalParallelWriteMaxThreads.load());
+    const auto minOpsPerThread = static_cast<size_t>(internalParallelWriteMinOpsPerThread.load());
+    if (maxThreads <= 1 || numOps < 2 * minOpsPerThread) {
+        return 1;
+    }
+
+    if (wholeOp.getOrdered() || source != OperationSource::kStandard ||
+        isParallelWriteWorker(opCtx) || opCtx->getTxnNumber() ||
+        opCtx->lockState()->inAWriteUnitOfWork() || !opCtx->getClient()->session() ||
+        opCtx->getClient()->isInDirectClient() ||
+        OperationShardingState::isOperationVersioned(opCtx) ||
+        repl::tenantMigrationRecipientInfo(opCtx)) {
+        return 1;
+    }
+
+    return std::min(maxThreads, numOps / minOpsPerThread);
+}
+
+/**
+ * Applies the 'numOps' statements of an unordered write across 'numWorkers' workers of the
+ * ParallelWriterPool. Each worker applies a contiguous range of the statements, described by the
+ * request returned by 'makeSubOp(begin, end)', by calling 'perform' with its own operation
+ * context, so each range is written in its own WriteUnitOfWorks.
+ *
+ * The results of the workers are merged in statement order, with one result for each statement.
+ * The ranges have already committed independently, so a worker which fails does not fail the
+ * command: its error is reported for each statement of its range. A worker which stops early, as
+ * the serial loop does for routing and tenant migration errors, has the error it stopped at
+ * reported for each statement it did not apply.
+ */
+template <typename MakeSubOp, typename Perform>
+WriteResult performWritesInParallel(OperationContext* opCtx,
+                                    size_t numOps,
+                                    size_t numWorkers,
+                                    MakeSubOp makeSubOp,
+                                    Perform perform) {
+    auto pool = ParallelWriterPool::get(opCtx->getServiceContext()).getPool();
+    uassert(ErrorCodes::ShutdownInProgress, "The parallel writer pool has been shut down", pool);
+    auto workers = std::make_shared<ParallelWriteWorkers>(numWorkers);
+
+    const auto& validationSettings = DocumentValidationSettings::get(opCtx);
+    DocumentValidationSettings::Flags validationFlags =
+        DocumentValidationSettings::kEnableValidation;
+    if (validationSettings.isSchemaValidationDisabled()) {
+        validationFlags |= DocumentValidationSettings::kDisableSchemaValidation;
+    }
+    if (validationSettings.isInternalValidationDisabled()) {
+        validationFlags |= DocumentValidationSettings::kDisableInternalValidation;
+    }
+
+    // The workers act on behalf of the client operation. Their writes are attributed to its users
+    // for auditing, and they run with its deadline and comment. Killing the client operation kills
+    // the workers, see the wait below.
+    const audit::ImpersonatedClientAttrs impersonatedClientAttrs(opCtx->getClient());
+    const auto deadline = opCtx->getDeadline();
+    const auto timeoutError = opCtx->getTimeoutError();
+    const auto comment = opCtx->getComment() ? opCtx->getComment()->wrap() : BSONObj();
+
+    std::vector<size_t> rangeSizes;
+    std::vector<Future<WriteResult>> futures;
+    rangeSizes.reserve(numWorkers);
+    futures.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        const size_t begin = numOps * i / numWorkers;
+        const size_t end = numOps * (i + 1) / numWorkers;
+        rangeSizes.push_back(end - begin);
+
+        auto pf = makePromiseFuture<WriteResult>();
+        futures.push_back(std::move(pf.future));
+        pool->schedule([workers,
+                        i,
+                        validationFlags,
+                        impersonatedClientAttrs,
+                        deadline,
+                        timeoutError,
+                        comment,
+                        perform,
+                        subOp = makeSubOp(begin, end),
+                        promise = std::move(pf.promise)](Status status) mutable {
+            if (!status.isOK()) {
+                promise.setError(status);
+                return;
+            }
+            promise.setWith([&] {
+                // The Client of the worker thread is internal, and only impersonates the users of
+                // the client operation for as long as it applies its statements.
+                auto authSession = AuthorizationSession::get(cc());
+                authSession->setImpersonatedUserData(impersonatedClientAttrs.userNames,
+                                                     impersonatedClientAttrs.roleNames);
+                ON_BLOCK_EXIT([&] { authSession->clearImpersonatedUserData(); });
+
+                auto workerOpCtx = cc().makeOperationContext();
+                isParallelWriteWorker(workerOpCtx.get()) = true;
+                if (validationFlags != DocumentValidationSettings::kEnableValidation) {
+                    DocumentValidationSettings::get(workerOpCtx.get()).setFlags(validationFlags);
+                }
+                if (deadline != Date_t::max()) {
+                    workerOpCtx->setDeadlineByDate(deadline, timeoutError);
+                }
+                if (!comment.isEmpty()) {
+                    workerOpCtx->setComment(comment);
+                }
+
+                workers->registerWorker(i, workerOpCtx.get());
+                ON_BLOCK_EXIT([&] { workers->unregisterWorker(i); });
+                return perform(workerOpCtx.get(), subOp, OperationSource::kStandard);
+            });
+        });
+    }
+
+    for (auto&& future : futures) {
+        try {
+            future.wait(opCtx);
+        } catch (const DBException& ex) {
+            // The client operation was interrupted, for example by killOp or its deadline. Stop the
+            // workers, which may hold locks, before failing the command.
+            workers->killAll(ex.code());
+            for (auto&& f : futures) {
+                f.waitNoThrow();
+            }
+            throw;
+        }
+    }
+
+    WriteResult out;
+    out.results.reserve(numOps);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        auto swRangeResult = std::move(futures[i]).getNoThrow();
+        if (!swRangeResult.isOK()) {
+            out.results.insert(out.results.end(), rangeSizes[i], swRangeResult.getStatus());
+            continue;
+        }
+
+        auto& rangeResults = swRangeResult.getValue().results;
+        const size_t numApplied = rangeResults.size();
+        std::move(rangeResults.begin(), rangeResults.end(), std::back_inserter(out.results));
+        if (numApplied < rangeSizes[i]) {
+            invariant(numApplied > 0 && !out.results.back().isOK());
+            // Omit the reason from the repeated errors, as the command reply does when it repeats
+            // the error a serial unordered write stopped at.
+            const Status stoppedAt = out.results.back().getStatus().withReason("");
+            out.results.insert(out.results.end(), rangeSizes[i] - numApplied, stoppedAt);
+        }
+    }
+
+    // The workers recorded errors and routing failures on their own Client and operation. Report
+    // them on the client operation, as if it had applied the statements itself.
+    for (auto it = out.results.rbegin(); it != out.results.rend(); ++it) {
+        if (!it->isOK()) {
+            const auto& status = it->getStatus();
+            LastError::get(opCtx->getClient()).setLastError(status.code(), status.reason());
+            if (status.code() == ErrorCodes::StaleDbVersion ||
+                ErrorCodes::isStaleShardVersionError(status)) {
+                OperationShardingState::get(opCtx).setShardingOperationFailedStatus(status);
+            }
+            break;
+        }
+    }
+
+    // The client must wait for the write concern of every worker's writes.
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+    return out;
+}
+
+/**
+ * Adds the totals of the statements of a parallel write to the metrics of the command's CurOp. The
+ * statements were applied on the workers' operations, so the command's CurOp did not see them.
+ */
+void recordParallelWriteMetrics(OperationContext* opCtx,
+                                LogicalOp logicalOp,
+                                const WriteResult& out) {
+    long long n = 0;
+    long long nModified = 0;
+    long long nUpserted = 0;
+    for (auto&& result : out.results) {
+        if (!result.isOK()) {
+            continue;
+        }
+        const auto& singleWriteResult = result.getValue();
+        if (!singleWriteResult.getUpsertedId().isEmpty()) {
+            ++nUpserted;
+        } else {
+            n += singleWriteResult.getN();
+        }
+        nModified += singleWriteResult.getNModified();
+    }
+
+    auto& additiveMetrics = CurOp::get(opCtx)->debug().additiveMetrics;
+    switch (logicalOp) {
+        case LogicalOp::opInsert:
+            additiveMetrics.incrementNinserted(n);
+            break;
+        case LogicalOp::opUpdate:
+            additiveMetrics.nMatched = additiveMetrics.nMatched.value_or(0) + n;
+            additiveMetrics.nModified = additiveMetrics.nModified.value_or(0) + nModified;
+            additiveMetrics.incrementNUpserted(nUpserted);
+            break;
+        case LogicalOp::opDelete:
+            additiveMetrics.ndeleted = additiveMetrics.ndeleted.value_or(0) + n;
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
 }  // namespace
 
+void shutdownParallelWriters(ServiceContext* serviceContext) {
+    ParallelWriterPool::get(serviceContext).shutdown();
+}
+
 WriteResult performInserts(OperationContext* opCtx,
                            const write_ops::InsertCommandRequest& wholeOp,
                            const OperationSource& source) {
@@ -634,6 +984,27 @@ WriteResult performInserts(OperationContext* opCtx,
 
     DisableDocumentSchemaValidationIfTrue docSchemaValidationDisabler(
         opCtx, wholeOp.getWriteCommandRequestBase().getBypassDocumentValidation());
+
+    const size_t numWorkers = getNumParallelWriteWorkers(
+        opCtx, wholeOp.getWriteCommandRequestBase(), wholeOp.getDocuments().size(), source);
+    if (numWorkers > 1) {
+        const auto& docs = wholeOp.getDocuments();
+        auto out = performWritesInParallel(
+            opCtx,
+            docs.size(),
+            numWorkers,
+            [&](size_t begin, size_t end) {
+                write_ops::InsertCommandRequest subOp(wholeOp.getNamespace());
+                subOp.setWriteCommandRequestBase(wholeOp.getWriteCommandRequestBase());
+                subOp.setDocuments(
+                    std::vector<BSONObj>(docs.begin() + begin, docs.begin() + end));
+                return subOp;
+            },
+            &performInserts);
+        recordParallelWriteMetrics(opCtx, LogicalOp::opInsert, out);
+        return out;
+    }
+
     LastOpFixer lastOpFixer(opCtx, wholeOp.getNamespace());
 
     WriteResult out;
@@ -942,6 +1313,36 @@ WriteResult performUpdates(OperationContext* opCtx,
     const auto& runtimeConstants =
         wholeOp.getLegacyRuntimeConstants().value_or(Variables::generateRuntimeConstants(opCtx));
 
+    // Upserts of the same document on different workers could each insert it, so a command which
+    // may upsert is applied on the client thread.
+    const auto& ops = wholeOp.getUpdates();
+    const bool mayUpsert = std::any_of(
+        ops.begin(), ops.end(), [](const auto& singleOp) { return singleOp.getUpsert(); });
+    size_t numWorkers = 1;
+    if (!mayUpsert) {
+        numWorkers = getNumParallelWriteWorkers(
+            opCtx, wholeOp.getWriteCommandRequestBase(), ops.size(), source);
+    }
+    if (numWorkers > 1) {
+        // Every worker evaluates the statements with the same runtime constants.
+        auto parallelOut = performWritesInParallel(
+            opCtx,
+            ops.size(),
+            numWorkers,
+            [&](size_t begin, size_t end) {
+                write_ops::UpdateCommandRequest subOp(wholeOp.getNamespace());
+                subOp.setWriteCommandRequestBase(wholeOp.getWriteCommandRequestBase());
+                subOp.setUpdates(
+                    std::vector<write_ops::UpdateOpEntry>(ops.begin() + begin, ops.begin() + end));
+                subOp.setLet(wholeOp.getLet());
+                subOp.setLegacyRuntimeConstants(runtimeConstants);
+                return subOp;
+            },
+            &performUpdates);
+        recordParallelWriteMetrics(opCtx, LogicalOp::opUpdate, parallelOut);
+        return parallelOut;
+    }
+
     for (auto&& singleOp : wholeOp.getUpdates()) {
         const auto stmtId = getStmtIdForWriteOp(opCtx, wholeOp, stmtIdIndex++);
         if (opCtx->getTxnNumber()) {
@@ -1120,6 +1521,29 @@ WriteResult performDeletes(OperationContext* opCtx,
     const auto& runtimeConstants =
         wholeOp.getLegacyRuntimeConstants().value_or(Variables::generateRuntimeConstants(opCtx));
 
+    const size_t numWorkers = getNumParallelWriteWorkers(
+        opCtx, wholeOp.getWriteCommandRequestBase(), wholeOp.getDeletes().size(), source);
+    if (numWorkers > 1) {
+        // Every worker evaluates the statements with the same runtime constants.
+        const auto& ops = wholeOp.getDeletes();
+        auto parallelOut = performWritesInParallel(
+            opCtx,
+            ops.size(),
+            numWorkers,
+            [&](size_t begin, size_t end) {
+                write_ops::DeleteCommandRequest subOp(wholeOp.getNamespace());
+                subOp.setWriteCommandRequestBase(wholeOp.getWriteCommandRequestBase());
+                subOp.setDeletes(
+                    std::vector<write_ops::DeleteOpEntry>(ops.begin() + begin, ops.begin() + end));
+                subOp.setLet(wholeOp.getLet());
+                subOp.setLegacyRuntimeConstants(runtimeConstants);
+                return subOp;
+            },
+            &performDeletes);
+        recordParallelWriteMetrics(opCtx, LogicalOp::opDelete, parallelOut);
+        return parallelOut;
+    }
+
     for (auto&& singleOp : wholeOp.getDeletes()) {
         const auto stmtId = getStmtIdForWriteOp(opCtx, wholeOp, stmtIdIndex++);
         if (opCtx->getTxnNumber()) {
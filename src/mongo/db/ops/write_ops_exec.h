@@ -84,6 +84,12 @@ WriteResult performDeletes(OperationContext* opCtx,
                            const write_ops::DeleteCommandRequest& op,
                            const OperationSource& source = OperationSource::kStandard);
 
+/**
+ * Shuts down the threads which apply the statements of unordered writes split across workers, and
+ * waits for them to exit. Writes which would be split afterwards fail with ShutdownInProgress.
+ */
+void shutdownParallelWriters(ServiceContext* serviceContext);
+
 Status performAtomicTimeseriesWrites(OperationContext* opCtx,
                                      const std::vector<write_ops::InsertCommandRequest>& insertOps,
                                      const std::vector<write_ops::UpdateCommandRequest>& updateOps);
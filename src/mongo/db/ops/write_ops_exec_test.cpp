@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ops/write_ops_exec.h"
+
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/transport/mock_session.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("foo.bar");
+
+/**
+ * Applies unordered writes received from a client with a session, split into ranges of four
+ * statements across two parallel writer workers.
+ */
+class ParallelWriteTest : public ServiceContextMongoDTest {
+protected:
+    void setUp() override {
+        ServiceContextMongoDTest::setUp();
+        auto replMock = std::make_unique<repl::ReplicationCoordinatorMock>(getServiceContext());
+        replMock->alwaysAllowWrites(true);
+        repl::ReplicationCoordinator::set(getServiceContext(), std::move(replMock));
+
+        _client = getServiceContext()->makeClient("ParallelWriteTest",
+                                                  transport::MockSession::create(nullptr));
+        _clientRegion.emplace(_client);
+        _opCtx = cc().makeOperationContext();
+    }
+
+    void tearDown() override {
+        _opCtx.reset();
+        _clientRegion.reset();
+        _client.reset();
+        ServiceContextMongoDTest::tearDown();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    /**
+     * Inserts 'docs' with an ordered insert, which is never split, creating the collection if
+     * needed.
+     */
+    void insertSerially(std::vector<BSONObj> docs) {
+        write_ops::InsertCommandRequest insertOp(kNss);
+        insertOp.getWriteCommandRequestBase().setOrdered(true);
+        insertOp.setDocuments(std::move(docs));
+        for (auto&& result : write_ops_exec::performInserts(opCtx(), insertOp).results) {
+            ASSERT_OK(result);
+        }
+    }
+
+    long long numRecords() {
+        AutoGetCollection collection(opCtx(), kNss, MODE_IS);
+        return collection->numRecords(opCtx());
+    }
+
+    const OpDebug::AdditiveMetrics& commandMetrics() {
+        return CurOp::get(opCtx())->debug().additiveMetrics;
+    }
+
+private:
+    RAIIServerParameterControllerForTest _maxThreads{"internalParallelWriteMaxThreads", 2};
+    RAIIServerParameterControllerForTest _minOpsPerThread{"internalParallelWriteMinOpsPerThread",
+                                                          4};
+
+    ServiceContext::UniqueClient _client;
+    boost::optional<AlternativeClientRegion> _clientRegion;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+std::vector<BSONObj> makeDocs(int numDocs) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < numDocs; ++i) {
+        docs.push_back(BSON("_id" << i << "x" << 0));
+    }
+    return docs;
+}
+
+TEST_F(ParallelWriteTest, UnorderedInsertReportsFailuresOfEveryRange) {
+    // Make the second statement of each range fail.
+    insertSerially({BSON("_id" << 1), BSON("_id" << 5)});
+
+    write_ops::InsertCommandRequest insertOp(kNss);
+    insertOp.getWriteCommandRequestBase().setOrdered(false);
+    insertOp.setDocuments(makeDocs(8));
+    auto result = write_ops_exec::performInserts(opCtx(), insertOp);
+
+    ASSERT_EQ(8U, result.results.size());
+    for (size_t i = 0; i < result.results.size(); ++i) {
+        if (i == 1 || i == 5) {
+            ASSERT_EQ(ErrorCodes::DuplicateKey, result.results[i].getStatus());
+        } else {
+            ASSERT_OK(result.results[i]);
+            ASSERT_EQ(1, result.results[i].getValue().getN());
+        }
+    }
+
+    ASSERT_EQ(8, numRecords());
+    ASSERT_EQ(6, *commandMetrics().ninserted);
+}
+
+TEST_F(ParallelWriteTest, UnorderedUpdateRecordsCountersOnCommand) {
+    insertSerially(makeDocs(8));
+
+    write_ops::UpdateCommandRequest updateOp(kNss);
+    updateOp.getWriteCommandRequestBase().setOrdered(false);
+    std::vector<write_ops::UpdateOpEntry> updates;
+    for (int i = 0; i < 8; ++i) {
+        // The last statement matches its document without modifying it.
+        const int x = i == 7 ? 0 : 1;
+        updates.push_back(write_ops::UpdateOpEntry(
+            BSON("_id" << i), write_ops::UpdateModification(BSON("$set" << BSON("x" << x)))));
+    }
+    updateOp.setUpdates(std::move(updates));
+    auto result = write_ops_exec::performUpdates(opCtx(), updateOp);
+
+    ASSERT_EQ(8U, result.results.size());
+    for (auto&& singleResult : result.results) {
+        ASSERT_OK(singleResult);
+    }
+
+    ASSERT_EQ(8, *commandMetrics().nMatched);
+    ASSERT_EQ(7, *commandMetrics().nModified);
+}
+
+TEST_F(ParallelWriteTest, UnorderedUpsertsAreAppliedOnTheClientThread) {
+    write_ops::UpdateCommandRequest updateOp(kNss);
+    updateOp.getWriteCommandRequestBase().setOrdered(false);
+    std::vector<write_ops::UpdateOpEntry> updates;
+    for (int i = 0; i < 8; ++i) {
+        write_ops::UpdateOpEntry update(
+            BSON("a" << 1), write_ops::UpdateModification(BSON("$inc" << BSON("n" << 1))));
+        update.setUpsert(true);
+        updates.push_back(std::move(update));
+    }
+    updateOp.setUpdates(std::move(updates));
+    auto result = write_ops_exec::performUpdates(opCtx(), updateOp);
+
+    ASSERT_EQ(8U, result.results.size());
+    for (auto&& singleResult : result.results) {
+        ASSERT_OK(singleResult);
+    }
+
+    // Only the first statement inserted the document, which every later statement then matched.
+    ASSERT_EQ(1, numRecords());
+    ASSERT_FALSE(result.results[0].getValue().getUpsertedId().isEmpty());
+    for (size_t i = 1; i < result.results.size(); ++i) {
+        ASSERT_TRUE(result.results[i].getValue().getUpsertedId().isEmpty());
+    }
+}
+
+TEST_F(ParallelWriteTest, UnorderedDeleteRecordsCountersOnCommand) {
+    insertSerially(makeDocs(8));
+
+    write_ops::DeleteCommandRequest deleteOp(kNss);
+    deleteOp.getWriteCommandRequestBase().setOrdered(false);
+    std::vector<write_ops::DeleteOpEntry> deletes;
+    for (int i = 0; i < 8; ++i) {
+        // The last statement matches no document.
+        const int id = i == 7 ? 100 : i;
+        deletes.push_back(write_ops::DeleteOpEntry(BSON("_id" << id), false /* multi */));
+    }
+    deleteOp.setDeletes(std::move(deletes));
+    auto result = write_ops_exec::performDeletes(opCtx(), deleteOp);
+
+    ASSERT_EQ(8U, result.results.size());
+    for (size_t i = 0; i < result.results.size(); ++i) {
+        ASSERT_OK(result.results[i]);
+        ASSERT_EQ(i == 7 ? 0 : 1, result.results[i].getValue().getN());
+    }
+
+    ASSERT_EQ(1, numRecords());
+    ASSERT_EQ(7, *commandMetrics().ndeleted);
+}
+
+TEST_F(ParallelWriteTest, WritesAreNotSplitOnceThePoolIsShutDown) {
+    write_ops_exec::shutdownParallelWriters(getServiceContext());
+
+    write_ops::InsertCommandRequest insertOp(kNss);
+    insertOp.getWriteCommandRequestBase().setOrdered(false);
+    insertOp.setDocuments(makeDocs(8));
+    ASSERT_THROWS_CODE(write_ops_exec::performInserts(opCtx(), insertOp),
+                       DBException,
+                       ErrorCodes::ShutdownInProgress);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_query_stats.h"
+#include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/stats/query_stats_store.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A MongoProcessInterface used for testing which returns artificial host and shard names.
+ */
+class QueryStatsMongoProcessInterface final : public StubMongoProcessInterface {
+public:
+    std::string getShardName(OperationContext* opCtx) const override {
+        return "testShardName";
+    }
+
+    std::string getHostAndPort(OperationContext* opCtx) const override {
+        return "testHostName";
+    }
+};
+
+class DocumentSourceQueryStatsTest : public AggregationContextFixture {
+public:
+    DocumentSourceQueryStatsTest()
+        : AggregationContextFixture(NamespaceString::makeCollectionlessAggregateNSS("admin")) {}
+};
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfSpecIsNotObject) {
+    const auto specObj = fromjson("{$queryStats: 1}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfSpecIsANonEmptyObject) {
+    const auto specObj = fromjson("{$queryStats: {unknownOption: 1}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfNotRunOnAdminWithAggregateOne) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    getExpCtx()->ns = NamespaceString("test.coll");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::InvalidNamespace);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, CanParseAndSerializeSuccessfully) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ReturnsOneDocumentPerQueryShape) {
+    auto& store = QueryStatsStore::get(getOpCtx()->getServiceContext());
+    QueryStatsStore::OperationStats stats;
+    stats.nss = NamespaceString("test.coll");
+    stats.latency = Microseconds(10);
+    store.record(1, stats);
+    store.record(1, stats);
+    store.record(2, stats);
+
+    getExpCtx()->mongoProcessInterface = std::make_shared<QueryStatsMongoProcessInterface>();
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+
+    long long totalExecCount = 0;
+    size_t numShapes = 0;
+    for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
+        auto doc = next.releaseDocument();
+        ASSERT_VALUE_EQ(doc["ns"], Value("test.coll"_sd));
+        ASSERT_VALUE_EQ(doc["host"], Value("testHostName"_sd));
+        ASSERT_TRUE(doc["shard"].missing());
+        totalExecCount += doc["execCount"].getLong();
+        ++numShapes;
+    }
+    ASSERT_EQ(numShapes, 2u);
+    ASSERT_EQ(totalExecCount, 3);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ReturnsShardNameWhenRunFromMongos) {
+    QueryStatsStore::OperationStats stats;
+    stats.nss = NamespaceString("test.coll");
+    QueryStatsStore::get(getOpCtx()->getServiceContext()).record(1, stats);
+
+    getExpCtx()->fromMongos = true;
+    getExpCtx()->mongoProcessInterface = std::make_shared<QueryStatsMongoProcessInterface>();
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.releaseDocument()["shard"], Value("testShardName"_sd));
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -6528,16 +6528,12 @@ ExpressionRegex::RegexExecutionState ExpressionRegex::buildInitialState(
 int ExpressionRegex::execute(RegexExecutionState* regexState) const {
     invariant(regexState);
     invariant(!regexState->nullish());
-    invariant(regexState->pcrePtr);
-
-    int execResult = pcre_exec(regexState->pcrePtr.get(),
-                               nullptr,
-                               regexState->input->c_str(),
-                               regexState->input->size(),
-                               regexState->startBytePos,
-                               0,  // No need to overwrite the options set during pcre_compile.
-                               &(regexState->capturesBuffer.front()),
-                               regexState->capturesBuffer.size());
+    invariant(regexState->compiledRegex);
+
+    int execResult = regexState->compiledRegex->execute(*regexState->input,
+                                                        regexState->startBytePos,
+                                                        &(regexState->capturesBuffer.front()),
+                                                        regexState->capturesBuffer.size());
     // The 'execResult' will be -1 if there is no match, 0 < execResult <= (numCaptures + 1)
     // depending on how many capture groups match, negative (other than -1) if there is an error
     // during execution, and zero if capturesBuffer's capacity is not sufficient to hold all the
@@ -6656,26 +6652,18 @@ void ExpressionRegex::_compile(RegexExecutionState* executionState) const {
         return;
     }
 
-    const char* compile_error;
-    int eoffset;
-
     // The C++ interface pcreccp.h doesn't have a way to capture the matched string (or the index of
-    // the match). So we are using the C interface. First we compile all the regex options to
-    // generate pcre object, which will later be used to match against the input string.
-    executionState->pcrePtr = std::shared_ptr<pcre>(
-        pcre_compile(
-            executionState->pattern->c_str(), pcreOptions, &compile_error, &eoffset, nullptr),
-        pcre_free);
+    // the match). So we are using the C interface, through a compiled pattern which is shared with
+    // any other expression using the same pattern and options.
+    executionState->compiledRegex =
+        RegexCache::get().getOrCompile(*executionState->pattern, pcreOptions);
     uassert(51111,
-            str::stream() << "Invalid Regex in " << _opName << ": " << compile_error,
-            executionState->pcrePtr);
-
-    // Calculate the number of capture groups present in 'pattern' and store in 'numCaptures'.
-    const int pcre_retval = pcre_fullinfo(executionState->pcrePtr.get(),
-                                          nullptr,
-                                          PCRE_INFO_CAPTURECOUNT,
-                                          &executionState->numCaptures);
-    invariant(pcre_retval == 0);
+            str::stream() << "Invalid Regex in " << _opName << ": "
+                          << executionState->compiledRegex->error(),
+            executionState->compiledRegex->error().empty());
+
+    // Store the number of capture groups present in 'pattern' in 'numCaptures'.
+    executionState->numCaptures = executionState->compiledRegex->numCaptures();
 
     // The first two-thirds of the vector is used to pass back captured substrings' start and
     // (end+1) indexes. The remaining third of the vector is used as workspace by pcre_exec() while
@@ -52,6 +52,7 @@
 #include "mongo/db/query/allowed_contexts.h"
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/query/regex_cache.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/server_options.h"
 #include "mongo/util/intrusive_counter.h"
@@ -3487,11 +3488,11 @@ public:
         int numCaptures = 0;
 
         /**
-         * If 'regex' is constant, 'pcrePtr' will be shared between the active RegexExecutionState
-         * and '_initialExecStateForConstantRegex'. If not, then the active RegexExecutionState is
-         * the sole owner.
+         * The compiled pattern, obtained from the process-wide RegexCache. It is immutable and may
+         * be shared with '_initialExecStateForConstantRegex' and with other expressions using the
+         * same pattern and options.
          */
-        std::shared_ptr<pcre> pcrePtr;
+        std::shared_ptr<const CompiledRegex> compiledRegex;
 
         /**
          * The input text and starting position for the current execution context.
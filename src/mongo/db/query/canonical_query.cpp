@@ -42,6 +42,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/filter_parse_cache.h"
 #include "mongo/db/query/indexability.h"
 #include "mongo/db/query/projection_parser.h"
 #include "mongo/db/query/query_planner_common.h"
@@ -106,6 +107,8 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
     std::unique_ptr<CanonicalQuery> cq(new CanonicalQuery());
     cq->setExplain(explain);
 
+    // Set if the MatchExpression was instantiated from a template which was already normalized.
+    bool rootIsNormalized = false;
     StatusWithMatchExpression statusWithMatcher = [&]() -> StatusWithMatchExpression {
         if (getTestCommandsEnabled() && internalQueryEnableCSTParser.load()) {
             try {
@@ -114,6 +117,13 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
             } catch (const DBException& ex) {
                 return ex.toStatus();
             }
+        } else if (opCtx) {
+            return FilterParseCache::get(opCtx->getServiceContext())
+                .parse(findCommand->getFilter(),
+                       newExpCtx,
+                       extensionsCallback,
+                       allowedFeatures,
+                       &rootIsNormalized);
         } else {
             return MatchExpressionParser::parse(
                 findCommand->getFilter(), newExpCtx, extensionsCallback, allowedFeatures);
@@ -130,6 +140,7 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
                  std::move(findCommand),
                  parsingCanProduceNoopMatchNodes(extensionsCallback, allowedFeatures),
                  std::move(me),
+                 rootIsNormalized,
                  projectionPolicies,
                  std::move(pipeline));
 
@@ -167,6 +178,7 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
                                  std::move(findCommand),
                                  baseQuery.canHaveNoopMatchNodes(),
                                  root->shallowClone(),
+                                 false /* rootIsNormalized */,
                                  ProjectionPolicies::findProjectionPolicies(),
                                  {} /* an empty pipeline */);
 
@@ -181,6 +193,7 @@ Status CanonicalQuery::init(OperationContext* opCtx,
                             std::unique_ptr<FindCommandRequest> findCommand,
                             bool canHaveNoopMatchNodes,
                             std::unique_ptr<MatchExpression> root,
+                            bool rootIsNormalized,
                             const ProjectionPolicies& projectionPolicies,
                             std::vector<std::unique_ptr<InnerPipelineStageInterface>> pipeline) {
     _expCtx = expCtx;
@@ -194,7 +207,7 @@ Status CanonicalQuery::init(OperationContext* opCtx,
         return validStatus.getStatus();
     }
     auto unavailableMetadata = validStatus.getValue();
-    _root = MatchExpression::normalize(std::move(root));
+    _root = rootIsNormalized ? std::move(root) : MatchExpression::normalize(std::move(root));
     // The tree must always be valid after normalization.
     dassert(isValid(_root.get(), *_findCommand).isOK());
     if (auto status = isValidNormalized(_root.get()); !status.isOK()) {
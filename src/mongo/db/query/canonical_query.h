@@ -241,6 +241,7 @@ private:
                 std::unique_ptr<FindCommandRequest> findCommand,
                 bool canHaveNoopMatchNodes,
                 std::unique_ptr<MatchExpression> root,
+                bool rootIsNormalized,
                 const ProjectionPolicies& projectionPolicies,
                 std::vector<std::unique_ptr<InnerPipelineStageInterface>> pipeline);
 
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/ensure_sorted.h"
@@ -90,6 +91,19 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             return std::make_unique<CollectionScan>(
                 expCtx, _collection, params, _ws, csn->filter.get());
         }
+        case STAGE_COLUMN_SCAN: {
+            const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(root);
+
+            invariant(_collection);
+            auto descriptor = _collection->getIndexCatalog()->findIndexByName(
+                _opCtx, csn->index.identifier.catalogName);
+            invariant(descriptor,
+                      str::stream() << "Namespace: " << _collection->ns()
+                                    << ", CanonicalQuery: " << _cq.toStringShort()
+                                    << ", IndexEntry: " << csn->index.toString());
+            return std::make_unique<ColumnScan>(
+                expCtx, _collection, descriptor, _ws, csn->filter.get());
+        }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
 
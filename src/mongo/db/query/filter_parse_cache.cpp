@@ -0,0 +1,449 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/filter_parse_cache.h"
+
+#include <cstring>
+#include <limits>
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getFilterParseCache = ServiceContext::declareDecoration<FilterParseCache>();
+
+Counter64 parseCacheHits;
+Counter64 parseCacheMisses;
+
+ServerStatusMetricField<Counter64> parseCacheHitsMetric("query.parseCache.hits", &parseCacheHits);
+ServerStatusMetricField<Counter64> parseCacheMissesMetric("query.parseCache.misses",
+                                                          &parseCacheMisses);
+
+/**
+ * Returns true if 'elem' is a constant which can be lifted out of the shape of a filter when it is
+ * the operand of a simple comparison.
+ */
+bool isParameterizable(const BSONElement& elem) {
+    switch (elem.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case jstOID:
+        case Date:
+        case bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isParameterizableOperator(StringData name) {
+    return name == "$eq"_sd || name == "$lt"_sd || name == "$lte"_sd || name == "$gt"_sd ||
+        name == "$gte"_sd;
+}
+
+/**
+ * Copies 'filter' into 'bob', calling 'onParam(elem, bob)' instead of copying each parameterizable
+ * operand of an implicit equality or of a simple comparison operator. Logical operators are
+ * descended into; any other part of the filter is copied verbatim and so becomes part of its shape.
+ */
+template <typename OnParam>
+void appendShape(const BSONObj& filter, BSONObjBuilder* bob, const OnParam& onParam) {
+    for (auto&& elem : filter) {
+        auto name = elem.fieldNameStringData();
+        if (name.startsWith("$")) {
+            if ((name == "$and"_sd || name == "$or"_sd || name == "$nor"_sd) &&
+                elem.type() == Array) {
+                BSONArrayBuilder arrBob(bob->subarrayStart(name));
+                for (auto&& child : elem.embeddedObject()) {
+                    if (child.type() == Object) {
+                        BSONObjBuilder childBob(arrBob.subobjStart());
+                        appendShape(child.embeddedObject(), &childBob, onParam);
+                    } else {
+                        arrBob.append(child);
+                    }
+                }
+            } else {
+                bob->append(elem);
+            }
+        } else if (isParameterizable(elem)) {
+            onParam(elem, bob);
+        } else if (elem.type() == Object &&
+                   elem.embeddedObject().firstElementFieldNameStringData().startsWith("$")) {
+            BSONObjBuilder opsBob(bob->subobjStart(name));
+            for (auto&& op : elem.embeddedObject()) {
+                if (isParameterizableOperator(op.fieldNameStringData()) && isParameterizable(op)) {
+                    onParam(op, &opsBob);
+                } else {
+                    opsBob.append(op);
+                }
+            }
+        } else {
+            bob->append(elem);
+        }
+    }
+}
+
+/**
+ * Appends a constant of type 'type' which is unique to parameter 'index' and is unlikely to occur
+ * in a real filter.
+ */
+void appendSentinel(BSONObjBuilder* bob, StringData name, BSONType type, uint32_t index) {
+    switch (type) {
+        case NumberInt:
+            bob->append(name, std::numeric_limits<int>::min() + static_cast<int>(index));
+            return;
+        case NumberLong:
+            bob->append(name,
+                        std::numeric_limits<long long>::min() + static_cast<long long>(index));
+            return;
+        case NumberDouble: {
+            // Large negative finite doubles, counting down from 0xffe0000000000000.
+            uint64_t bits = 0xffe0000000000000ULL - index;
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            bob->append(name, value);
+            return;
+        }
+        case NumberDecimal:
+            bob->append(name, Decimal128("-1" + std::to_string(index) + "E+6000"));
+            return;
+        case String:
+            bob->append(name, "\x01\x02parseCacheSentinel" + std::to_string(index));
+            return;
+        case jstOID: {
+            unsigned char bytes[OID::kOIDSize];
+            std::memset(bytes, 0xff, sizeof(bytes));
+            std::memcpy(bytes + OID::kOIDSize - sizeof(index), &index, sizeof(index));
+            bob->append(name, OID(bytes));
+            return;
+        }
+        case Date:
+            bob->appendDate(name,
+                            Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min() +
+                                                         static_cast<long long>(index)));
+            return;
+        case bsonTimestamp:
+            bob->append(name, Timestamp(0xfffffff0U, index));
+            return;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+bool isCacheableNode(const MatchExpression& expr) {
+    switch (expr.matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+        case MatchExpression::SIZE:
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::ALWAYS_FALSE:
+        case MatchExpression::ALWAYS_TRUE:
+            break;
+        default:
+            return false;
+    }
+    for (size_t i = 0; i < expr.numChildren(); ++i) {
+        if (!isCacheableNode(*expr.getChild(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Collects the comparison leaves of the tree rooted at 'expr', in pre-order.
+ */
+void collectComparisonLeaves(MatchExpression* expr,
+                             std::vector<ComparisonMatchExpression*>* leaves) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        leaves->push_back(static_cast<ComparisonMatchExpression*>(expr));
+    }
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        collectComparisonLeaves(expr->getChild(i), leaves);
+    }
+}
+
+/**
+ * Makes each $in in the tree rooted at 'expr' share ownership of 'backingBSON', which holds the
+ * elements of its equality list, so that the tree and its clones may outlive the caller's
+ * reference to it.
+ */
+void setInBackingBSON(MatchExpression* expr, const BSONObj& backingBSON) {
+    if (expr->matchType() == MatchExpression::MATCH_IN) {
+        static_cast<InMatchExpression*>(expr)->setBackingBSON(backingBSON);
+    }
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        setInBackingBSON(expr->getChild(i), backingBSON);
+    }
+}
+
+}  // namespace
+
+FilterParseCache& FilterParseCache::get(ServiceContext* service) {
+    return getFilterParseCache(service);
+}
+
+size_t FilterParseCache::_maxEntriesPerPartition() {
+    auto maxEntries = internalQueryFilterParseCacheMaxEntries.load();
+    if (maxEntries <= 0) {
+        return 0;
+    }
+    return std::max(size_t{1}, static_cast<size_t>(maxEntries) / kNumPartitions);
+}
+
+StatusWithMatchExpression FilterParseCache::parse(
+    const BSONObj& filter,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const ExtensionsCallback& extensionsCallback,
+    MatchExpressionParser::AllowedFeatureSet allowedFeatures,
+    bool* isNormalized) {
+    *isNormalized = false;
+    if (_maxEntriesPerPartition() == 0) {
+        return MatchExpressionParser::parse(filter, expCtx, extensionsCallback, allowedFeatures);
+    }
+
+    // The instantiated tree references the parameters in place, so it must own the filter.
+    BSONObj ownedFilter = filter.getOwned();
+    std::vector<BSONElement> params;
+    std::string key;
+    {
+        BSONObjBuilder keyBob;
+        appendShape(ownedFilter, &keyBob, [&](const BSONElement& elem, BSONObjBuilder* bob) {
+            params.push_back(elem);
+            bob->append(elem.fieldNameStringData(), static_cast<int>(elem.type()));
+        });
+        BSONObj shape = keyBob.done();
+
+        // Normalization depends on the collator, which decides for example whether the elements
+        // of an $in are duplicates, so templates are not shared across collations.
+        BSONObj collation;
+        if (auto collator = expCtx->getCollator()) {
+            collation = collator->getSpec().toBSON();
+        }
+
+        key.reserve(sizeof(allowedFeatures) + 1 + shape.objsize() + collation.objsize());
+        key.append(reinterpret_cast<const char*>(&allowedFeatures), sizeof(allowedFeatures));
+        key.push_back(extensionsCallback.hasNoopExtensions() ? 1 : 0);
+        key.append(shape.objdata(), shape.objsize());
+        key.append(collation.objdata(), collation.objsize());
+    }
+    auto hashedKey = StringMapHasher{}.hashed_key(key);
+
+    auto tmpl = _lookup(hashedKey);
+    if (tmpl) {
+        parseCacheHits.increment();
+    } else {
+        parseCacheMisses.increment();
+
+        BSONObjBuilder sentinelBob;
+        uint32_t nextSentinel = 0;
+        appendShape(ownedFilter, &sentinelBob, [&](const BSONElement& elem, BSONObjBuilder* bob) {
+            appendSentinel(bob, elem.fieldNameStringData(), elem.type(), nextSentinel++);
+        });
+        BSONObj sentinelFilter = sentinelBob.obj();
+
+        std::vector<BSONElement> sentinels;
+        BSONObjBuilder unusedBob;
+        appendShape(sentinelFilter, &unusedBob, [&](const BSONElement& elem, BSONObjBuilder*) {
+            sentinels.push_back(elem);
+        });
+        invariant(sentinels.size() == params.size());
+
+        auto swTmpl = _buildTemplate(
+            sentinelFilter, sentinels, expCtx, extensionsCallback, allowedFeatures);
+        if (!swTmpl.isOK()) {
+            // Let the regular parser produce the error for the actual filter.
+            return MatchExpressionParser::parse(
+                filter, expCtx, extensionsCallback, allowedFeatures);
+        }
+        tmpl = std::move(swTmpl.getValue());
+        _insert(hashedKey, tmpl);
+    }
+
+    if (!tmpl->root) {
+        return MatchExpressionParser::parse(filter, expCtx, extensionsCallback, allowedFeatures);
+    }
+    *isNormalized = true;
+    return {_instantiate(*tmpl, ownedFilter, params, expCtx)};
+}
+
+StatusWith<std::shared_ptr<const FilterParseCache::Template>> FilterParseCache::_buildTemplate(
+    const BSONObj& sentinelFilter,
+    const std::vector<BSONElement>& sentinels,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const ExtensionsCallback& extensionsCallback,
+    MatchExpressionParser::AllowedFeatureSet allowedFeatures) {
+    // Record whether the shape is SBE compatible independently of what the caller has already
+    // parsed with this ExpressionContext.
+    bool sbeCompatible = expCtx->sbeCompatible;
+    expCtx->sbeCompatible = true;
+    auto swRoot =
+        MatchExpressionParser::parse(sentinelFilter, expCtx, extensionsCallback, allowedFeatures);
+    std::swap(sbeCompatible, expCtx->sbeCompatible);
+    if (!swRoot.isOK()) {
+        return swRoot.getStatus();
+    }
+
+    auto tmpl = std::make_shared<Template>();
+    tmpl->sbeCompatible = sbeCompatible;
+
+    auto root = MatchExpression::normalize(std::move(swRoot.getValue()));
+    if (!isCacheableNode(*root)) {
+        return {std::move(tmpl)};
+    }
+
+    // Each sentinel must have survived normalization in exactly one comparison leaf.
+    std::vector<ComparisonMatchExpression*> leaves;
+    collectComparisonLeaves(root.get(), &leaves);
+    for (auto&& sentinel : sentinels) {
+        boost::optional<size_t> slotLeaf;
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            const auto& data = leaves[i]->getData();
+            if (data.type() == sentinel.type() && data.binaryEqualValues(sentinel)) {
+                if (slotLeaf) {
+                    return {std::move(tmpl)};
+                }
+                slotLeaf = i;
+            }
+        }
+        if (!slotLeaf) {
+            return {std::move(tmpl)};
+        }
+        tmpl->slotLeaves.push_back(*slotLeaf);
+    }
+
+    // The cached tree must not reference the collator of the ExpressionContext it was parsed with,
+    // nor the sentinel filter beyond the lifetime of the template.
+    root->setCollator(nullptr);
+    setInBackingBSON(root.get(), sentinelFilter);
+    tmpl->root = std::move(root);
+    return {std::move(tmpl)};
+}
+
+std::unique_ptr<MatchExpression> FilterParseCache::_instantiate(
+    const Template& tmpl,
+    const BSONObj& backingFilter,
+    const std::vector<BSONElement>& params,
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto root = tmpl.root->shallowClone();
+
+    std::vector<ComparisonMatchExpression*> leaves;
+    collectComparisonLeaves(root.get(), &leaves);
+    invariant(tmpl.slotLeaves.size() == params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+        leaves[tmpl.slotLeaves[i]]->setData(backingFilter, params[i]);
+    }
+
+    root->setCollator(expCtx->getCollator());
+    if (!tmpl.sbeCompatible) {
+        expCtx->sbeCompatible = false;
+    }
+    return root;
+}
+
+std::shared_ptr<const FilterParseCache::Template> FilterParseCache::_lookup(
+    StringMapHashedKey key) {
+    auto& partition = _partitionFor(key);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.index.find(key);
+    if (it == partition.index.end()) {
+        return nullptr;
+    }
+    partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+    return it->second->tmpl;
+}
+
+void FilterParseCache::_insert(StringMapHashedKey key, std::shared_ptr<const Template> tmpl) {
+    auto maxEntries = _maxEntriesPerPartition();
+    auto& partition = _partitionFor(key);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+
+    // Another thread may have built a template for the same shape concurrently.
+    if (auto it = partition.index.find(key); it != partition.index.end()) {
+        partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+        return;
+    }
+
+    partition.entries.emplace_front(std::string{key.key()}, std::move(tmpl));
+    partition.index.emplace(StringData(partition.entries.front().key),
+                            partition.entries.begin());
+
+    while (partition.entries.size() > maxEntries) {
+        partition.index.erase(StringData(partition.entries.back().key));
+        partition.entries.pop_back();
+    }
+}
+
+void FilterParseCache::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.index.clear();
+        partition.entries.clear();
+    }
+}
+
+size_t FilterParseCache::size() const {
+    size_t total = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        total += partition.entries.size();
+    }
+    return total;
+}
+
+}  // namespace mongo
@@ -0,0 +1,171 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * A bounded cache of parsed and normalized MatchExpression trees, keyed by the shape of the filter
+ * they were parsed from.
+ *
+ * The shape of a filter is the filter itself with the constant operand of each simple comparison
+ * ($eq, $lt, $lte, $gt, $gte, or an implicit equality) replaced by a placeholder for its type. Two
+ * filters which only differ in the values of such constants share a cached template. On a cache
+ * hit, the template is cloned and the constants of the incoming filter are bound into the
+ * comparison leaves of the clone, which avoids re-running the parser and the optimization and
+ * sorting passes of MatchExpression::normalize().
+ *
+ * A template is built by parsing the shape with a unique sentinel constant in each parameter
+ * position, then locating each sentinel among the comparison leaves of the normalized tree. Shapes
+ * for which normalization does not keep every parameter in exactly one comparison leaf, or whose
+ * tree contains node types that capture state from the ExpressionContext ($expr, $where, $text,
+ * geo, JSON Schema), are remembered as uncacheable and are always parsed from scratch.
+ *
+ * The cache is partitioned by key hash, each partition being protected by its own mutex and
+ * holding at most 'internalQueryFilterParseCacheMaxEntries / kNumPartitions' shapes. Setting the
+ * parameter to 0 disables the cache.
+ */
+class FilterParseCache {
+    FilterParseCache(const FilterParseCache&) = delete;
+    FilterParseCache& operator=(const FilterParseCache&) = delete;
+
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    static FilterParseCache& get(ServiceContext* service);
+
+    FilterParseCache() = default;
+
+    /**
+     * Returns the MatchExpression for 'filter', with the same semantics as
+     * MatchExpressionParser::parse(). If the tree was instantiated from a cached template it is
+     * already normalized and '*isNormalized' is set to true; otherwise the result of a regular
+     * parse is returned and '*isNormalized' is set to false.
+     *
+     * Unlike MatchExpressionParser::parse(), the returned tree may reference the buffer of
+     * 'filter', and shares ownership of it if 'filter' is owned.
+     */
+    StatusWithMatchExpression parse(const BSONObj& filter,
+                                    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                    const ExtensionsCallback& extensionsCallback,
+                                    MatchExpressionParser::AllowedFeatureSet allowedFeatures,
+                                    bool* isNormalized);
+
+    /**
+     * Removes all cached templates.
+     */
+    void clear();
+
+    /**
+     * Returns the number of shapes currently cached, including the ones marked as uncacheable.
+     */
+    size_t size() const;
+
+private:
+    /**
+     * A normalized tree whose comparison leaves hold sentinel constants. 'slotLeaves[i]' is the
+     * pre-order position, among the comparison leaves of 'root', of the leaf holding parameter i.
+     * A null 'root' marks a shape which cannot be served from the cache.
+     */
+    struct Template {
+        std::unique_ptr<MatchExpression> root;
+        std::vector<size_t> slotLeaves;
+        bool sbeCompatible = true;
+    };
+
+    struct Entry {
+        Entry(std::string key, std::shared_ptr<const Template> tmpl)
+            : key(std::move(key)), tmpl(std::move(tmpl)) {}
+
+        std::string key;
+        std::shared_ptr<const Template> tmpl;
+    };
+
+    /**
+     * A single LRU-ordered shard of the cache. The keys of 'index' are views of the keys owned by
+     * the list nodes.
+     */
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("FilterParseCache::Partition::mutex");
+        std::list<Entry> entries;
+        StringDataMap<std::list<Entry>::iterator> index;
+    };
+
+    static size_t _maxEntriesPerPartition();
+
+    /**
+     * Parses 'sentinelFilter' and turns the result into a template for a shape with 'numParams'
+     * parameters. Returns a non-OK status if the sentinel filter fails to parse.
+     */
+    static StatusWith<std::shared_ptr<const Template>> _buildTemplate(
+        const BSONObj& sentinelFilter,
+        const std::vector<BSONElement>& sentinels,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const ExtensionsCallback& extensionsCallback,
+        MatchExpressionParser::AllowedFeatureSet allowedFeatures);
+
+    /**
+     * Clones 'tmpl' and binds 'params', which must be elements of 'backingFilter', into the
+     * comparison leaves of the clone.
+     */
+    static std::unique_ptr<MatchExpression> _instantiate(
+        const Template& tmpl,
+        const BSONObj& backingFilter,
+        const std::vector<BSONElement>& params,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    std::shared_ptr<const Template> _lookup(StringMapHashedKey key);
+    void _insert(StringMapHashedKey key, std::shared_ptr<const Template> tmpl);
+
+    Partition& _partitionFor(const StringMapHashedKey& key) {
+        return _partitions[key.hash() % kNumPartitions];
+    }
+
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
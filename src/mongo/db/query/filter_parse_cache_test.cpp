@@ -0,0 +1,207 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/filter_parse_cache.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class FilterParseCacheTest : public unittest::Test {
+protected:
+    std::unique_ptr<MatchExpression> parse(const BSONObj& filter, bool* isNormalized) {
+        return uassertStatusOK(
+            _cache.parse(filter, _expCtx, ExtensionsCallbackNoop(), kAllowed, isNormalized));
+    }
+
+    std::unique_ptr<MatchExpression> parseAndNormalize(const BSONObj& filter) {
+        bool isNormalized;
+        auto expr = parse(filter, &isNormalized);
+        return isNormalized ? std::move(expr) : MatchExpression::normalize(std::move(expr));
+    }
+
+    std::unique_ptr<MatchExpression> parseUncached(const BSONObj& filter) {
+        return MatchExpression::normalize(uassertStatusOK(
+            MatchExpressionParser::parse(filter, _expCtx, ExtensionsCallbackNoop(), kAllowed)));
+    }
+
+    void assertSameAsUncached(const BSONObj& filter) {
+        auto cached = parseAndNormalize(filter);
+        auto uncached = parseUncached(filter);
+        ASSERT_TRUE(cached->equivalent(uncached.get()))
+            << "cached: " << cached->debugString() << " uncached: " << uncached->debugString();
+    }
+
+    static constexpr auto kAllowed = MatchExpressionParser::kDefaultSpecialFeatures;
+
+    FilterParseCache _cache;
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx =
+        make_intrusive<ExpressionContextForTest>();
+};
+
+TEST_F(FilterParseCacheTest, FiltersWithSameShapeShareTemplate) {
+    bool isNormalized;
+    parse(fromjson("{a: 1, b: {$gt: 'x', $lte: 'y'}}"), &isNormalized);
+    ASSERT_TRUE(isNormalized);
+    ASSERT_EQ(_cache.size(), 1U);
+
+    auto expr = parse(fromjson("{a: 2, b: {$gt: 'm', $lte: 'n'}}"), &isNormalized);
+    ASSERT_TRUE(isNormalized);
+    ASSERT_EQ(_cache.size(), 1U);
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 2, b: 'mm'}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 1, b: 'mm'}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 2, b: 'z'}")));
+    assertSameAsUncached(fromjson("{a: 2, b: {$gt: 'm', $lte: 'n'}}"));
+}
+
+TEST_F(FilterParseCacheTest, ParameterTypeIsPartOfShape) {
+    bool isNormalized;
+    parse(fromjson("{a: 1}"), &isNormalized);
+    parse(fromjson("{a: 'str'}"), &isNormalized);
+    parse(BSON("a" << 1.5), &isNormalized);
+    parse(BSON("a" << 2LL), &isNormalized);
+    ASSERT_EQ(_cache.size(), 4U);
+}
+
+TEST_F(FilterParseCacheTest, InstantiatedTreeMatchesUncachedParse) {
+    std::vector<BSONObj> filters{
+        fromjson("{$or: [{a: 1}, {b: {$lt: 5}}], c: {$in: [1, 2, 3]}}"),
+        fromjson("{$and: [{a: {$gte: 1}}, {a: {$lt: 10}}], b: {$exists: true}}"),
+        fromjson("{a: {$elemMatch: {b: 1, c: {$gt: 2}}}, d: {$size: 2}}"),
+        fromjson("{$nor: [{a: 'x'}], b: {$not: {$gt: 3}}, c: {$type: 'string'}}"),
+        fromjson("{a: {$in: [7]}, b: /^abc/, c: {$mod: [4, 1]}}"),
+        BSON("a" << OID() << "b" << Date_t::fromMillisSinceEpoch(5) << "c" << Timestamp(1, 2)),
+    };
+    for (auto&& filter : filters) {
+        assertSameAsUncached(filter);
+        assertSameAsUncached(filter);
+    }
+}
+
+TEST_F(FilterParseCacheTest, UncacheableShapeFallsBackToParser) {
+    bool isNormalized;
+    auto filter = fromjson("{$expr: {$eq: ['$a', 1]}, b: 1}");
+    parse(filter, &isNormalized);
+    ASSERT_FALSE(isNormalized);
+    ASSERT_EQ(_cache.size(), 1U);
+
+    parse(filter, &isNormalized);
+    ASSERT_FALSE(isNormalized);
+    assertSameAsUncached(filter);
+}
+
+TEST_F(FilterParseCacheTest, ParseErrorIsReturnedAndNotCached) {
+    bool isNormalized;
+    auto status = _cache.parse(fromjson("{a: {$gt: 1, $notAnOperator: 2}}"),
+                               _expCtx,
+                               ExtensionsCallbackNoop(),
+                               kAllowed,
+                               &isNormalized);
+    ASSERT_NOT_OK(status.getStatus());
+    ASSERT_EQ(_cache.size(), 0U);
+}
+
+TEST_F(FilterParseCacheTest, InstantiatedTreeUsesCollatorOfCaller) {
+    bool isNormalized;
+    parse(fromjson("{a: 'abc'}"), &isNormalized);
+
+    _expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual));
+    auto expr = parse(fromjson("{a: 'xyz'}"), &isNormalized);
+    ASSERT_TRUE(isNormalized);
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'abc'}")));
+}
+
+TEST_F(FilterParseCacheTest, CollationIsPartOfShape) {
+    // Under this collator the two strings are duplicates, so the $in is normalized to an equality.
+    auto filter = fromjson("{a: {$in: ['A', 'a']}}");
+    _expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    bool isNormalized;
+    auto expr = parse(filter, &isNormalized);
+    ASSERT_TRUE(isNormalized);
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'A'}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'a'}")));
+
+    // Under the simple collation the same filter must still match both strings.
+    _expCtx->setCollator(nullptr);
+    expr = parse(filter, &isNormalized);
+    ASSERT_TRUE(isNormalized);
+    ASSERT_EQ(_cache.size(), 2U);
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'A'}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'a'}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 'b'}")));
+    assertSameAsUncached(filter);
+}
+
+TEST_F(FilterParseCacheTest, InstantiatedTreeOutlivesCacheAndFilter) {
+    bool isNormalized;
+    parse(fromjson("{a: {$in: [1, 2]}, b: 'x'}"), &isNormalized);
+
+    std::unique_ptr<MatchExpression> expr;
+    {
+        auto filter = fromjson("{a: {$in: [1, 2]}, b: 'y'}");
+        expr = parse(filter, &isNormalized);
+        ASSERT_TRUE(isNormalized);
+    }
+    _cache.clear();
+    ASSERT_EQ(_cache.size(), 0U);
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 2, b: 'y'}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 2, b: 'x'}")));
+}
+
+TEST_F(FilterParseCacheTest, CacheIsBoundedByMaxEntries) {
+    RAIIServerParameterControllerForTest controller(
+        "internalQueryFilterParseCacheMaxEntries",
+        static_cast<int>(FilterParseCache::kNumPartitions));
+    bool isNormalized;
+    for (int i = 0; i < 200; ++i) {
+        parse(BSON(("field" + std::to_string(i)) << 1), &isNormalized);
+    }
+    ASSERT_LTE(_cache.size(), FilterParseCache::kNumPartitions);
+}
+
+TEST_F(FilterParseCacheTest, ZeroMaxEntriesDisablesCache) {
+    RAIIServerParameterControllerForTest controller("internalQueryFilterParseCacheMaxEntries", 0);
+    bool isNormalized;
+    parse(fromjson("{a: 1}"), &isNormalized);
+    ASSERT_FALSE(isNormalized);
+    ASSERT_EQ(_cache.size(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
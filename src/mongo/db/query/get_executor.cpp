@@ -293,6 +293,15 @@ void fillOutPlannerParams(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (ice->descriptor()->hidden())
             continue;
+
+        // Column store indexes cannot be scanned by key, so they are kept apart from the indexes
+        // which the planner considers for index scans.
+        if (indexType == IndexType::INDEX_COLUMN) {
+            plannerParams->columnStoreIndexes.push_back(
+                indexEntryFromIndexCatalogEntry(opCtx, collection, *ice, canonicalQuery));
+            continue;
+        }
+
         plannerParams->indices.push_back(
             indexEntryFromIndexCatalogEntry(opCtx, collection, *ice, canonicalQuery));
     }
@@ -1168,6 +1177,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
 
 // Checks if the given query can be executed with the SBE engine.
 inline bool isQuerySbeCompatible(OperationContext* opCtx,
+                                 const CollectionPtr* collection,
                                  const CanonicalQuery* const cq,
                                  size_t plannerOptions) {
     invariant(cq);
@@ -1188,9 +1198,22 @@ inline bool isQuerySbeCompatible(OperationContext* opCtx,
 
     // Queries against a time-series collection are not currently supported by SBE.
     const bool isQueryNotAgainstTimeseriesCollection = !(cq->nss().isTimeseriesBucketsCollection());
-    return allExpressionsSupported && isNotCount && doesNotContainMetadataRequirements &&
-        doesNotNeedEnsureSorted && isQueryNotAgainstTimeseriesCollection &&
-        doesNotSortOnMetaOrPathWithNumericComponents && isNotOplog;
+
+    if (!(allExpressionsSupported && isNotCount && doesNotContainMetadataRequirements &&
+          doesNotNeedEnsureSorted && isQueryNotAgainstTimeseriesCollection &&
+          doesNotSortOnMetaOrPathWithNumericComponents && isNotOplog)) {
+        return false;
+    }
+
+    // Column store indexes are only read by the classic COLUMN_SCAN stage. Finding them walks the
+    // index catalog, so this is only checked once the query is otherwise known to be supported.
+    if (!collection || !*collection) {
+        return true;
+    }
+    std::vector<const IndexDescriptor*> columnStoreIndexes;
+    (*collection)->getIndexCatalog()->findIndexByType(
+        opCtx, IndexNames::COLUMN, columnStoreIndexes);
+    return columnStoreIndexes.empty();
 }
 }  // namespace
 
@@ -1201,7 +1224,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutor(
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
     return canonicalQuery->getEnableSlotBasedExecutionEngine() &&
-            isQuerySbeCompatible(opCtx, canonicalQuery.get(), plannerOptions)
+            isQuerySbeCompatible(opCtx, collection, canonicalQuery.get(), plannerOptions)
         ? getSlotBasedExecutor(
               opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions)
         : getClassicExecutor(
@@ -2142,8 +2165,9 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
         const IndexCatalogEntry* ice = ii->next();
         const IndexDescriptor* desc = ice->descriptor();
 
-        // Skip the addition of hidden indexes to prevent use in query planning.
-        if (desc->hidden())
+        // Skip the addition of hidden indexes to prevent use in query planning. Column store
+        // indexes cannot provide a DISTINCT_SCAN.
+        if (desc->hidden() || desc->getIndexType() == IndexType::INDEX_COLUMN)
             continue;
         if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
             if (!mayUnwindArrays &&
@@ -35,6 +35,7 @@
 
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/idhack.h"
@@ -65,7 +66,11 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
 
     // Some leaf nodes also provide info about the index they used.
     const SpecificStats* specific = stage->getSpecificStats();
-    if (STAGE_COUNT_SCAN == stage->stageType()) {
+    if (STAGE_COLUMN_SCAN == stage->stageType()) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
+    } else if (STAGE_COUNT_SCAN == stage->stageType()) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
@@ -150,6 +155,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->keysExamined;
     }
 
     return 0;
@@ -172,6 +180,9 @@ size_t getDocsExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_TEXT_OR == type) {
         const TextOrStats* spec = static_cast<const TextOrStats*>(specific);
         return spec->fetches;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->docsFetched;
     }
 
     return 0;
@@ -265,6 +276,16 @@ void statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", static_cast<long long>(spec->docsTested));
         }
+    } else if (STAGE_COLUMN_SCAN == stats.stageType) {
+        ColumnScanStats* spec = static_cast<ColumnScanStats*>(stats.specific.get());
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", static_cast<long long>(spec->keysExamined));
+            bob->appendNumber("docsAssembled", static_cast<long long>(spec->docsAssembled));
+            bob->appendNumber("docsFetched", static_cast<long long>(spec->docsFetched));
+            bob->appendNumber("docsTested", static_cast<long long>(spec->docsTested));
+        }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -680,6 +701,11 @@ void PlanExplainerImpl::getSummaryStats(PlanSummaryStats* statsOut) const {
             const IndexScanStats* ixscanStats =
                 static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
             statsOut->indexesUsed.insert(ixscanStats->indexName);
+        } else if (STAGE_COLUMN_SCAN == stages[i]->stageType()) {
+            const ColumnScan* columnScan = static_cast<const ColumnScan*>(stages[i]);
+            const ColumnScanStats* columnScanStats =
+                static_cast<const ColumnScanStats*>(columnScan->getSpecificStats());
+            statsOut->indexesUsed.insert(columnScanStats->indexName);
         } else if (STAGE_COUNT_SCAN == stages[i]->stageType()) {
             const CountScan* countScan = static_cast<const CountScan*>(stages[i]);
             const CountScanStats* countScanStats =
@@ -45,6 +45,7 @@
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
@@ -348,6 +349,86 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
     return csn;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeColumnScan(
+    const CanonicalQuery& query, const QueryPlannerParams& params) {
+    if (params.columnStoreIndexes.empty()) {
+        return nullptr;
+    }
+
+    // The assembled documents carry no RecordId, index keys or metadata, and hold none of the
+    // fields a shard filter would need.
+    const auto& findCommand = query.getFindCommandRequest();
+    if (findCommand.getTailable() || findCommand.getShowRecordId() ||
+        findCommand.getReturnKey() || findCommand.getRequestResumeToken() ||
+        !findCommand.getHint().isEmpty() || !findCommand.getMin().isEmpty() ||
+        !findCommand.getMax().isEmpty() || query.metadataDeps().any() ||
+        (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER)) {
+        return nullptr;
+    }
+
+    // Only an inclusion projection bounds the set of paths the query returns.
+    const auto* proj = query.getProj();
+    if (!proj || !proj->isInclusionOnly()) {
+        return nullptr;
+    }
+
+    if (QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) ||
+        QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        return nullptr;
+    }
+
+    DepsTracker deps;
+    query.root()->addDependencies(&deps);
+    if (deps.needWholeDocument) {
+        return nullptr;
+    }
+    std::set<std::string> requiredFields = std::move(deps.fields);
+    requiredFields.insert(proj->getRequiredFields().begin(), proj->getRequiredFields().end());
+
+    if (const auto& sortPattern = query.getSortPattern()) {
+        for (auto&& part : *sortPattern) {
+            if (!part.fieldPath) {
+                return nullptr;
+            }
+            requiredFields.insert(part.fieldPath->fullPath());
+        }
+    }
+
+    // A field is covered by an index path if the path is the field itself or one of its
+    // prefixes, since each cell holds the whole value at its path.
+    auto coversField = [](const IndexEntry& index, StringData field) {
+        for (auto&& elem : index.keyPattern) {
+            StringData path = elem.fieldNameStringData();
+            if (field == path ||
+                (field.startsWith(path) && field.size() > path.size() &&
+                 field[path.size()] == '.')) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Read as few columns as possible.
+    const IndexEntry* bestIndex = nullptr;
+    for (auto&& index : params.columnStoreIndexes) {
+        const bool coversQuery =
+            std::all_of(requiredFields.begin(), requiredFields.end(), [&](const auto& field) {
+                return coversField(index, field);
+            });
+        if (coversQuery &&
+            (!bestIndex || index.keyPattern.nFields() < bestIndex->keyPattern.nFields())) {
+            bestIndex = &index;
+        }
+    }
+    if (!bestIndex) {
+        return nullptr;
+    }
+
+    auto csn = std::make_unique<ColumnScanNode>(*bestIndex);
+    csn->filter = query.root()->shallowClone();
+    return csn;
+}
+
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeLeafNode(
     const CanonicalQuery& query,
     const IndexEntry& index,
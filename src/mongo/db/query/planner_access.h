@@ -104,6 +104,14 @@ public:
                                                                  bool tailable,
                                                                  const QueryPlannerParams& params);
 
+    /**
+     * Return a ColumnScanNode over one of the column store indexes in 'params' if the filter,
+     * projection and sort of 'query' only depend on the paths of that index. Otherwise returns
+     * nullptr.
+     */
+    static std::unique_ptr<QuerySolutionNode> makeColumnScan(const CanonicalQuery& query,
+                                                             const QueryPlannerParams& params);
+
     /**
      * Return a plan that uses the provided index as a proxy for a collection scan.
      */
@@ -589,6 +589,10 @@ bool QueryPlannerIXSelect::_compatible(const BSONElement& keyPatternElt,
         return (exprtype == MatchExpression::TEXT);
     } else if (IndexNames::GEO_HAYSTACK == indexedFieldType) {
         return false;
+    } else if (IndexNames::COLUMN == indexedFieldType) {
+        // Column store indexes are ordered by path and RecordId rather than by value, so they
+        // cannot provide index bounds. They are only used by a COLUMN_SCAN.
+        return false;
     } else {
         LOGV2_WARNING(20954,
                       "Unknown indexing for given node and field",
@@ -328,6 +328,15 @@ std::unique_ptr<QuerySolution> buildCollscanSoln(const CanonicalQuery& query,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    std::unique_ptr<QuerySolutionNode> solnRoot(QueryPlannerAccess::makeColumnScan(query, params));
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
                                                 const CanonicalQuery& query,
                                                 const QueryPlannerParams& params,
@@ -1095,6 +1104,21 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collScanRequired = 0 == out.size();
+
+    // A column store index which holds every path the query depends on answers it by reading
+    // only those paths, instead of whole documents. Such a solution is not cached, since it is
+    // only chosen when there is no alternative to compete with.
+    if (collScanRequired && !collscanRequested) {
+        if (auto columnScan = buildColumnScanSoln(query, params)) {
+            LOGV2_DEBUG(5962103,
+                        5,
+                        "Planner: outputting a column scan",
+                        "columnScan"_attr = redact(columnScan->toString()));
+            out.push_back(std::move(columnScan));
+            return {std::move(out)};
+        }
+    }
+
     if (collScanRequired && !canTableScan) {
         return Status(ErrorCodes::NoQueryExecutionPlans,
                       "No indexed plans available, and running with 'notablescan'");
@@ -0,0 +1,179 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A specialization of the QueryPlannerTest fixture which presents the planner with column store
+ * indexes, which are kept apart from the indexes considered for index scans.
+ */
+class QueryPlannerColumnStoreTest : public QueryPlannerTest {
+protected:
+    void addColumnStoreIndex(BSONObj keyPattern, StringData name) {
+        params.columnStoreIndexes.push_back({keyPattern,
+                                             INDEX_COLUMN,
+                                             IndexDescriptor::kLatestIndexVersion,
+                                             false,  // multikey
+                                             {},
+                                             {},
+                                             false,  // sparse
+                                             false,  // unique
+                                             IndexEntry::Identifier{name.toString()},
+                                             nullptr,  // filterExpr
+                                             BSONObj(),
+                                             nullptr,
+                                             nullptr});
+    }
+};
+
+TEST_F(QueryPlannerColumnStoreTest, ColumnScanAnswersQueryOnIndexedPaths) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"
+                             << "b"
+                             << "columnstore"),
+                        "a_b_columnstore");
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1, b: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: {column_scan: {name: 'a_b_columnstore', "
+        "filter: {a: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, ColumnScanCoversFieldsBelowAnIndexedPath) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{'a.b': 1}"), BSONObj(), fromjson("{_id: 0, 'a.c': 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, 'a.c': 1}, node: {column_scan: {name: 'a_columnstore', "
+        "filter: {'a.b': 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, ColumnScanReadsTheIndexWithTheFewestPaths) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"
+                             << "b"
+                             << "columnstore"
+                             << "c"
+                             << "columnstore"),
+                        "a_b_c_columnstore");
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{a: {$gt: 1}}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {column_scan: {name: 'a_columnstore', "
+        "filter: {a: {$gt: 1}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoColumnScanWhenProjectionNeedsAnUnindexedPath) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    // The projection implicitly includes '_id'.
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1, b: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoColumnScanWhenFilterNeedsAnUnindexedPath) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{a: 1, b: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoColumnScanWithoutAnInclusionProjection) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuery(fromjson("{a: 1}"));
+    assertHasOnlyCollscan();
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{b: 0}"));
+    assertHasOnlyCollscan();
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoColumnScanWhenSortNeedsAnUnindexedPath) {
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{a: 1}"), fromjson("{b: 1}"), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sort: {pattern: {b: 1}, limit: 0, node: "
+        "{cscan: {dir: 1, filter: {a: 1}}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, IndexedSolutionIsPreferredOverColumnScan) {
+    addIndex(BSON("a" << 1));
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {ixscan: {pattern: {a: 1}, bounds: {a: [[1, 1, true, "
+        "true]]}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoColumnScanWithShardFilter) {
+    params.options |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
+    params.shardKey = BSON("a" << 1);
+    addColumnStoreIndex(BSON("a"
+                             << "columnstore"),
+                        "a_columnstore");
+
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, a: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {sharding_filter: {node: "
+        "{cscan: {dir: 1, filter: {a: 1}}}}}}}");
+}
+
+}  // namespace
+}  // namespace mongo
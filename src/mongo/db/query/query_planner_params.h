@@ -131,6 +131,10 @@ struct QueryPlannerParams {
     // What indices are available for planning?
     std::vector<IndexEntry> indices;
 
+    // Column store indexes available for a COLUMN_SCAN. These are not part of 'indices', since
+    // they cannot be used for index scans.
+    std::vector<IndexEntry> columnStoreIndexes;
+
     // What's our shard key?  If INCLUDE_SHARD_FILTER is set we will create a shard filtering
     // stage.  If we know the shard key, we can perform covering analysis instead of always
     // forcing a fetch.
@@ -365,6 +365,48 @@ Status QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
 
         return filterMatches(filter.Obj(), collation, trueSoln)
             .withContext("mismatching 'filter' for 'cscan' node");
+    } else if (STAGE_COLUMN_SCAN == trueSoln->getType()) {
+        const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(trueSoln);
+        BSONElement el = testSoln["column_scan"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return {ErrorCodes::Error{5962406},
+                    "found a column scan in the solution but no corresponding 'column_scan' "
+                    "object in the provided JSON"};
+        }
+        BSONObj columnScanObj = el.Obj();
+        invariant(bsonObjFieldsAreInSet(columnScanObj, {"name", "filter"}));
+
+        BSONElement name = columnScanObj["name"];
+        if (name.type() != BSONType::String) {
+            return {ErrorCodes::Error{5962407},
+                    str::stream() << "Provided JSON gave a 'column_scan' without a string 'name': "
+                                  << columnScanObj};
+        }
+        if (name.valueStringData() != csn->index.identifier.catalogName) {
+            return {ErrorCodes::Error{5962408},
+                    str::stream() << "Provided JSON gave a 'column_scan' with a 'name' which did "
+                                     "not match. Expected: "
+                                  << name << " Found: " << csn->index.identifier.catalogName};
+        }
+
+        BSONElement filter = columnScanObj["filter"];
+        if (filter.eoo()) {
+            return Status::OK();
+        } else if (filter.isNull()) {
+            if (csn->filter == nullptr) {
+                return Status::OK();
+            }
+            return {ErrorCodes::Error{5962409},
+                    str::stream() << "Expected a column scan without a filter, but found a filter: "
+                                  << csn->filter->toString()};
+        } else if (!filter.isABSONObj()) {
+            return {ErrorCodes::Error{5962410},
+                    str::stream() << "Provided JSON gave a 'column_scan' with a 'filter', but the "
+                                     "filter was not an object."
+                                  << filter};
+        }
+        return filterMatches(filter.Obj(), BSONObj(), trueSoln)
+            .withContext("mismatching 'filter' for 'column_scan' node");
     } else if (STAGE_IXSCAN == trueSoln->getType()) {
         const IndexScanNode* ixn = static_cast<const IndexScanNode*>(trueSoln);
         BSONElement el = testSoln["ixscan"];
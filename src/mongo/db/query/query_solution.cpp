@@ -199,6 +199,45 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     return copy;
 }
 
+//
+// ColumnScanNode
+//
+
+ColumnScanNode::ColumnScanNode(IndexEntry index) : index(std::move(index)) {}
+
+void ColumnScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "indexName = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "keyPattern = " << index.keyPattern << '\n';
+    if (nullptr != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->debugString();
+    }
+    addCommon(ss, indent);
+}
+
+FieldAvailability ColumnScanNode::getFieldAvailability(const std::string& field) const {
+    // The assembled documents hold the whole value at each index path, and so everything below
+    // it.
+    for (auto&& elem : index.keyPattern) {
+        StringData path = elem.fieldNameStringData();
+        if (field == path || (field.size() > path.size() && StringData(field).startsWith(path) &&
+                              field[path.size()] == '.')) {
+            return FieldAvailability::kFullyProvided;
+        }
+    }
+    return FieldAvailability::kNotProvided;
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(index);
+    cloneBaseData(copy);
+    return copy;
+}
+
 //
 // VirtualScanNode
 //
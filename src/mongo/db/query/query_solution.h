@@ -454,6 +454,33 @@ struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
     bool stopApplyingFilterAfterFirstMatch = false;
 };
 
+/**
+ * Reads the columns of a column store index and assembles documents which hold only the index's
+ * paths. The planner only uses this node when the filter, projection and sort of the query
+ * depend on nothing but those paths.
+ */
+struct ColumnScanNode : public QuerySolutionNodeWithSortSet {
+    ColumnScanNode(IndexEntry index);
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const;
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    IndexEntry index;
+};
+
 /**
  * A VirtualScanNode is similar to a collection or an index scan except that it doesn't depend on an
  * underlying storage implementation. It can be used to represent a virtual
@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/regex_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/static_immortal.h"
+
+namespace mongo {
+namespace {
+
+Counter64 regexCacheHits;
+Counter64 regexCacheMisses;
+Counter64 regexCacheEvictions;
+
+ServerStatusMetricField<Counter64> regexCacheHitsMetric("query.regexCache.hits", &regexCacheHits);
+ServerStatusMetricField<Counter64> regexCacheMissesMetric("query.regexCache.misses",
+                                                          &regexCacheMisses);
+ServerStatusMetricField<Counter64> regexCacheEvictionsMetric("query.regexCache.evictions",
+                                                             &regexCacheEvictions);
+
+size_t maxEntriesPerPartition() {
+    auto maxEntries = internalQueryRegexCacheMaxEntries.load();
+    if (maxEntries <= 0) {
+        return 0;
+    }
+    return std::max(size_t{1}, static_cast<size_t>(maxEntries) / RegexCache::kNumPartitions);
+}
+
+}  // namespace
+
+CompiledRegex::CompiledRegex(const std::string& pattern, int options) {
+    const char* compileError;
+    int errorOffset;
+    _code = pcre_compile(pattern.c_str(), options, &compileError, &errorOffset, nullptr);
+    if (!_code) {
+        _error = compileError;
+        return;
+    }
+
+    // PCRE_STUDY_JIT_COMPILE is ignored when the library is built without JIT support, in which
+    // case only the regular study data is produced. A null result means that studying found
+    // nothing which would speed up matching, or failed; either way the pattern is still usable.
+    const char* studyError = nullptr;
+    _extra = pcre_study(_code, PCRE_STUDY_JIT_COMPILE, &studyError);
+
+    invariant(pcre_fullinfo(_code, _extra, PCRE_INFO_CAPTURECOUNT, &_numCaptures) == 0);
+}
+
+CompiledRegex::~CompiledRegex() {
+    if (_extra) {
+        pcre_free_study(_extra);
+    }
+    if (_code) {
+        (*pcre_free)(_code);
+    }
+}
+
+bool CompiledRegex::partialMatch(StringData input) const {
+    invariant(_code);
+    int ovector[3];
+    int rc = pcre_exec(_code,
+                       _extra,
+                       input.rawData() ? input.rawData() : "",
+                       input.size(),
+                       0,
+                       0,
+                       ovector,
+                       3);
+    return rc >= 0;
+}
+
+int CompiledRegex::execute(StringData input, int startPos, int* ovector, int ovectorSize) const {
+    invariant(_code);
+    return pcre_exec(_code,
+                     _extra,
+                     input.rawData() ? input.rawData() : "",
+                     input.size(),
+                     startPos,
+                     0,
+                     ovector,
+                     ovectorSize);
+}
+
+RegexCache& RegexCache::get() {
+    static StaticImmortal<RegexCache> cache;
+    return *cache;
+}
+
+std::shared_ptr<const CompiledRegex> RegexCache::getOrCompile(StringData pattern, int options) {
+    auto maxEntries = maxEntriesPerPartition();
+    if (maxEntries == 0) {
+        return std::make_shared<CompiledRegex>(pattern.toString(), options);
+    }
+
+    std::string key;
+    key.reserve(sizeof(options) + pattern.size());
+    key.append(reinterpret_cast<const char*>(&options), sizeof(options));
+    key.append(pattern.rawData(), pattern.size());
+    auto hashedKey = StringMapHasher{}.hashed_key(key);
+    auto& partition = _partitionFor(hashedKey);
+
+    {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (auto it = partition.index.find(hashedKey); it != partition.index.end()) {
+            partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+            regexCacheHits.increment();
+            return it->second->regex;
+        }
+    }
+
+    // Compile outside of the lock, so that an expensive pattern does not block lookups of other
+    // patterns in the same partition.
+    regexCacheMisses.increment();
+    auto regex = std::make_shared<const CompiledRegex>(pattern.toString(), options);
+    if (!regex->error().empty()) {
+        return regex;
+    }
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    if (auto it = partition.index.find(hashedKey); it != partition.index.end()) {
+        // Another thread compiled the same pattern concurrently.
+        partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+        return it->second->regex;
+    }
+
+    partition.entries.emplace_front(std::move(key), regex);
+    partition.index.emplace(StringData(partition.entries.front().key), partition.entries.begin());
+    while (partition.entries.size() > maxEntries) {
+        partition.index.erase(StringData(partition.entries.back().key));
+        partition.entries.pop_back();
+        regexCacheEvictions.increment();
+    }
+    return regex;
+}
+
+void RegexCache::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.index.clear();
+        partition.entries.clear();
+    }
+}
+
+size_t RegexCache::size() const {
+    size_t total = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        total += partition.entries.size();
+    }
+    return total;
+}
+
+}  // namespace mongo
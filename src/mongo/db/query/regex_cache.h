@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <list>
+#include <memory>
+#include <pcre.h>
+#include <string>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+/**
+ * An immutable compiled PCRE pattern. The pattern is studied when it is compiled, which builds
+ * the JIT-compiled form of the pattern when the PCRE library has JIT support, and otherwise
+ * precomputes data such as the set of possible starting bytes for unanchored matches.
+ *
+ * Matching does not modify the compiled pattern, so a single instance can be used concurrently by
+ * any number of threads.
+ */
+class CompiledRegex {
+    CompiledRegex(const CompiledRegex&) = delete;
+    CompiledRegex& operator=(const CompiledRegex&) = delete;
+
+public:
+    /**
+     * Compiles 'pattern' with the PCRE option bits 'options'. If the pattern fails to compile,
+     * error() returns a description of the failure and the instance must not be used for matching.
+     */
+    CompiledRegex(const std::string& pattern, int options);
+
+    ~CompiledRegex();
+
+    const std::string& error() const {
+        return _error;
+    }
+
+    /**
+     * Returns true if 'input' contains a match of the pattern, with the semantics of
+     * pcrecpp::RE::PartialMatch().
+     */
+    bool partialMatch(StringData input) const;
+
+    /**
+     * Wrapper for pcre_exec(), matching 'input' starting at byte offset 'startPos'. Returns the
+     * result of pcre_exec(): the number of captured substrings plus one on a match, -1 if there is
+     * no match, 0 if 'ovector' is too small, and any other negative value on error.
+     */
+    int execute(StringData input, int startPos, int* ovector, int ovectorSize) const;
+
+    /**
+     * Returns the number of capture groups in the pattern.
+     */
+    int numCaptures() const {
+        return _numCaptures;
+    }
+
+private:
+    std::string _error;
+    pcre* _code = nullptr;
+    pcre_extra* _extra = nullptr;
+    int _numCaptures = 0;
+};
+
+/**
+ * A process-wide, bounded cache of compiled regular expressions keyed by pattern and PCRE option
+ * bits. It is shared by the $regex match expression, the $regexMatch/$regexFind/$regexFindAll
+ * aggregation expressions and the regex builtins of the SBE VM, so that applications which send a
+ * small set of patterns repeatedly compile each of them only once.
+ *
+ * The cache is partitioned by key hash and evicts the least recently used pattern of a partition
+ * once it holds more than 'internalQueryRegexCacheMaxEntries / kNumPartitions' patterns. Evicted
+ * patterns remain valid for as long as a caller holds a reference to them. Patterns which fail to
+ * compile are not cached. Setting the parameter to 0 disables caching.
+ */
+class RegexCache {
+    RegexCache(const RegexCache&) = delete;
+    RegexCache& operator=(const RegexCache&) = delete;
+
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    static RegexCache& get();
+
+    RegexCache() = default;
+
+    /**
+     * Returns the compiled form of 'pattern' with the PCRE option bits 'options', compiling it if
+     * it is not in the cache. The caller must check error() on the result.
+     */
+    std::shared_ptr<const CompiledRegex> getOrCompile(StringData pattern, int options);
+
+    /**
+     * Removes all cached patterns.
+     */
+    void clear();
+
+    /**
+     * Returns the number of patterns currently cached.
+     */
+    size_t size() const;
+
+private:
+    struct Entry {
+        Entry(std::string key, std::shared_ptr<const CompiledRegex> regex)
+            : key(std::move(key)), regex(std::move(regex)) {}
+
+        std::string key;
+        std::shared_ptr<const CompiledRegex> regex;
+    };
+
+    /**
+     * A single LRU-ordered shard of the cache. The keys of 'index' are views of the keys owned by
+     * the list nodes.
+     */
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("RegexCache::Partition::mutex");
+        std::list<Entry> entries;
+        StringDataMap<std::list<Entry>::iterator> index;
+    };
+
+    Partition& _partitionFor(const StringMapHashedKey& key) {
+        return _partitions[key.hash() % kNumPartitions];
+    }
+
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/regex_cache.h"
+
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class RegexCacheTest : public unittest::Test {
+protected:
+    RegexCache _cache;
+};
+
+TEST_F(RegexCacheTest, CompiledRegexMatchesLikePartialMatch) {
+    CompiledRegex regex("^ab+c", 0);
+    ASSERT_TRUE(regex.error().empty());
+    ASSERT_TRUE(regex.partialMatch("abbbcd"));
+    ASSERT_FALSE(regex.partialMatch("xabc"));
+    ASSERT_FALSE(regex.partialMatch(""));
+
+    CompiledRegex unanchored("b+c", 0);
+    ASSERT_TRUE(unanchored.partialMatch("xabc"));
+}
+
+TEST_F(RegexCacheTest, CompiledRegexMatchesPastEmbeddedNullBytes) {
+    CompiledRegex regex("b$", 0);
+    ASSERT_TRUE(regex.partialMatch(StringData("a\0b", 3)));
+}
+
+TEST_F(RegexCacheTest, CompiledRegexReportsCaptures) {
+    CompiledRegex regex("(a)(b)?", 0);
+    ASSERT_EQ(regex.numCaptures(), 2);
+
+    std::vector<int> ovector(9);
+    ASSERT_EQ(regex.execute("xa", 0, ovector.data(), ovector.size()), 2);
+    ASSERT_EQ(ovector[0], 1);
+    ASSERT_EQ(ovector[1], 2);
+    ASSERT_EQ(regex.execute("xyz", 0, ovector.data(), ovector.size()), -1);
+}
+
+TEST_F(RegexCacheTest, InvalidPatternReportsErrorAndIsNotCached) {
+    auto regex = _cache.getOrCompile("(unclosed", 0);
+    ASSERT_FALSE(regex->error().empty());
+    ASSERT_EQ(_cache.size(), 0U);
+}
+
+TEST_F(RegexCacheTest, SamePatternAndOptionsShareCompiledRegex) {
+    auto first = _cache.getOrCompile("abc", 0);
+    auto second = _cache.getOrCompile("abc", 0);
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(_cache.size(), 1U);
+
+    auto caseless = _cache.getOrCompile("abc", PCRE_CASELESS);
+    ASSERT_NE(first.get(), caseless.get());
+    ASSERT_TRUE(caseless->partialMatch("ABC"));
+    ASSERT_FALSE(first->partialMatch("ABC"));
+    ASSERT_EQ(_cache.size(), 2U);
+}
+
+TEST_F(RegexCacheTest, EvictedRegexRemainsUsable) {
+    RAIIServerParameterControllerForTest controller("internalQueryRegexCacheMaxEntries",
+                                                    static_cast<int>(RegexCache::kNumPartitions));
+    auto regex = _cache.getOrCompile("pattern0", 0);
+    for (int i = 1; i < 200; ++i) {
+        _cache.getOrCompile("pattern" + std::to_string(i), 0);
+    }
+    ASSERT_LTE(_cache.size(), RegexCache::kNumPartitions);
+    ASSERT_TRUE(regex->partialMatch("a pattern0"));
+}
+
+TEST_F(RegexCacheTest, ZeroMaxEntriesDisablesCache) {
+    RAIIServerParameterControllerForTest controller("internalQueryRegexCacheMaxEntries", 0);
+    auto first = _cache.getOrCompile("abc", 0);
+    auto second = _cache.getOrCompile("abc", 0);
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_EQ(_cache.size(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -1432,7 +1432,7 @@ public:
     void visit(const GeoNearMatchExpression* expr) final {}
 
     void visit(const InMatchExpression* expr) final {
-        auto equalities = expr->getEqualities();
+        const auto& equalities = expr->getEqualities();
 
         // Build an ArraySet for testing membership of the field in the equalities vector of the
         // InMatchExpression.
@@ -1460,14 +1460,20 @@ public:
             }
         }
 
+        // Rather than embedding the set in the plan as a constant, which would be deep-copied
+        // along with each clone of the plan, hand it over to the runtime environment, whose slot
+        // values are shared by all copies of the environment.
+        arrSetGuard.reset();
+        auto arrSetSlot = _context->state.env->registerSlot(
+            arrSetTag, arrSetVal, true /* owned */, _context->state.slotIdGenerator);
+
         const auto traversalMode = hasArray ? LeafTraversalMode::kArrayAndItsElements
                                             : LeafTraversalMode::kArrayElementsOnly;
 
         // If the InMatchExpression doesn't carry any regex patterns, we can just check if the value
         // in bound to the inputSlot is a member of the equalities set.
         if (expr->getRegexes().size() == 0) {
-            auto makePredicate = [&, arrSetTag = arrSetTag, arrSetVal = arrSetVal](
-                                     sbe::value::SlotId inputSlot,
+            auto makePredicate = [&](sbe::value::SlotId inputSlot,
                                      EvalStage inputStage) -> EvalExprStagePair {
                 // We have to match nulls and undefined if a 'null' is present in equalities.
                 auto inputExpr = !hasNull
@@ -1476,10 +1482,8 @@ public:
                                            makeConstant(sbe::value::TypeTags::Null, 0),
                                            makeVariable(inputSlot));
 
-                arrSetGuard.reset();
-                return {makeIsMember(std::move(inputExpr),
-                                     sbe::makeE<sbe::EConstant>(arrSetTag, arrSetVal),
-                                     _context->state.env),
+                return {makeIsMember(
+                            std::move(inputExpr), makeVariable(arrSetSlot), _context->state.env),
                         std::move(inputStage)};
             };
 
@@ -1511,7 +1515,7 @@ public:
             }
 
             auto makePredicate =
-                [&, arrSetTag = arrSetTag, arrSetVal = arrSetVal, arrTag = arrTag, arrVal = arrVal](
+                [&, arrTag = arrTag, arrVal = arrVal](
                     sbe::value::SlotId inputSlot, EvalStage inputStage) -> EvalExprStagePair {
                 auto regexArraySlot{_context->state.slotId()};
                 auto regexInputSlot{_context->state.slotId()};
@@ -1563,12 +1567,10 @@ public:
                                                makeConstant(sbe::value::TypeTags::Null, 0),
                                                makeVariable(inputSlot));
 
-                    arrSetGuard.reset();
-                    branches.emplace_back(
-                        makeIsMember(std::move(inputExpr),
-                                     sbe::makeE<sbe::EConstant>(arrSetTag, arrSetVal),
-                                     _context->state.env),
-                        EvalStage{});
+                    branches.emplace_back(makeIsMember(std::move(inputExpr),
+                                                       makeVariable(arrSetSlot),
+                                                       _context->state.env),
+                                          EvalStage{});
                     branches.emplace_back(regexOutputSlot, std::move(regexStage));
 
                     auto [shortCircuitingExpr, shortCircuitingStage] =
@@ -52,6 +52,10 @@ enum StageType {
     STAGE_CACHED_PLAN,
     STAGE_COLLSCAN,
 
+    // Assembles documents from the per-path columns of a column store index, falling back to the
+    // record store for documents the index does not cover.
+    STAGE_COLUMN_SCAN,
+
     // A virtual scan stage that simulates a collection scan and doesn't depend on underlying
     // storage.
     STAGE_VIRTUAL_SCAN,
@@ -58,6 +58,7 @@
 #include "mongo/db/catalog/local_oplog_info.h"
 #include "mongo/db/catalog/multi_index_block.h"
 #include "mongo/db/catalog/rename_collection.h"
+#include "mongo/db/catalog/truncate_range.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
@@ -1046,6 +1047,30 @@ const StringMap<ApplyOpMetadata> kOpsMap = {
               extractNsFromUUIDorNs(opCtx, entry.getNss(), entry.getUuid(), entry.getObject()));
       },
       {ErrorCodes::NamespaceNotFound}}},
+    {"truncateRange",
+     {[](OperationContext* opCtx, const OplogEntry& entry, OplogApplication::Mode mode) -> Status {
+          const auto& cmd = entry.getObject();
+          AutoGetCollection autoColl(
+              opCtx, extractNsFromUUIDorNs(opCtx, entry.getNss(), entry.getUuid(), cmd), MODE_IX);
+          if (!autoColl) {
+              return {ErrorCodes::NamespaceNotFound,
+                      str::stream() << "Failed to apply operation due to missing collection: "
+                                    << redact(cmd)};
+          }
+
+          WriteUnitOfWork wuow(opCtx);
+          auto result = truncateRange(opCtx,
+                                      autoColl.getCollection(),
+                                      RecordId::deserializeToken(cmd["minRecordId"]),
+                                      RecordId::deserializeToken(cmd["maxRecordId"]),
+                                      std::numeric_limits<int64_t>::max());
+          if (!result.isOK()) {
+              return result.getStatus();
+          }
+          wuow.commit();
+          return Status::OK();
+      },
+      {ErrorCodes::NamespaceNotFound}}},
     {"commitTransaction",
      {[](OperationContext* opCtx, const OplogEntry& entry, OplogApplication::Mode mode) -> Status {
          return applyCommitTransaction(opCtx, entry, mode);
@@ -51,6 +51,7 @@
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/idempotency_test_fixture.h"
@@ -365,6 +366,59 @@ TEST_F(OplogApplierImplTest, applyOplogEntryOrGroupedInsertsCommand) {
     ASSERT_TRUE(applyCmdCalled);
 }
 
+TEST_F(OplogApplierImplTest, applyOplogEntryOrGroupedInsertsTruncateRange) {
+    NamespaceString nss("test.t");
+    CollectionOptions options;
+    options.uuid = UUID::gen();
+    options.clusteredIndex = true;
+    ASSERT_OK(getStorageInterface()->createCollection(
+        _opCtx.get(), nss, options, false /* createIdIndex */));
+
+    std::vector<OID> ids;
+    for (int i = 0; i < 4; ++i) {
+        OID id;
+        id.init(Date_t::fromMillisSinceEpoch((i + 1) * 1000));
+        ids.push_back(id);
+        ASSERT_OK(getStorageInterface()->insertDocument(_opCtx.get(), nss, {BSON("_id" << id)}, 0));
+    }
+
+    // Truncate the range of the two documents in the middle.
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("truncateRange", nss.coll());
+    record_id_helpers::keyForOID(ids[1]).serializeToken("minRecordId", &cmdBuilder);
+    record_id_helpers::keyForOID(ids[2]).serializeToken("maxRecordId", &cmdBuilder);
+    auto op = BSON("op"
+                   << "c"
+                   << "ns" << nss.getCommandNS().ns() << "wall" << Date_t() << "o"
+                   << cmdBuilder.obj() << "o2" << BSON("numRecords" << 2) << "ts"
+                   << Timestamp(1, 1) << "ui" << *options.uuid);
+    auto entry = OplogEntry(op);
+    ASSERT_OK(_applyOplogEntryOrGroupedInsertsWrapper(
+        _opCtx.get(), &entry, OplogApplication::Mode::kSecondary));
+
+    ASSERT_TRUE(docExists(_opCtx.get(), nss, BSON("_id" << ids[0])));
+    ASSERT_FALSE(docExists(_opCtx.get(), nss, BSON("_id" << ids[1])));
+    ASSERT_FALSE(docExists(_opCtx.get(), nss, BSON("_id" << ids[2])));
+    ASSERT_TRUE(docExists(_opCtx.get(), nss, BSON("_id" << ids[3])));
+}
+
+TEST_F(OplogApplierImplTest, applyOplogEntryOrGroupedInsertsTruncateRangeCollectionMissing) {
+    NamespaceString nss("test.t");
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("truncateRange", nss.coll());
+    RecordId(1).serializeToken("minRecordId", &cmdBuilder);
+    RecordId(2).serializeToken("maxRecordId", &cmdBuilder);
+    auto op = BSON("op"
+                   << "c"
+                   << "ns" << nss.getCommandNS().ns() << "wall" << Date_t() << "o"
+                   << cmdBuilder.obj() << "ts" << Timestamp(1, 1) << "ui" << UUID::gen());
+    auto entry = OplogEntry(op);
+
+    // A missing collection is an acceptable error, as it may have been dropped later in the oplog.
+    ASSERT_OK(_applyOplogEntryOrGroupedInsertsWrapper(
+        _opCtx.get(), &entry, OplogApplication::Mode::kInitialSync));
+}
+
 /**
  * Test only subclass of OplogApplierImpl that does not apply oplog entries, but tracks ops.
  */
@@ -297,6 +297,7 @@ public:
         kCommitTransaction,
         kAbortTransaction,
         kImportCollection,
+        kTruncateRange,
     };
 
     // Get the in-memory size in bytes of a ReplOperation.
@@ -47,7 +47,9 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/tenant_migration_decoration.h"
 #include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/db/storage/recovery_unit_noop.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/util/concurrency/thread_pool.h"
 
@@ -357,6 +359,92 @@ TEST_F(OplogTest, ConcurrentLogOpRevertLastOplogEntry) {
     _checkOplogEntry(oplogEntries[0], *(opTimeNssMap.cbegin()));
 }
 
+TEST_F(OplogTest, ConcurrentGetNextOpTimesReservesDisjointContiguousRanges) {
+    const std::size_t kNumThreads = 8;
+    const std::size_t kNumReservationsPerThread = 50;
+
+    auto mtx = MONGO_MAKE_LATCH();
+    std::vector<Timestamp> reservedTimestamps;
+    unittest::Barrier barrier(kNumThreads);
+    std::vector<stdx::thread> threads;
+    for (std::size_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            Client::initThread("reserver" + std::to_string(i));
+            auto opCtx = cc().makeOperationContext();
+            barrier.countDownAndWait();
+
+            for (std::size_t j = 0; j < kNumReservationsPerThread; ++j) {
+                // Every reservation rolls back, as no oplog entries are written at its optimes.
+                WriteUnitOfWork wunit(opCtx.get());
+                const std::size_t count = 1 + (i + j) % 3;
+                auto slots = getNextOpTimes(opCtx.get(), count);
+                ASSERT_EQUALS(count, slots.size());
+                for (std::size_t k = 0; k < count; ++k) {
+                    ASSERT_EQUALS(slots[0].getTimestamp().asULL() + k,
+                                  slots[k].getTimestamp().asULL());
+                }
+
+                stdx::lock_guard<Latch> lock(mtx);
+                for (const auto& slot : slots) {
+                    reservedTimestamps.push_back(slot.getTimestamp());
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::sort(reservedTimestamps.begin(), reservedTimestamps.end());
+    ASSERT(std::adjacent_find(reservedTimestamps.begin(), reservedTimestamps.end()) ==
+           reservedTimestamps.end());
+}
+
+/**
+ * Records the timestamps the storage engine sets on it when an optime is registered for its
+ * operation.
+ */
+class TimestampRecordingRecoveryUnit : public RecoveryUnitNoop {
+public:
+    Status setTimestamp(Timestamp timestamp) override {
+        timestampsSet.push_back(timestamp);
+        return Status::OK();
+    }
+
+    std::vector<Timestamp> timestampsSet;
+};
+
+TEST_F(OplogTest, ConcurrentGetNextOpTimesRegistersEachReservationWithItsOwnRecoveryUnit) {
+    const std::size_t kNumThreads = 8;
+    const std::size_t kNumReservationsPerThread = 50;
+
+    unittest::Barrier barrier(kNumThreads);
+    std::vector<stdx::thread> threads;
+    for (std::size_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            Client::initThread("reserver" + std::to_string(i));
+            auto opCtx = cc().makeOperationContext();
+            barrier.countDownAndWait();
+
+            for (std::size_t j = 0; j < kNumReservationsPerThread; ++j) {
+                // A reservation served by another call must still be registered with the
+                // recovery unit of its own operation.
+                auto ru = new TimestampRecordingRecoveryUnit();
+                opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(ru),
+                                       WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+
+                WriteUnitOfWork wunit(opCtx.get());
+                auto slots = getNextOpTimes(opCtx.get(), 1 + j % 3);
+                ASSERT_EQUALS(1U, ru->timestampsSet.size());
+                ASSERT_EQUALS(slots[0].getTimestamp(), ru->timestampsSet[0]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 TEST_F(OplogTest, MigrationIdAddedToOplog) {
     auto opCtx = cc().makeOperationContext();
     auto migrationUuid = UUID::gen();
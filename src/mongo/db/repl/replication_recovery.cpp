@@ -70,10 +70,14 @@ const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
 /**
- * Tracks and logs operations applied during recovery.
+ * Tracks and logs operations applied during recovery, including periodic progress messages with an
+ * estimate of the remaining work.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(Timestamp startPoint, Timestamp endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -107,7 +111,38 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>&) final {
+        if (!lastOpTimeApplied.isOK() ||
+            _timer.seconds() - _lastProgressLogSecs < replRecoveryProgressLogIntervalSecs.load()) {
+            return;
+        }
+        _lastProgressLogSecs = _timer.seconds();
+
+        // Estimate how much of the oplog remains from how far the applied timestamps have advanced
+        // through the range being replayed, assuming the rate of writes was steady.
+        const auto lastTimestamp = lastOpTimeApplied.getValue().getTimestamp();
+        const double totalSecs = double(_endPoint.getSecs()) - _startPoint.getSecs();
+        const double appliedSecs = double(lastTimestamp.getSecs()) - _startPoint.getSecs();
+        if (totalSecs <= 0 || appliedSecs <= 0) {
+            return;
+        }
+        const double fractionApplied = std::min(appliedSecs / totalSecs, 1.0);
+        const double remainingPerApplied = (1 - fractionApplied) / fractionApplied;
+
+        LOGV2(5962300,
+              "Recovery oplog application progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "estimatedOpsRemaining"_attr =
+                  static_cast<long long>(_numOpsApplied * remainingPerApplied),
+              "percentComplete"_attr = static_cast<int>(fractionApplied * 100),
+              "lastAppliedTimestamp"_attr = lastTimestamp,
+              "endPoint"_attr = _endPoint,
+              "elapsedSecs"_attr = _timer.seconds(),
+              "estimatedSecsRemaining"_attr =
+                  static_cast<long long>(_timer.seconds() * remainingPerApplied));
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -116,14 +151,32 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _timer.millis());
     }
 
 private:
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
+
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+
+    Timer _timer;
+    int _lastProgressLogSecs = 0;
 };
 
+/**
+ * Creates the thread pool which applies the oplog during recovery, sized by
+ * 'replRecoveryWriterThreadCount' when it is set.
+ */
+std::unique_ptr<ThreadPool> makeRecoveryWriterPool() {
+    if (replRecoveryWriterThreadCount == 0) {
+        return makeReplWriterPool();
+    }
+    return makeReplWriterPool(replRecoveryWriterThreadCount, "ReplRecoveryWriterWorker"_sd);
+}
+
 /**
  * OplogBuffer adaptor for a DBClient query on the oplog.
  * Implements only functions used by OplogApplier::getNextApplierBatch().
@@ -665,9 +718,9 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
-    auto writerPool = makeReplWriterPool();
+    auto writerPool = makeRecoveryWriterPool();
     auto* replCoord = ReplicationCoordinator::get(opCtx);
     OplogApplierImpl oplogApplier(nullptr,
                                   &oplogBuffer,
@@ -680,7 +733,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OplogApplier::BatchLimits batchLimits;
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
+    batchLimits.ops = std::size_t(replRecoveryBatchLimitOperations.load());
 
     // If we're doing unstable checkpoints during the recovery process (as we do during the special
     // startupRecoveryForRestore mode), we need to advance the consistency marker for each batch so
@@ -43,6 +43,7 @@
 #include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_mock.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/replication_recovery.h"
@@ -1630,4 +1631,25 @@ TEST_F(ReplicationRecoveryTest, RecoverySetsValidateFeaturesAsPrimaryToFalseWhil
     ASSERT_FALSE(serverGlobalParams.validateFeaturesAsPrimary.load());
 }
 
+TEST_F(ReplicationRecoveryTest, RecoveryAppliesDocumentsWithRecoveryBatchLimitAndWriterPool) {
+    const auto batchLimitDefault = replRecoveryBatchLimitOperations.load();
+    const auto threadCountDefault = replRecoveryWriterThreadCount;
+    ON_BLOCK_EXIT([&] {
+        replRecoveryBatchLimitOperations.store(batchLimitDefault);
+        replRecoveryWriterThreadCount = threadCountDefault;
+    });
+    replRecoveryBatchLimitOperations.store(1);
+    replRecoveryWriterThreadCount = 2;
+
+    auto opCtx = getOperationContext();
+    ReplicationRecoveryImpl recovery(getStorageInterface(), getConsistencyMarkers());
+    getConsistencyMarkers()->setAppliedThrough(opCtx, OpTime(Timestamp(2, 2), 1));
+    _setUpOplog(opCtx, getStorageInterface(), {1, 2, 3, 4, 5, 6});
+    recovery.recoverFromOplog(opCtx, boost::none /* recoveryTs */);
+
+    _assertDocsInOplog(opCtx, {1, 2, 3, 4, 5, 6});
+    _assertDocsInTestCollection(opCtx, {3, 4, 5, 6});
+    ASSERT_EQ(getConsistencyMarkers()->getAppliedThrough(opCtx), OpTime(Timestamp(6, 6), 1));
+}
+
 }  // namespace
@@ -435,7 +435,8 @@ StatusWith<std::set<NamespaceString>> RollbackImpl::_namespacesForOp(const Oplog
             case OplogEntry::CommandType::kStartIndexBuild:
             case OplogEntry::CommandType::kAbortIndexBuild:
             case OplogEntry::CommandType::kCommitIndexBuild:
-            case OplogEntry::CommandType::kCollMod: {
+            case OplogEntry::CommandType::kCollMod:
+            case OplogEntry::CommandType::kTruncateRange: {
                 // For all other command types, we should be able to parse the collection name from
                 // the first command argument.
                 try {
@@ -970,6 +971,19 @@ Status RollbackImpl::_processRollbackOp(OperationContext* opCtx, const OplogEntr
                 _pendingDrops.erase(importTargetUUID);
                 _newCounts.erase(importTargetUUID);
             }
+        } else if (oplogEntry.getCommandType() == OplogEntry::CommandType::kTruncateRange) {
+            // Rolling back a range truncate must increment the count by the number of records it
+            // removed, which is recorded in the o2 field. Without it, fall back to a collection
+            // scan to fix the count.
+            const auto uuid = oplogEntry.getUuid().get();
+            long long count = 0;
+            auto obj2 = oplogEntry.getObject2();
+            if (obj2 && bsonExtractIntegerField(*obj2, kNumRecordsFieldName, &count).isOK() &&
+                count >= 0) {
+                _countDiffs[uuid] += count;
+            } else {
+                _newCounts[uuid] = kCollectionScanRequired;
+            }
         } else if (oplogEntry.getCommandType() == OplogEntry::CommandType::kDrop) {
             // If we roll back a collection drop, parse the o2 field for the collection count for
             // use later by _findRecordStoreCounts().
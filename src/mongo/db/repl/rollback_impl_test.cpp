@@ -1399,6 +1399,41 @@ TEST_F(RollbackImplTest, CountChangesCancelOut) {
     ASSERT_EQ(_storageInterface->getFinalCollectionCount(uuid), 1);
 }
 
+TEST_F(RollbackImplTest, RollbackOfTruncateRangeAddsBackTheRecordsItRemoved) {
+    auto uuid = kGenericUUID;
+    _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
+
+    const auto commonOp = makeOpAndRecordId(1);
+    _remoteOplog->setOperations({commonOp});
+    ASSERT_OK(_insertOplogEntry(commonOp.first));
+
+    const auto coll = _initializeCollection(_opCtx.get(), uuid, nss);
+
+    // A range truncate removed three records, then one document was inserted.
+    BSONObjBuilder cmdBuilder;
+    cmdBuilder.append("truncateRange", nss.coll());
+    RecordId(1).serializeToken("minRecordId", &cmdBuilder);
+    RecordId(3).serializeToken("maxRecordId", &cmdBuilder);
+    ASSERT_OK(_insertOplogEntry(makeCommandOp(Timestamp(2, 2),
+                                              uuid,
+                                              nss.getCommandNS().toString(),
+                                              cmdBuilder.obj(),
+                                              2,
+                                              BSON("numRecords" << 3))
+                                    .first));
+    _insertDocAndGenerateOplogEntry(BSON("_id" << 4), uuid, nss, 3);
+
+    ASSERT_EQ(1ULL,
+              unittest::assertGet(_storageInterface->getCollectionCount(
+                  _opCtx.get(), {nss.db().toString(), uuid})));
+    ASSERT_OK(_storageInterface->setCollectionCount(nullptr, {"", uuid}, 1));
+
+    _assertDocsInOplog(_opCtx.get(), {1, 2, 3});
+
+    ASSERT_OK(_rollback->runRollback(_opCtx.get()));
+    ASSERT_EQ(_storageInterface->getFinalCollectionCount(uuid), 3);
+}
+
 TEST_F(RollbackImplTest, RollbackIgnoresSetCollectionCountError) {
     _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
 
@@ -251,6 +251,10 @@ auto withTemporaryOperationContext(Callable&& callable) {
     auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
     auto opCtx = uniqueOpCtx.get();
 
+    // The orphaned documents left behind by a migration are already filtered out of client
+    // queries, so deleting them is never urgent.
+    opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+
     // Ensure that this operation will be killed by the RstlKillOpThread during step-up or stepdown.
     opCtx->setAlwaysInterruptAtStepDownOrUp();
     invariant(opCtx->shouldAlwaysInterruptAtStepDownOrUp());
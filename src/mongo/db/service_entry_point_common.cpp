@@ -82,6 +82,7 @@
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_stats_store.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
@@ -2082,6 +2083,40 @@ void HandleRequest::startOperation() {
     }
 }
 
+/**
+ * Folds the statistics of a completed query into the per-shape entry of the QueryStatsStore. Only
+ * operations for which a query shape hash was computed and which came from a user connection are
+ * recorded.
+ */
+void recordQueryStats(OperationContext* opCtx, CurOp& currentOp) {
+    const auto& debug = currentOp.debug();
+    if (!debug.queryHash || !opCtx->shouldIncrementLatencyStats()) {
+        return;
+    }
+
+    auto client = opCtx->getClient();
+    if (!client->isFromUserConnection() || client->isInDirectClient()) {
+        return;
+    }
+
+    QueryStatsStore::OperationStats stats;
+    stats.nss = currentOp.getNSS();
+    stats.readWriteType = currentOp.getReadWriteType();
+    stats.latency = currentOp.elapsedTimeExcludingPauses();
+    stats.docsExamined = debug.additiveMetrics.docsExamined.value_or(0);
+    stats.keysExamined = debug.additiveMetrics.keysExamined.value_or(0);
+    stats.nReturned = std::max(debug.nreturned, 0LL);
+    stats.executedAt = opCtx->getServiceContext()->getFastClockSource()->now();
+
+    // CPU time is only measured while resource consumption metrics are being collected.
+    const auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    if (metricsCollector.hasCollectedMetrics() && metricsCollector.getMetrics().cpuTimer) {
+        stats.cpuTime = metricsCollector.getMetrics().cpuTimer->getElapsed();
+    }
+
+    QueryStatsStore::get(opCtx->getServiceContext()).record(*debug.queryHash, stats);
+}
+
 void HandleRequest::completeOperation(DbResponse& response) {
     auto opCtx = executionContext->getOpCtx();
     auto& currentOp = executionContext->currentOp();
@@ -2100,6 +2135,8 @@ void HandleRequest::completeOperation(DbResponse& response) {
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    recordQueryStats(opCtx, currentOp);
+
     if (shouldProfile) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
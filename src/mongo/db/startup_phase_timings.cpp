@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kControl
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/startup_phase_timings.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+const auto getStartupPhaseTimings = ServiceContext::declareDecoration<StartupPhaseTimings>();
+
+class StartupTimingsSSS : public ServerStatusSection {
+public:
+    StartupTimingsSSS() : ServerStatusSection("startupTimings") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        StartupPhaseTimings::get(opCtx)->report(&builder);
+        return builder.obj();
+    }
+} startupTimingsSSS;
+
+}  // namespace
+
+StartupPhaseTimings* StartupPhaseTimings::get(ServiceContext* serviceContext) {
+    return &getStartupPhaseTimings(serviceContext);
+}
+
+StartupPhaseTimings* StartupPhaseTimings::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void StartupPhaseTimings::record(StringData phase, Milliseconds duration) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_total) {
+        return;
+    }
+
+    auto it = std::find_if(
+        _phases.begin(), _phases.end(), [&](const auto& entry) { return entry.first == phase; });
+    if (it == _phases.end()) {
+        _phases.emplace_back(phase.toString(), duration);
+    } else {
+        it->second += duration;
+    }
+}
+
+void StartupPhaseTimings::onStartupComplete(Milliseconds total) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_total) {
+        return;
+    }
+    _total = total;
+
+    BSONObjBuilder builder;
+    _report(lk, &builder);
+    LOGV2(5962200, "Startup timing breakdown", "timings"_attr = builder.obj());
+}
+
+void StartupPhaseTimings::report(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _report(lk, builder);
+}
+
+void StartupPhaseTimings::_report(WithLock, BSONObjBuilder* builder) const {
+    builder->append("startupComplete", static_cast<bool>(_total));
+    if (_total) {
+        builder->append("totalMillis", durationCount<Milliseconds>(*_total));
+    }
+
+    BSONObjBuilder phasesBuilder(builder->subobjStart("phaseMillis"));
+    for (const auto& [phase, duration] : _phases) {
+        phasesBuilder.append(phase, durationCount<Milliseconds>(duration));
+    }
+}
+
+StartupPhaseTimings::ScopedPhase::ScopedPhase(ServiceContext* serviceContext, StringData phase)
+    : _timings(StartupPhaseTimings::get(serviceContext)), _phase(phase.toString()) {}
+
+StartupPhaseTimings::ScopedPhase::~ScopedPhase() {
+    _timings->record(_phase, Milliseconds(_timer.millis()));
+}
+
+}  // namespace mongo
@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Records how long each phase of mongod startup took, so that a slow startup can be attributed to
+ * the phase responsible for it. The breakdown is logged once startup completes and is reported in
+ * the 'startupTimings' section of serverStatus.
+ */
+class StartupPhaseTimings {
+public:
+    static StartupPhaseTimings* get(ServiceContext* serviceContext);
+    static StartupPhaseTimings* get(OperationContext* opCtx);
+
+    /**
+     * Records that 'phase' took 'duration'. The durations of a phase which runs more than once are
+     * added together. Has no effect once startup has completed.
+     */
+    void record(StringData phase, Milliseconds duration);
+
+    /**
+     * Records 'total' as the time startup took, logs the breakdown of the phases and stops
+     * recording any further phases.
+     */
+    void onStartupComplete(Milliseconds total);
+
+    void report(BSONObjBuilder* builder) const;
+
+    /**
+     * Records the time between its construction and its destruction as a duration of 'phase'.
+     */
+    class ScopedPhase {
+    public:
+        ScopedPhase(ServiceContext* serviceContext, StringData phase);
+        ~ScopedPhase();
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        StartupPhaseTimings* const _timings;
+        const std::string _phase;
+        Timer _timer;
+    };
+
+private:
+    void _report(WithLock, BSONObjBuilder* builder) const;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("StartupPhaseTimings::_mutex");
+
+    // Phases in the order in which they were first recorded.
+    std::vector<std::pair<std::string, Milliseconds>> _phases;
+    boost::optional<Milliseconds> _total;
+};
+
+}  // namespace mongo
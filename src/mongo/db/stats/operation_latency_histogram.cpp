@@ -35,6 +35,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/server_options.h"
 #include "mongo/platform/bits.h"
 
 namespace mongo {
@@ -186,19 +187,19 @@ void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, His
     data->sum += latency;
 }
 
-void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteType type) {
+void OperationLatencyHistogram::increment(uint64_t latency, ReadWriteType type) {
     int bucket = _getBucket(latency);
     switch (type) {
-        case Command::ReadWriteType::kRead:
+        case ReadWriteType::kRead:
             _incrementData(latency, bucket, &_reads);
             break;
-        case Command::ReadWriteType::kWrite:
+        case ReadWriteType::kWrite:
             _incrementData(latency, bucket, &_writes);
             break;
-        case Command::ReadWriteType::kCommand:
+        case ReadWriteType::kCommand:
             _incrementData(latency, bucket, &_commands);
             break;
-        case Command::ReadWriteType::kTransaction:
+        case ReadWriteType::kTransaction:
             _incrementData(latency, bucket, &_transactions);
             break;
         default:
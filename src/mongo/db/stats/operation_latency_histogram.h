@@ -30,7 +30,7 @@
 
 #include <array>
 
-#include "mongo/db/commands.h"
+#include "mongo/db/read_write_type.h"
 
 namespace mongo {
 
@@ -52,7 +52,7 @@ public:
     /**
      * Increments the bucket of the histogram based on the operation type.
      */
-    void increment(uint64_t latency, Command::ReadWriteType type);
+    void increment(uint64_t latency, ReadWriteType type);
 
     /**
      * Appends the four histograms with latency totals and operation counts.
@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_stats_store_gen.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* service) {
+    return getQueryStatsStore(service);
+}
+
+size_t QueryStatsStore::_maxEntriesPerPartition() {
+    const auto maxEntries = static_cast<size_t>(internalQueryStatsStoreMaxEntries.load());
+    if (maxEntries == 0) {
+        return 0;
+    }
+    return std::max<size_t>(1, maxEntries / kNumPartitions);
+}
+
+void QueryStatsStore::record(uint32_t queryHash, const OperationStats& stats) {
+    const auto maxEntries = _maxEntriesPerPartition();
+    if (maxEntries == 0) {
+        return;
+    }
+
+    ShapeKey key{stats.nss, queryHash};
+    auto& partition = _partitions[queryHash % kNumPartitions];
+    stdx::lock_guard<Latch> lk(partition.mutex);
+
+    Entry* entry;
+    if (auto it = partition.index.find(key); it != partition.index.end()) {
+        // Promote the shape to the front of the LRU list.
+        partition.entries.splice(partition.entries.begin(), partition.entries, it->second);
+        entry = &partition.entries.front();
+    } else {
+        // The maximum size may have been lowered at runtime, so evict as many shapes as needed.
+        while (partition.entries.size() >= maxEntries) {
+            partition.index.erase(partition.entries.back().key);
+            partition.entries.pop_back();
+            ++partition.numEvicted;
+        }
+        partition.entries.emplace_front(key);
+        partition.index.emplace(std::move(key), partition.entries.begin());
+        entry = &partition.entries.front();
+        entry->firstSeen = stats.executedAt;
+    }
+
+    entry->lastExecution = stats.executedAt;
+    ++entry->execCount;
+    entry->docsExamined += stats.docsExamined;
+    entry->keysExamined += stats.keysExamined;
+    entry->nReturned += stats.nReturned;
+    if (stats.cpuTime) {
+        ++entry->cpuTrackedExecCount;
+        entry->cpuTime += *stats.cpuTime;
+    }
+    entry->latency.increment(durationCount<Microseconds>(stats.latency), stats.readWriteType);
+}
+
+void QueryStatsStore::Entry::toBSON(BSONObjBuilder* builder) const {
+    builder->append("queryHash", zeroPaddedHex(key.queryHash));
+    builder->append("ns", key.nss.ns());
+    builder->append("firstSeen", firstSeen);
+    builder->append("lastExecution", lastExecution);
+    builder->append("execCount", execCount);
+    builder->append("docsExamined", docsExamined);
+    builder->append("keysExamined", keysExamined);
+    builder->append("nReturned", nReturned);
+
+    // CPU time is only tracked for some operations, so report how many executions it covers.
+    if (cpuTrackedExecCount > 0) {
+        builder->append("cpuNanos", durationCount<Nanoseconds>(cpuTime));
+        builder->append("cpuTrackedExecCount", cpuTrackedExecCount);
+    }
+
+    BSONObjBuilder latencyBuilder(builder->subobjStart("latencyStats"));
+    latency.append(true /* includeHistograms */, false /* slowMSBucketsOnly */, &latencyBuilder);
+    latencyBuilder.doneFast();
+}
+
+std::vector<BSONObj> QueryStatsStore::getStats() const {
+    std::vector<BSONObj> result;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (auto&& entry : partition.entries) {
+            BSONObjBuilder builder;
+            entry.toBSON(&builder);
+            result.push_back(builder.obj());
+        }
+    }
+    return result;
+}
+
+void QueryStatsStore::clear() {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.index.clear();
+        partition.entries.clear();
+    }
+}
+
+size_t QueryStatsStore::size() const {
+    size_t total = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        total += partition.entries.size();
+    }
+    return total;
+}
+
+long long QueryStatsStore::numEvicted() const {
+    long long total = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        total += partition.numEvicted;
+    }
+    return total;
+}
+
+}  // namespace mongo
@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <list>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/read_write_type.h"
+#include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * An in-memory, bounded store of execution statistics aggregated per query shape. Entries are keyed
+ * by namespace and by the 'queryHash' computed by canonical_query_encoder, so that all executions
+ * of queries against a collection which differ only in their constants accumulate into the same
+ * entry. The 'queryHash' does not cover the namespace, so the same shape run against two
+ * collections has an entry for each.
+ *
+ * The store is split into a fixed number of partitions, each protected by its own mutex, so that
+ * shapes in different partitions are recorded without serializing on a single lock. Every
+ * execution of a shape records into the same partition, so concurrent executions of one hot shape
+ * do serialize on its partition's mutex, which is only held to update a few counters. Partitions
+ * are chosen by 'queryHash' alone, so the entries of a shape on every namespace share one. Each
+ * partition holds at most 'internalQueryStatsStoreMaxEntries / kNumPartitions' shapes and evicts
+ * the least recently executed shape when full. Setting 'internalQueryStatsStoreMaxEntries' to 0
+ * disables recording.
+ *
+ * This class is thread-safe.
+ */
+class QueryStatsStore {
+    QueryStatsStore(const QueryStatsStore&) = delete;
+    QueryStatsStore& operator=(const QueryStatsStore&) = delete;
+
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    /**
+     * The statistics of a single completed operation, to be folded into the entry for its shape.
+     */
+    struct OperationStats {
+        NamespaceString nss;
+        ReadWriteType readWriteType = ReadWriteType::kRead;
+        Microseconds latency{0};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nReturned = 0;
+        // Only available when the operation's CPU time was tracked.
+        boost::optional<Nanoseconds> cpuTime;
+        Date_t executedAt;
+    };
+
+    static QueryStatsStore& get(ServiceContext* service);
+
+    QueryStatsStore() = default;
+
+    /**
+     * Accumulates 'stats' into the entry for 'queryHash' on 'stats.nss', creating the entry if this
+     * is the first execution of the shape on that namespace. May evict the least recently executed
+     * shape of the partition.
+     */
+    void record(uint32_t queryHash, const OperationStats& stats);
+
+    /**
+     * Returns one document per query shape currently in the store. The documents are owned and the
+     * partitions are not locked once this method returns.
+     */
+    std::vector<BSONObj> getStats() const;
+
+    /**
+     * Removes all entries from the store.
+     */
+    void clear();
+
+    /**
+     * Returns the number of query shapes currently in the store.
+     */
+    size_t size() const;
+
+    /**
+     * Returns the number of query shapes evicted from the store since startup.
+     */
+    long long numEvicted() const;
+
+private:
+    struct ShapeKey {
+        bool operator==(const ShapeKey& other) const {
+            return queryHash == other.queryHash && nss == other.nss;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H h, const ShapeKey& key) {
+            return H::combine(std::move(h), key.nss.ns(), key.queryHash);
+        }
+
+        NamespaceString nss;
+        uint32_t queryHash;
+    };
+
+    struct Entry {
+        explicit Entry(ShapeKey shapeKey) : key(std::move(shapeKey)) {}
+
+        void toBSON(BSONObjBuilder* builder) const;
+
+        ShapeKey key;
+        Date_t firstSeen;
+        Date_t lastExecution;
+        long long execCount = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nReturned = 0;
+        long long cpuTrackedExecCount = 0;
+        Nanoseconds cpuTime{0};
+        OperationLatencyHistogram latency;
+    };
+
+    /**
+     * A single LRU-ordered shard of the store. The front of 'entries' is the most recently executed
+     * shape. Promoting an entry splices its list node rather than reallocating it, so recording an
+     * execution of a known shape does not allocate.
+     */
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryStatsStore::Partition::mutex");
+        std::list<Entry> entries;
+        stdx::unordered_map<ShapeKey, std::list<Entry>::iterator> index;
+        long long numEvicted = 0;
+    };
+
+    static size_t _maxEntriesPerPartition();
+
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include <algorithm>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/stats/query_stats_store_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+
+QueryStatsStore::OperationStats makeStats(long long docsExamined, Microseconds latency) {
+    QueryStatsStore::OperationStats stats;
+    stats.nss = NamespaceString("test.coll");
+    stats.latency = latency;
+    stats.docsExamined = docsExamined;
+    stats.keysExamined = docsExamined * 2;
+    stats.nReturned = 1;
+    stats.executedAt = Date_t::fromMillisSinceEpoch(1000);
+    return stats;
+}
+
+/**
+ * Restores the maximum size of the store once a test completes.
+ */
+class QueryStatsStoreTest : public unittest::Test {
+public:
+    ~QueryStatsStoreTest() {
+        internalQueryStatsStoreMaxEntries.store(_originalMaxEntries);
+    }
+
+private:
+    const int _originalMaxEntries = internalQueryStatsStoreMaxEntries.load();
+};
+
+TEST_F(QueryStatsStoreTest, AccumulatesExecutionsOfTheSameShape) {
+    QueryStatsStore store;
+    store.record(7, makeStats(10, Microseconds(5)));
+    store.record(7, makeStats(20, Microseconds(3000)));
+
+    auto stats = store.getStats();
+    ASSERT_EQ(stats.size(), 1U);
+    ASSERT_EQ(stats[0]["queryHash"].String(), zeroPaddedHex(uint32_t{7}));
+    ASSERT_EQ(stats[0]["ns"].String(), "test.coll");
+    ASSERT_EQ(stats[0]["execCount"].Long(), 2);
+    ASSERT_EQ(stats[0]["docsExamined"].Long(), 30);
+    ASSERT_EQ(stats[0]["keysExamined"].Long(), 60);
+    ASSERT_EQ(stats[0]["nReturned"].Long(), 2);
+    ASSERT_FALSE(stats[0].hasField("cpuNanos"));
+
+    auto reads = stats[0]["latencyStats"]["reads"];
+    ASSERT_EQ(reads["ops"].Long(), 2);
+    ASSERT_EQ(reads["latency"].Long(), 3005);
+    ASSERT_EQ(reads["histogram"].Array().size(), 2U);
+}
+
+TEST_F(QueryStatsStoreTest, SeparatesTheSameShapeOnDifferentNamespaces) {
+    QueryStatsStore store;
+    store.record(7, makeStats(10, Microseconds(5)));
+    auto otherCollStats = makeStats(20, Microseconds(5));
+    otherCollStats.nss = NamespaceString("test.otherColl");
+    store.record(7, otherCollStats);
+
+    auto stats = store.getStats();
+    ASSERT_EQ(stats.size(), 2U);
+    std::sort(stats.begin(), stats.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs["ns"].String() < rhs["ns"].String();
+    });
+    ASSERT_EQ(stats[0]["ns"].String(), "test.coll");
+    ASSERT_EQ(stats[0]["docsExamined"].Long(), 10);
+    ASSERT_EQ(stats[1]["ns"].String(), "test.otherColl");
+    ASSERT_EQ(stats[1]["docsExamined"].Long(), 20);
+    ASSERT_EQ(stats[0]["queryHash"].String(), stats[1]["queryHash"].String());
+}
+
+TEST_F(QueryStatsStoreTest, ReportsCpuTimeOnlyForTrackedExecutions) {
+    QueryStatsStore store;
+    auto tracked = makeStats(1, Microseconds(1));
+    tracked.cpuTime = Nanoseconds(500);
+    store.record(1, tracked);
+    store.record(1, makeStats(1, Microseconds(1)));
+
+    auto stats = store.getStats();
+    ASSERT_EQ(stats.size(), 1U);
+    ASSERT_EQ(stats[0]["cpuNanos"].Long(), 500);
+    ASSERT_EQ(stats[0]["cpuTrackedExecCount"].Long(), 1);
+    ASSERT_EQ(stats[0]["execCount"].Long(), 2);
+}
+
+TEST_F(QueryStatsStoreTest, EvictsLeastRecentlyExecutedShape) {
+    // One entry per partition.
+    internalQueryStatsStoreMaxEntries.store(QueryStatsStore::kNumPartitions);
+    QueryStatsStore store;
+
+    // These hashes all map to the same partition.
+    const uint32_t first = 3;
+    const uint32_t second = first + QueryStatsStore::kNumPartitions;
+    store.record(first, makeStats(1, Microseconds(1)));
+    store.record(second, makeStats(1, Microseconds(1)));
+
+    ASSERT_EQ(store.size(), 1U);
+    ASSERT_EQ(store.numEvicted(), 1);
+    auto stats = store.getStats();
+    ASSERT_EQ(stats[0]["queryHash"].String(), zeroPaddedHex(second));
+}
+
+TEST_F(QueryStatsStoreTest, ShapesInDifferentPartitionsAreNotEvicted) {
+    internalQueryStatsStoreMaxEntries.store(QueryStatsStore::kNumPartitions);
+    QueryStatsStore store;
+    for (uint32_t hash = 0; hash < QueryStatsStore::kNumPartitions; ++hash) {
+        store.record(hash, makeStats(1, Microseconds(1)));
+    }
+    ASSERT_EQ(store.size(), QueryStatsStore::kNumPartitions);
+    ASSERT_EQ(store.numEvicted(), 0);
+}
+
+TEST_F(QueryStatsStoreTest, ZeroMaxEntriesDisablesRecording) {
+    internalQueryStatsStoreMaxEntries.store(0);
+    QueryStatsStore store;
+    store.record(1, makeStats(1, Microseconds(1)));
+    ASSERT_EQ(store.size(), 0U);
+}
+
+TEST_F(QueryStatsStoreTest, ClearRemovesAllShapes) {
+    QueryStatsStore store;
+    store.record(1, makeStats(1, Microseconds(1)));
+    store.record(2, makeStats(1, Microseconds(1)));
+    ASSERT_EQ(store.size(), 2U);
+    store.clear();
+    ASSERT_EQ(store.size(), 0U);
+    ASSERT(store.getStats().empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -40,6 +40,7 @@
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/exec/sbe/values/value_builder.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/strnlen.h"
 #include "mongo/util/decimal_counter.h"
@@ -244,10 +245,27 @@ const int8_t kMaxRecordIdStrLen = 127;
 // some utility functions
 namespace {
 
+/**
+ * Copies 'bytes' bytes from 'src' to 'dst', inverting every bit. 'dst' may be equal to 'src' to
+ * invert a buffer in place.
+ */
 void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    // Descending keys and inverted strings go through here, so invert a whole vector of bytes at a
+    // time and only handle the tail byte by byte.
+    using unicode::ByteVector;
+    const ByteVector allOnes(ByteVector::Scalar(-1));
+    while (end - input >= ByteVector::size) {
+        (ByteVector::load(input) ^ allOnes).store(output);
+        input += ByteVector::size;
+        output += ByteVector::size;
+    }
+#endif
+
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -299,10 +317,8 @@ string readInvertedCString(BufReader* reader) {
     const char* end = static_cast<const char*>(memchr(start, 0xFF, reader->remaining()));
     keyStringAssert(50817, "Failed to find '0xFF' in inverted string.", end);
     size_t actualBytes = end - start;
-    string s(start, actualBytes);
-    for (size_t i = 0; i < s.size(); i++) {
-        s[i] = ~s[i];
-    }
+    string s(actualBytes, '\0');
+    memcpy_flipBits(&s[0], start, actualBytes);
     reader->skip(1 + actualBytes);
     return s;
 }
@@ -329,9 +345,7 @@ string readInvertedCStringWithNuls(BufReader* reader) {
         reader->skip(1 + actualBytes);
     } while (reader->peek<unsigned char>() == 0x00);
 
-    for (size_t i = 0; i < out.size(); i++) {
-        out[i] = ~out[i];
-    }
+    memcpy_flipBits(&out[0], out.data(), out.size());
 
     return out;
 }
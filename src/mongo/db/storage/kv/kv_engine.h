@@ -369,6 +369,13 @@ public:
         return false;
     }
 
+    /**
+     * See `StorageEngine::getCacheDirtyPercentage`
+     */
+    virtual boost::optional<double> getCacheDirtyPercentage() const {
+        return boost::none;
+    }
+
     /**
      * Methods to access the storage engine's timestamps.
      */
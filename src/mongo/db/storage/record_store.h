@@ -202,6 +202,14 @@ public:
     virtual void saveUnpositioned() {
         save();
     }
+
+    /**
+     * Hints that the caller is about to read a long run of records with next(), as a collection
+     * scan does. The storage engine may then read the records beyond the cursor position into its
+     * cache in the background, so that the I/O for later records overlaps with the processing of
+     * earlier ones. Read-ahead never changes which records are returned.
+     */
+    virtual void enableReadAhead() {}
 };
 
 /**
@@ -381,6 +389,22 @@ public:
                                 const char* data,
                                 int len) = 0;
 
+    /**
+     * Updates the record with id 'recordId' to the contents described by 'data' and 'len', exactly
+     * as updateRecord() does. 'damages' describes how to produce 'data' from the current contents
+     * of the record: applied in order, each event replaces 'targetSize' bytes at 'targetOffset' of
+     * the partially updated record with the 'sourceSize' bytes at 'sourceOffset' of 'data'. Record
+     * stores which store updates as deltas may use the events in place of computing their own;
+     * the default implementation ignores them.
+     */
+    virtual Status updateRecordWithDamageHint(OperationContext* opCtx,
+                                              const RecordId& recordId,
+                                              const char* data,
+                                              int len,
+                                              const mutablebson::DamageVector& damages) {
+        return updateRecord(opCtx, recordId, data, len);
+    }
+
     /**
      * @return Returns 'false' if this record store does not implement
      * 'updatewithDamages'. If this method returns false, 'updateWithDamages' must not be
@@ -438,6 +462,34 @@ public:
      */
     virtual Status truncate(OperationContext* opCtx) = 0;
 
+    /**
+     * Removes all records with ids in the inclusive range ['minRecordId', 'maxRecordId']. The
+     * caller has already determined that the range holds 'numRecords' records totalling 'dataSize'
+     * bytes, which are used to maintain the size metadata. Storage engines which can remove a key
+     * range in a single operation should override this; the default implementation deletes the
+     * records one at a time.
+     */
+    virtual Status rangeTruncate(OperationContext* opCtx,
+                                 const RecordId& minRecordId,
+                                 const RecordId& maxRecordId,
+                                 int64_t numRecords,
+                                 int64_t dataSize) {
+        std::vector<RecordId> recordIds;
+        {
+            auto cursor = getCursor(opCtx, true);
+            for (auto record = cursor->seekNear(minRecordId); record && record->id <= maxRecordId;
+                 record = cursor->next()) {
+                if (record->id >= minRecordId) {
+                    recordIds.push_back(record->id);
+                }
+            }
+        }
+        for (const auto& recordId : recordIds) {
+            deleteRecord(opCtx, recordId);
+        }
+        return Status::OK();
+    }
+
     /**
      * Truncate documents newer than the document at 'end' from the capped
      * collection.  The collection cannot be completely emptied using this
@@ -114,5 +114,58 @@ TEST(RecordStoreTestHarness, TruncateNonEmpty) {
     }
 }
 
+// Insert multiple records, and verify that calling rangeTruncate() removes exactly the records in
+// the inclusive range.
+TEST(RecordStoreTestHarness, RangeTruncate) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    std::vector<RecordId> recordIds;
+    int64_t rangeDataSize = 0;
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            stringstream ss;
+            ss << "record " << i;
+            string data = ss.str();
+
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            recordIds.push_back(res.getValue());
+            uow.commit();
+
+            if (i >= 2 && i <= 6) {
+                rangeDataSize += data.size() + 1;
+            }
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->rangeTruncate(opCtx.get(), recordIds[2], recordIds[6], 5, rangeDataSize));
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(nToInsert - 5, rs->numRecords(opCtx.get()));
+
+        std::vector<RecordId> remaining;
+        auto cursor = rs->getCursor(opCtx.get());
+        while (auto record = cursor->next()) {
+            remaining.push_back(record->id);
+        }
+        std::vector<RecordId> expected{
+            recordIds[0], recordIds[1], recordIds[7], recordIds[8], recordIds[9]};
+        ASSERT(remaining == expected);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
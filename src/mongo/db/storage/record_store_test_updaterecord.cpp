@@ -155,5 +155,51 @@ TEST(RecordStoreTestHarness, UpdateMultipleRecords) {
     }
 }
 
+// Insert a record and update it, describing the changed bytes with damage events.
+TEST(RecordStoreTestHarness, UpdateRecordWithDamageHint) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    string data(4096, 'a');
+    RecordId loc;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            loc = res.getValue();
+            uow.commit();
+        }
+    }
+
+    // Grow the record by replacing 3 bytes with 5, then shrink it by replacing 4 bytes with 1.
+    // Offsets are in terms of the record as updated by the preceding events.
+    string updated = data;
+    updated.replace(100, 3, "bbbbb");
+    updated.replace(2000, 4, "c");
+    mutablebson::DamageVector damages;
+    damages.emplace_back(100, 5, 100, 3);
+    damages.emplace_back(2000, 1, 2000, 4);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->updateRecordWithDamageHint(
+                opCtx.get(), loc, updated.c_str(), updated.size() + 1, damages));
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        RecordData record = rs->dataFor(opCtx.get(), loc);
+        ASSERT_EQUALS(updated.size() + 1, static_cast<size_t>(record.size()));
+        ASSERT_EQUALS(updated, record.data());
+        ASSERT_EQUALS(static_cast<long long>(updated.size() + 1), rs->dataSize(opCtx.get()));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -104,6 +104,34 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Inserts each of 'keyStrings' as insert() would, stopping at the first failure. The keys
+     * should be in ascending order, so that implementations can insert them in a single pass over
+     * the index. If 'timestamps' is not empty, 'timestamps[i]' is the timestamp at which
+     * 'keyStrings[i]' is written, and a null timestamp leaves the timestamp of the write unchanged.
+     *
+     * The default implementation calls insert() for each key.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               const std::vector<KeyString::Value>& keyStrings,
+                               const std::vector<Timestamp>& timestamps,
+                               bool dupsAllowed) {
+        invariant(timestamps.empty() || timestamps.size() == keyStrings.size());
+        Timestamp lastTimestamp;
+        for (size_t i = 0; i < keyStrings.size(); ++i) {
+            if (!timestamps.empty() && !timestamps[i].isNull() && timestamps[i] != lastTimestamp) {
+                Status status = opCtx->recoveryUnit()->setTimestamp(timestamps[i]);
+                if (!status.isOK())
+                    return status;
+                lastTimestamp = timestamps[i];
+            }
+            Status status = insert(opCtx, keyStrings[i], dupsAllowed);
+            if (!status.isOK())
+                return status;
+        }
+        return Status::OK();
+    }
+
     /**
      * Remove the entry from the index with the specified KeyString, which must have a RecordId
      * appended to the end.
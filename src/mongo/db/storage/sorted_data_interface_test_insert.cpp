@@ -718,5 +718,64 @@ TEST(SortedDataInterface, InsertReservedRecordIdLong) {
     ASSERT_EQUALS(1, sorted->numEntries(opCtx.get()));
 }
 
+// Insert a batch of sorted KeyStrings and verify that they can all be found.
+TEST(SortedDataInterface, InsertBatch) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/false, /*partial=*/false));
+
+    std::vector<KeyString::Value> keyStrings{makeKeyString(sorted.get(), key1, loc1),
+                                             makeKeyString(sorted.get(), key1, loc2),
+                                             makeKeyString(sorted.get(), key2, loc1),
+                                             makeKeyString(sorted.get(), key3, loc3)};
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(sorted->insertBatch(opCtx.get(), keyStrings, {}, true));
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(4, sorted->numEntries(opCtx.get()));
+
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+        ASSERT_EQ(cursor->seek(makeKeyStringForSeek(sorted.get(), key1, true, true)),
+                  IndexKeyEntry(key1, loc1));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key1, loc2));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key2, loc1));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key3, loc3));
+        ASSERT_EQ(cursor->next(), boost::none);
+    }
+}
+
+// Insert a batch containing a duplicate key into a unique index and verify that the batch fails.
+TEST(SortedDataInterface, InsertBatchWithDuplicateKeyFails) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/true, /*partial=*/false));
+
+    std::vector<KeyString::Value> keyStrings{makeKeyString(sorted.get(), key1, loc1),
+                                             makeKeyString(sorted.get(), key2, loc1),
+                                             makeKeyString(sorted.get(), key2, loc2)};
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_EQ(ErrorCodes::DuplicateKey,
+                      sorted->insertBatch(opCtx.get(), keyStrings, {}, false));
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT(sorted->isEmpty(opCtx.get()));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -448,6 +448,13 @@ public:
      */
     virtual bool supportsOplogStones() const = 0;
 
+    /**
+     * Returns the percentage of the storage engine cache that is occupied by dirty data, or
+     * boost::none if the storage engine does not have a cache that it can report on. Background
+     * tasks may use this to back off while the storage engine is under cache pressure.
+     */
+    virtual boost::optional<double> getCacheDirtyPercentage() const = 0;
+
     virtual bool supportsResumableIndexBuilds() const = 0;
 
     /**
@@ -43,16 +43,19 @@
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/startup_phase_timings.h"
 #include "mongo/db/storage/durable_catalog_impl.h"
 #include "mongo/db/storage/durable_history_pin.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -105,6 +108,9 @@ StorageEngineImpl::StorageEngineImpl(OperationContext* opCtx,
 }
 
 void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState lastShutdownState) {
+    boost::optional<StartupPhaseTimings::ScopedPhase> readCatalogPhase;
+    readCatalogPhase.emplace(opCtx->getServiceContext(), "loadCatalogReadEntries");
+
     bool catalogExists = _engine->hasIdent(opCtx, catalogInfo);
     if (_options.forRepair && catalogExists) {
         auto repairObserver = StorageRepairObserver::get(getGlobalServiceContext());
@@ -235,6 +241,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         }
     }
 
+    std::vector<CollectionToLoad> collectionsToLoad;
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -289,7 +296,7 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        collectionsToLoad.push_back({entry.catalogId, entry.nss, minVisibleTs});
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
@@ -298,6 +305,24 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
                   "namespace"_attr = entry.nss);
         }
     }
+    readCatalogPhase.reset();
+
+    std::vector<std::shared_ptr<Collection>> collections;
+    {
+        StartupPhaseTimings::ScopedPhase openCollectionsPhase(opCtx->getServiceContext(),
+                                                              "loadCatalogOpenCollections");
+        collections = _makeCollections(opCtx, collectionsToLoad, _options.forRepair);
+    }
+
+    // Publish every collection in a single write, as each write to the CollectionCatalog copies it.
+    StartupPhaseTimings::ScopedPhase registerCollectionsPhase(opCtx->getServiceContext(),
+                                                              "loadCatalogRegisterCollections");
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        for (auto& collection : collections) {
+            auto uuid = collection->uuid();
+            catalog.registerCollection(opCtx, uuid, std::move(collection));
+        }
+    });
 
     opCtx->recoveryUnit()->abandonSnapshot();
 }
@@ -307,6 +332,18 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         const NamespaceString& nss,
                                         bool forRepair,
                                         Timestamp minVisibleTs) {
+    auto collection = _makeCollection(opCtx, catalogId, nss, forRepair, minVisibleTs);
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        auto uuid = collection->uuid();
+        catalog.registerCollection(opCtx, uuid, std::move(collection));
+    });
+}
+
+std::shared_ptr<Collection> StorageEngineImpl::_makeCollection(OperationContext* opCtx,
+                                                               RecordId catalogId,
+                                                               const NamespaceString& nss,
+                                                               bool forRepair,
+                                                               Timestamp minVisibleTs) {
     auto md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -327,10 +364,105 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, md, std::move(rs));
     collection->setMinimumVisibleSnapshot(minVisibleTs);
+    return collection;
+}
 
-    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
-        catalog.registerCollection(opCtx, md->options.uuid.get(), std::move(collection));
-    });
+std::vector<std::shared_ptr<Collection>> StorageEngineImpl::_makeCollections(
+    OperationContext* opCtx,
+    const std::vector<CollectionToLoad>& collectionsToLoad,
+    bool forRepair) {
+    std::vector<std::shared_ptr<Collection>> collections(collectionsToLoad.size());
+
+    const size_t numThreads = std::min(
+        static_cast<size_t>(gStorageEngineCatalogLoadThreads.load()), collectionsToLoad.size());
+    if (forRepair || numThreads <= 1) {
+        for (size_t i = 0; i < collectionsToLoad.size(); ++i) {
+            const auto& toLoad = collectionsToLoad[i];
+            collections[i] = _makeCollection(
+                opCtx, toLoad.catalogId, toLoad.nss, forRepair, toLoad.minVisibleTs);
+        }
+        return collections;
+    }
+
+    LOGV2_FOR_RECOVERY(5962201,
+                       kCatalogLogLevel.toInt(),
+                       "Opening collections in parallel",
+                       "numCollections"_attr = collectionsToLoad.size(),
+                       "numThreads"_attr = numThreads);
+
+    // The oplog is opened on the calling operation, as opening it also starts the oplog visibility
+    // thread. Every other collection is opened by whichever thread claims it next, and the first
+    // error stops every thread.
+    AtomicWord<size_t> nextToLoad{0};
+    Mutex mutex = MONGO_MAKE_LATCH("StorageEngineImpl::_makeCollections::mutex");
+    Status status = Status::OK();
+
+    auto stopOnError = [&](const DBException& ex) {
+        stdx::lock_guard<Latch> lk(mutex);
+        if (status.isOK()) {
+            status = ex.toStatus();
+        }
+        nextToLoad.store(collectionsToLoad.size());
+    };
+
+    auto loadCollections = [&] {
+        auto workerOpCtx = cc().makeOperationContext();
+        workerOpCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(_engine->newRecoveryUnit()),
+                                     WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+
+        for (size_t i = nextToLoad.fetchAndAdd(1); i < collectionsToLoad.size();
+             i = nextToLoad.fetchAndAdd(1)) {
+            const auto& toLoad = collectionsToLoad[i];
+            if (toLoad.nss.isOplog()) {
+                continue;
+            }
+
+            try {
+                collections[i] = _makeCollection(workerOpCtx.get(),
+                                                 toLoad.catalogId,
+                                                 toLoad.nss,
+                                                 forRepair,
+                                                 toLoad.minVisibleTs);
+            } catch (const DBException& ex) {
+                stopOnError(ex);
+                return;
+            }
+        }
+    };
+
+    ThreadPool::Options options;
+    options.poolName = "CatalogLoad";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) { Client::initThread(threadName); };
+    ThreadPool pool(options);
+    pool.startup();
+    for (size_t i = 0; i < numThreads; ++i) {
+        pool.schedule([&](Status scheduleStatus) {
+            invariant(scheduleStatus);
+            loadCollections();
+        });
+    }
+
+    for (size_t i = 0; i < collectionsToLoad.size(); ++i) {
+        const auto& toLoad = collectionsToLoad[i];
+        if (!toLoad.nss.isOplog()) {
+            continue;
+        }
+
+        try {
+            collections[i] = _makeCollection(
+                opCtx, toLoad.catalogId, toLoad.nss, forRepair, toLoad.minVisibleTs);
+        } catch (const DBException& ex) {
+            stopOnError(ex);
+        }
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    uassertStatusOK(status);
+    return collections;
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
@@ -1028,6 +1160,10 @@ bool StorageEngineImpl::supportsOplogStones() const {
     return _engine->supportsOplogStones();
 }
 
+boost::optional<double> StorageEngineImpl::getCacheDirtyPercentage() const {
+    return _engine->getCacheDirtyPercentage();
+}
+
 bool StorageEngineImpl::supportsResumableIndexBuilds() const {
     return supportsReadConcernMajority() && !isEphemeral() &&
         !repl::ReplSettings::shouldRecoverFromOplogAsStandalone();
@@ -33,6 +33,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
@@ -50,6 +51,7 @@
 
 namespace mongo {
 
+class Collection;
 class DurableCatalogImpl;
 class KVEngine;
 
@@ -156,6 +158,8 @@ public:
 
     bool supportsOplogStones() const final;
 
+    boost::optional<double> getCacheDirtyPercentage() const final;
+
     bool supportsResumableIndexBuilds() const final;
 
     bool supportsPendingDrops() const final;
@@ -361,12 +365,38 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
+    struct CollectionToLoad {
+        RecordId catalogId;
+        NamespaceString nss;
+        Timestamp minVisibleTs;
+    };
+
     void _initCollection(OperationContext* opCtx,
                          RecordId catalogId,
                          const NamespaceString& nss,
                          bool forRepair,
                          Timestamp minVisibleTs);
 
+    /**
+     * Opens the record store of the collection with the given catalog entry and builds its
+     * in-memory Collection, without registering it in the CollectionCatalog.
+     */
+    std::shared_ptr<Collection> _makeCollection(OperationContext* opCtx,
+                                                RecordId catalogId,
+                                                const NamespaceString& nss,
+                                                bool forRepair,
+                                                Timestamp minVisibleTs);
+
+    /**
+     * Builds the Collections of 'collectionsToLoad', in the same order, on up to
+     * 'storageEngineCatalogLoadThreads' threads. The caller must hold the global lock in exclusive
+     * mode, as the threads take no locks. Throws the first error of any thread.
+     */
+    std::vector<std::shared_ptr<Collection>> _makeCollections(
+        OperationContext* opCtx,
+        const std::vector<CollectionToLoad>& collectionsToLoad,
+        bool forRepair);
+
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx, const std::vector<UUID>& toDrop);
 
     /**
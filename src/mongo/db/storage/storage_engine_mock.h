@@ -118,6 +118,9 @@ public:
     bool supportsOplogStones() const final {
         return false;
     }
+    boost::optional<double> getCacheDirtyPercentage() const final {
+        return boost::none;
+    }
     bool supportsResumableIndexBuilds() const final {
         return false;
     }
@@ -287,6 +287,40 @@ Status WiredTigerIndex::insert(OperationContext* opCtx,
     return _insert(opCtx, c, keyString, dupsAllowed);
 }
 
+Status WiredTigerIndex::insertBatch(OperationContext* opCtx,
+                                    const std::vector<KeyString::Value>& keyStrings,
+                                    const std::vector<Timestamp>& timestamps,
+                                    bool dupsAllowed) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    invariant(timestamps.empty() || timestamps.size() == keyStrings.size());
+
+    // Use a single cursor for the whole batch. When the keys are sorted, each insert lands on or
+    // next to the leaf page of the previous one, which is already in cache.
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+
+    Timestamp lastTimestamp;
+    for (size_t i = 0; i < keyStrings.size(); ++i) {
+        const auto& keyString = keyStrings[i];
+        dassertRecordIdAtEnd(keyString, _rsKeyFormat);
+        LOGV2_TRACE_INDEX(
+            5961700, "Batch insert KeyString: {keyString}", "keyString"_attr = keyString);
+
+        if (!timestamps.empty() && !timestamps[i].isNull() && timestamps[i] != lastTimestamp) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(timestamps[i]);
+            if (!status.isOK())
+                return status;
+            lastTimestamp = timestamps[i];
+        }
+
+        Status status = _insert(opCtx, c, keyString, dupsAllowed);
+        if (!status.isOK())
+            return status;
+    }
+    return Status::OK();
+}
+
 void WiredTigerIndex::unindex(OperationContext* opCtx,
                               const KeyString::Value& keyString,
                               bool dupsAllowed) {
@@ -87,6 +87,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
@@ -261,6 +262,8 @@ std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+AdaptiveTicketLimit openWriteTransactionLimit;
+AdaptiveTicketLimit openReadTransactionLimit;
 }  // namespace
 
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
@@ -516,6 +519,8 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    _readAheadPool = std::make_unique<WiredTigerReadAheadPool>(_sessionCache.get());
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -577,6 +582,12 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
+    _ticketController = std::make_unique<WiredTigerTicketController>(
+        _sessionCache.get(),
+        WiredTigerTicketController::Tickets{&openReadTransaction, &openReadTransactionLimit},
+        WiredTigerTicketController::Tickets{&openWriteTransaction, &openWriteTransactionLimit});
+    _ticketController->go();
+
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
     _runTimeConfigParam->_data.second = this;
@@ -604,6 +615,14 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            openWriteTransactionLimit.report(&adaptive);
+        }
+        {
+            BSONObjBuilder priorities(bbb.subobjStart("priorities"));
+            openWriteTransaction.appendPriorityStats(&priorities);
+        }
         bbb.done();
     }
     {
@@ -611,6 +630,14 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        {
+            BSONObjBuilder adaptive(bbb.subobjStart("adaptive"));
+            openReadTransactionLimit.report(&adaptive);
+        }
+        {
+            BSONObjBuilder priorities(bbb.subobjStart("priorities"));
+            openReadTransaction.appendPriorityStats(&priorities);
+        }
         bbb.done();
     }
     bb.done();
@@ -723,6 +750,12 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_readAheadPool) {
+        _readAheadPool->shutdown();
+    }
+    if (_ticketController) {
+        _ticketController->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -1646,8 +1679,12 @@ Status WiredTigerKVEngine::dropIdent(RecoveryUnit* ru,
 
     WiredTigerSession session(_conn);
 
-    int ret = session.getSession()->drop(
-        session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
+    int ret;
+    {
+        WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(_readAheadPool.get());
+        ret = session.getSession()->drop(
+            session.getSession(), uri.c_str(), "force,checkpoint_wait=false");
+    }
     LOGV2_DEBUG(22338, 1, "WT drop", "uri"_attr = uri, "ret"_attr = ret);
 
     if (ret == EBUSY) {
@@ -1695,7 +1732,10 @@ void WiredTigerKVEngine::dropIdentForImport(OperationContext* opCtx, StringData
 
         ++attempt;
 
-        ret = session.getSession()->drop(session.getSession(), uri.c_str(), config.c_str());
+        {
+            WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(_readAheadPool.get());
+            ret = session.getSession()->drop(session.getSession(), uri.c_str(), config.c_str());
+        }
         logAndBackoff(5114600,
                       ::mongo::logv2::LogComponent::kStorage,
                       logv2::LogSeverity::Debug(1),
@@ -1771,6 +1811,7 @@ void WiredTigerKVEngine::dropSomeQueuedIdents() {
                 "WT Queue: attempting to drop tables",
                 "numInQueue"_attr = numInQueue,
                 "numToDelete"_attr = numToDelete);
+    WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(_readAheadPool.get());
     for (int i = 0; i < numToDelete; i++) {
         IdentToDrop identToDrop;
         {
@@ -2225,7 +2266,13 @@ StatusWith<Timestamp> WiredTigerKVEngine::recoverToStableTimestamp(OperationCont
                        "Rolling back to the stable timestamp",
                        "stableTimestamp"_attr = stableTimestamp,
                        "initialDataTimestamp"_attr = initialDataTimestamp);
-    int ret = _conn->rollback_to_stable(_conn, nullptr);
+    int ret;
+    {
+        // Rollback to stable fails if any session has a transaction active, including the
+        // implicit transactions of the cursors of the read-ahead.
+        WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(_readAheadPool.get());
+        ret = _conn->rollback_to_stable(_conn, nullptr);
+    }
     if (ret) {
         return {ErrorCodes::UnrecoverableRollbackError,
                 str::stream() << "Error rolling back to stable. Err: " << wiredtiger_strerror(ret)};
@@ -2469,6 +2516,22 @@ bool WiredTigerKVEngine::supportsOplogStones() const {
     return true;
 }
 
+boost::optional<double> WiredTigerKVEngine::getCacheDirtyPercentage() const {
+    auto session = _sessionCache->getSession();
+    auto dirtyBytes = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                         "statistics:",
+                                                         "statistics=(fast)",
+                                                         WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    auto maxBytes = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                       "statistics:",
+                                                       "statistics=(fast)",
+                                                       WT_STAT_CONN_CACHE_BYTES_MAX);
+    if (!dirtyBytes.isOK() || !maxBytes.isOK() || maxBytes.getValue() <= 0) {
+        return boost::none;
+    }
+    return 100.0 * dirtyBytes.getValue() / maxBytes.getValue();
+}
+
 void WiredTigerKVEngine::startOplogManager(OperationContext* opCtx,
                                            WiredTigerRecordStore* oplogRecordStore) {
     stdx::lock_guard<Latch> lock(_oplogManagerMutex);
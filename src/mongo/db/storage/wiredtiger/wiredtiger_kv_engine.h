@@ -43,6 +43,7 @@
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/platform/mutex.h"
@@ -56,6 +57,7 @@ class JournalListener;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
+class WiredTigerTicketController;
 class WiredTigerEngineRuntimeConfigParameter;
 
 struct WiredTigerFileVersion {
@@ -255,6 +257,8 @@ public:
 
     bool supportsOplogStones() const final override;
 
+    boost::optional<double> getCacheDirtyPercentage() const override;
+
     bool supportsReadConcernMajority() const final;
 
     // wiredtiger specific
@@ -297,6 +301,10 @@ public:
         return _oplogManager.get();
     }
 
+    WiredTigerReadAheadPool* getReadAheadPool() const {
+        return _readAheadPool.get();
+    }
+
     static void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -456,6 +464,9 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
 
+    std::unique_ptr<WiredTigerReadAheadPool> _readAheadPool;
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
+
     std::string _rsOptions;
     std::string _indexOptions;
 
@@ -82,6 +82,7 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
                                           WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
                                           oplogRecordStore);
 
+    _oplogRecordStore = oplogRecordStore;
     _isRunning = true;
     _shuttingDown = false;
 }
@@ -102,6 +103,7 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
         _shuttingDown = true;
         _isRunning = false;
+        _oplogRecordStore = nullptr;
     }
 
     if (_oplogVisibilityThread.joinable()) {
@@ -118,6 +120,58 @@ void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
     }
 }
 
+void WiredTigerOplogManager::registerOplogHole(Timestamp ts) {
+    stdx::lock_guard<Latch> lk(_oplogHolesMutex);
+    _oplogHoles.insert(ts);
+}
+
+void WiredTigerOplogManager::fillOplogHole(Timestamp ts, boost::optional<Timestamp> lastWritten) {
+    uint64_t newTimestamp;
+    bool wasEarliestHole;
+    {
+        stdx::lock_guard<Latch> lk(_oplogHolesMutex);
+        auto it = _oplogHoles.find(ts);
+        invariant(it != _oplogHoles.end(), ts.toString());
+        wasEarliestHole = it == _oplogHoles.begin();
+        _oplogHoles.erase(it);
+
+        if (lastWritten && *lastWritten > _latestOplogHoleWrite) {
+            _latestOplogHoleWrite = *lastWritten;
+        }
+
+        // Every oplog write before the earliest remaining hole has committed or rolled back.
+        newTimestamp = _oplogHoles.empty() ? _latestOplogHoleWrite.asULL()
+                                           : _oplogHoles.begin()->asULL() - 1;
+    }
+
+    if (!lastWritten && wasEarliestHole) {
+        // A transaction may hold its optimes as a hole while another transaction writes the oplog
+        // entries at them, which it rolls back after the other one commits. Those entries are not
+        // known here, so have the oplog visibility thread find out from WiredTiger.
+        triggerOplogVisibilityUpdate();
+    }
+
+    if (newTimestamp <= getOplogReadTimestamp()) {
+        return;
+    }
+
+    WiredTigerRecordStore* oplogRecordStore;
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        // Concurrent commits may publish out of order, so avoid going backward.
+        if (newTimestamp <= getOplogReadTimestamp()) {
+            return;
+        }
+        _setOplogReadTimestamp(lk, newTimestamp);
+        oplogRecordStore = _oplogRecordStore;
+    }
+
+    // Wake up any awaitData cursors, as the oplog visibility thread does.
+    if (oplogRecordStore) {
+        oplogRecordStore->notifyCappedWaitersIfNeeded();
+    }
+}
+
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     const WiredTigerRecordStore* oplogRecordStore, OperationContext* opCtx) {
     invariant(opCtx->lockState()->isNoop() || !opCtx->lockState()->inAWriteUnitOfWork());
@@ -270,6 +324,15 @@ std::uint64_t WiredTigerOplogManager::getOplogReadTimestamp() const {
 }
 
 void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
+    {
+        // The oplog read timestamp is only set backward when the oplog is truncated, which makes
+        // writes after 'ts' no longer count towards visibility.
+        stdx::lock_guard<Latch> lk(_oplogHolesMutex);
+        if (_latestOplogHoleWrite > ts) {
+            _latestOplogHoleWrite = ts;
+        }
+    }
+
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
     _setOplogReadTimestamp(lk, ts.asULL());
 }
@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <set>
+
+#include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
@@ -43,8 +47,13 @@ class WiredTigerSessionCache;
 /**
  * Manages oplog visibility.
  *
- * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * Transactions which write oplog entries out of order on primaries register the first optime they
+ * reserve as an oplog hole, in optime order, and fill it when they commit or roll back. Filling the
+ * earliest hole forwards the oplog read timestamp inline, to just before the next earliest hole.
+ *
+ * Other out of order writes instead trigger an update of the oplog read timestamp from
+ * WiredTiger's all_durable timestamp value. This is done asynchronously on a thread that
+ * startVisibilityThread() will set up.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -79,6 +88,22 @@ public:
      */
     void triggerOplogVisibilityUpdate();
 
+    /**
+     * Records that a transaction may write oplog entries at and after 'ts' out of order. No oplog
+     * entry at or after 'ts' becomes visible until fillOplogHole() is called for it.
+     *
+     * Holes must be registered in the order of their timestamps, which reserving optimes under a
+     * mutex guarantees.
+     */
+    void registerOplogHole(Timestamp ts);
+
+    /**
+     * Records that the transaction which registered the oplog hole at 'ts' committed, having
+     * written entries up to 'lastWritten', or rolled back when 'lastWritten' is boost::none. If
+     * this was the earliest hole, forwards the oplog read timestamp and notifies its waiters.
+     */
+    void fillOplogHole(Timestamp ts, boost::optional<Timestamp> lastWritten);
+
     /**
      * Waits for all committed writes at this time to become visible (that is, until no holes exist
      * in the oplog up to the time we start waiting.)
@@ -132,5 +157,19 @@ private:
     // Incremented when a caller is waiting for more of the oplog to become visible, to avoid update
     // delays for batching.
     int64_t _opsWaitingForOplogVisibilityUpdate = 0;
+
+    // Notified when filling an oplog hole forwards the oplog read timestamp.
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
+    // Protects the oplog holes below. Kept apart from _oplogVisibilityStateMutex so that reserving
+    // optimes does not contend with oplog visibility waiters.
+    mutable Mutex _oplogHolesMutex = MONGO_MAKE_LATCH("WiredTigerOplogManager::_oplogHolesMutex");
+
+    // The first timestamps of the transactions which have registered an oplog hole and not yet
+    // committed or rolled back.
+    std::multiset<Timestamp> _oplogHoles;
+
+    // The latest timestamp written by a committed transaction which registered an oplog hole.
+    Timestamp _latestOplogHoleWrite;
 };
 }  // namespace mongo
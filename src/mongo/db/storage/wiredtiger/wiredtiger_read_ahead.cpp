@@ -0,0 +1,245 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+// Scans are independent of each other, so a handful of threads keeps several of them ahead
+// without competing with the scans for the disk.
+const size_t kMaxReadAheadThreads = 4;
+
+ThreadPool::Options makeThreadPoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "WiredTigerReadAhead";
+    options.minThreads = 0;
+    options.maxThreads = kMaxReadAheadThreads;
+    return options;
+}
+
+}  // namespace
+
+struct WiredTigerReadAhead::SharedState {
+    SharedState(std::string uri, KeyFormat keyFormat, bool forward, int64_t windowBytes)
+        : uri(std::move(uri)), keyFormat(keyFormat), forward(forward), windowBytes(windowBytes) {}
+
+    const std::string uri;
+    const KeyFormat keyFormat;
+    const bool forward;
+    const int64_t windowBytes;
+
+    // Set when the cursor goes away, so that the window being read is cut short.
+    AtomicWord<bool> abandoned{false};
+
+    // Set while a window is scheduled or being read.
+    AtomicWord<bool> reading{false};
+
+    // Protects 'lastReadId'.
+    Mutex mutex = MONGO_MAKE_LATCH("WiredTigerReadAhead::SharedState::mutex");
+
+    // The last record read by the most recent window.
+    RecordId lastReadId;
+};
+
+WiredTigerReadAheadPool::WiredTigerReadAheadPool(WiredTigerSessionCache* sessionCache)
+    : _sessionCache(sessionCache), _threadPool(makeThreadPoolOptions()) {
+    _threadPool.startup();
+}
+
+WiredTigerReadAheadPool::SuspendBlock::SuspendBlock(WiredTigerReadAheadPool* pool)
+    : _pool(pool) {
+    if (!_pool) {
+        return;
+    }
+
+    // The windows being read notice the suspension between records, so this does not wait long.
+    stdx::unique_lock<Latch> lk(_pool->_mutex);
+    _pool->_numSuspensions.fetchAndAdd(1);
+    _pool->_windowsDoneCV.wait(lk, [&] { return _pool->_numWindowsReading == 0; });
+}
+
+WiredTigerReadAheadPool::SuspendBlock::~SuspendBlock() {
+    if (!_pool) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_pool->_mutex);
+    _pool->_numSuspensions.fetchAndSubtract(1);
+}
+
+bool WiredTigerReadAheadPool::_beginWindow() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_shouldStopWindows()) {
+        return false;
+    }
+    ++_numWindowsReading;
+    return true;
+}
+
+void WiredTigerReadAheadPool::_endWindow() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (--_numWindowsReading == 0) {
+        _windowsDoneCV.notify_all();
+    }
+}
+
+void WiredTigerReadAheadPool::shutdown() {
+    _shuttingDown.store(true);
+    _threadPool.shutdown();
+    _threadPool.join();
+}
+
+WiredTigerReadAhead::WiredTigerReadAhead(WiredTigerReadAheadPool* pool,
+                                         std::string uri,
+                                         KeyFormat keyFormat,
+                                         bool forward,
+                                         int64_t windowBytes)
+    : _pool(pool),
+      _state(std::make_shared<SharedState>(std::move(uri), keyFormat, forward, windowBytes)),
+      // Read the first window as soon as the scan returns its first record.
+      _bytesSinceLastWindow(windowBytes) {}
+
+WiredTigerReadAhead::~WiredTigerReadAhead() {
+    _state->abandoned.store(true);
+}
+
+void WiredTigerReadAhead::onNext(const RecordId& id, size_t size) {
+    _bytesSinceLastWindow += size;
+    if (_bytesSinceLastWindow < _state->windowBytes / 2 || _state->reading.load()) {
+        return;
+    }
+
+    // Continue from the end of the previous window unless the scan has already gone past it, for
+    // example because it was repositioned.
+    RecordId start = id;
+    {
+        stdx::lock_guard<Latch> lk(_state->mutex);
+        const auto& lastReadId = _state->lastReadId;
+        if (!lastReadId.isNull() && (_state->forward ? lastReadId > id : lastReadId < id)) {
+            start = lastReadId;
+        }
+    }
+
+    _bytesSinceLastWindow = 0;
+    _state->reading.store(true);
+    _pool->_threadPool.schedule(
+        [pool = _pool, state = _state, start = std::move(start)](Status status) {
+            ON_BLOCK_EXIT([&] { state->reading.store(false); });
+            if (!status.isOK()) {
+                return;
+            }
+            _readWindow(pool, state.get(), start);
+        });
+}
+
+void WiredTigerReadAhead::_readWindow(WiredTigerReadAheadPool* pool,
+                                      SharedState* state,
+                                      const RecordId& start) {
+    if (state->abandoned.load() || !pool->_beginWindow()) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { pool->_endWindow(); });
+
+    // Released before the window ends, so that a suspension finds no session of the read-ahead
+    // with an open cursor.
+    auto session = pool->_sessionCache->getSession();
+    WT_CURSOR* cursor;
+    try {
+        cursor = session->getNewCursor(state->uri);
+    } catch (const DBException&) {
+        // The table is being dropped or is otherwise in exclusive use. Read-ahead is only a hint,
+        // so give up on this window.
+        return;
+    }
+    ON_BLOCK_EXIT([&] { session->closeCursor(cursor); });
+
+    // Each cursor call below runs in its own implicit transaction. The records are only read to
+    // bring their pages into the cache, so it does not matter which snapshot they come from, and
+    // any error, such as a prepare conflict, simply ends the window.
+    int ret;
+    if (state->keyFormat == KeyFormat::Long) {
+        cursor->set_key(cursor, start.getLong());
+        int cmp;
+        ret = cursor->search_near(cursor, &cmp);
+    } else {
+        auto str = start.getStr();
+        WiredTigerItem key(str.rawData(), str.size());
+        cursor->set_key(cursor, key.Get());
+        int cmp;
+        ret = cursor->search_near(cursor, &cmp);
+    }
+
+    int64_t bytesRead = 0;
+    while (ret == 0 && bytesRead < state->windowBytes) {
+        if (pool->_shouldStopWindows() || state->abandoned.load()) {
+            return;
+        }
+
+        WT_ITEM value;
+        ret = cursor->get_value(cursor, &value);
+        if (ret != 0) {
+            break;
+        }
+        bytesRead += value.size;
+
+        ret = state->forward ? cursor->next(cursor) : cursor->prev(cursor);
+    }
+
+    if (ret != 0) {
+        return;
+    }
+
+    RecordId lastReadId;
+    if (state->keyFormat == KeyFormat::Long) {
+        int64_t key;
+        if (cursor->get_key(cursor, &key) != 0) {
+            return;
+        }
+        lastReadId = RecordId(key);
+    } else {
+        WT_ITEM key;
+        if (cursor->get_key(cursor, &key) != 0) {
+            return;
+        }
+        lastReadId = RecordId(static_cast<const char*>(key.data), key.size);
+    }
+
+    stdx::lock_guard<Latch> lk(state->mutex);
+    state->lastReadId = std::move(lastReadId);
+}
+
+}  // namespace mongo
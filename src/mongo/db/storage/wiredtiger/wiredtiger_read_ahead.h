@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_format.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class WiredTigerSessionCache;
+
+/**
+ * Runs the read-ahead of sequential scans over WiredTiger tables. Each read-ahead walks a window
+ * of records beyond the position of a scan on a session of its own, so that the pages holding them
+ * are read into the WiredTiger cache while the scan is still processing earlier records.
+ *
+ * There is one instance per WiredTigerKVEngine. It must be shut down before the session cache.
+ */
+class WiredTigerReadAheadPool {
+    WiredTigerReadAheadPool(const WiredTigerReadAheadPool&) = delete;
+    WiredTigerReadAheadPool& operator=(const WiredTigerReadAheadPool&) = delete;
+
+public:
+    explicit WiredTigerReadAheadPool(WiredTigerSessionCache* sessionCache);
+
+    /**
+     * Suspends read-ahead while in scope. Its constructor cuts short the windows being read and
+     * waits for them to end, and read-ahead requested meanwhile is ignored.
+     *
+     * The sessions of the read-ahead hold no locks, so WiredTiger operations which fail while any
+     * other session has a transaction active or a table open, such as rollback to stable, drop,
+     * verify and alter, must run in the scope of a SuspendBlock. A null pool suspends nothing.
+     */
+    class SuspendBlock {
+        SuspendBlock(const SuspendBlock&) = delete;
+        SuspendBlock& operator=(const SuspendBlock&) = delete;
+
+    public:
+        explicit SuspendBlock(WiredTigerReadAheadPool* pool);
+        ~SuspendBlock();
+
+    private:
+        WiredTigerReadAheadPool* const _pool;
+    };
+
+    /**
+     * Stops the read-ahead in progress and waits for the worker threads to exit. Read-ahead
+     * requested afterwards is ignored.
+     */
+    void shutdown();
+
+private:
+    friend class WiredTigerReadAhead;
+
+    /**
+     * Registers a window about to be read. Returns false if read-ahead is suspended or shutting
+     * down, in which case the window must not be read.
+     */
+    bool _beginWindow();
+
+    void _endWindow();
+
+    bool _shouldStopWindows() const {
+        return _shuttingDown.load() || _numSuspensions.load() > 0;
+    }
+
+    WiredTigerSessionCache* const _sessionCache;
+
+    AtomicWord<bool> _shuttingDown{false};
+
+    // Protects _numWindowsReading, and the changes to _numSuspensions.
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerReadAheadPool::_mutex");
+
+    // Signaled when the last window being read ends.
+    stdx::condition_variable _windowsDoneCV;
+
+    // Number of SuspendBlocks in scope. Read without _mutex by the windows being read.
+    AtomicWord<int> _numSuspensions{0};
+
+    // Number of windows being read, each on a session of its own.
+    int _numWindowsReading = 0;
+
+    ThreadPool _threadPool;
+};
+
+/**
+ * Read-ahead state of a single record store cursor. The cursor reports each record it returns, and
+ * a new window is read ahead each time the scan has consumed half of the previous one. Windows are
+ * read one at a time, each starting where the previous one ended or at the scan position,
+ * whichever is further along. Not thread-safe.
+ */
+class WiredTigerReadAhead {
+    WiredTigerReadAhead(const WiredTigerReadAhead&) = delete;
+    WiredTigerReadAhead& operator=(const WiredTigerReadAhead&) = delete;
+
+public:
+    WiredTigerReadAhead(WiredTigerReadAheadPool* pool,
+                        std::string uri,
+                        KeyFormat keyFormat,
+                        bool forward,
+                        int64_t windowBytes);
+
+    /**
+     * Abandons any read-ahead in progress, without waiting for it.
+     */
+    ~WiredTigerReadAhead();
+
+    /**
+     * Called by the cursor with each record it returns.
+     */
+    void onNext(const RecordId& id, size_t size);
+
+private:
+    struct SharedState;
+
+    static void _readWindow(WiredTigerReadAheadPool* pool,
+                            SharedState* state,
+                            const RecordId& start);
+
+    WiredTigerReadAheadPool* const _pool;
+
+    // State shared with the read-ahead task in progress, which may outlive this object.
+    std::shared_ptr<SharedState> _state;
+
+    // Bytes returned by the cursor since the last window was scheduled.
+    int64_t _bytesSinceLastWindow;
+};
+
+}  // namespace mongo
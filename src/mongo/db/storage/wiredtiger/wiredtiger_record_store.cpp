@@ -60,6 +60,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -1311,6 +1312,7 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             // value to make progress.
             ts = Timestamp(record.id.getLong());
             opCtx->recoveryUnit()->setOrderedCommit(false);
+            WiredTigerRecoveryUnit::get(opCtx)->registerOplogHole(ts);
         } else {
             ts = timestamps[i];
         }
@@ -1435,6 +1437,22 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
                                            const RecordId& id,
                                            const char* data,
                                            int len) {
+    return _updateRecord(opCtx, id, data, len, nullptr);
+}
+
+Status WiredTigerRecordStore::updateRecordWithDamageHint(OperationContext* opCtx,
+                                                         const RecordId& id,
+                                                         const char* data,
+                                                         int len,
+                                                         const mutablebson::DamageVector& damages) {
+    return _updateRecord(opCtx, id, data, len, &damages);
+}
+
+Status WiredTigerRecordStore::_updateRecord(OperationContext* opCtx,
+                                            const RecordId& id,
+                                            const char* data,
+                                            int len,
+                                            const mutablebson::DamageVector* damages) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
 
@@ -1474,6 +1492,9 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     //
     // Skip modify for logged tables: don't trust WiredTiger's recovery with operations that are not
     // idempotent.
+    //
+    // When the caller already knows which bytes changed, translate its damage events directly into
+    // modify entries. These are not limited in number, only in the amount of new data they carry.
     const int kMinLengthForDiff = 1024;
     const int kMaxEntries = 16;
     const int kMaxDiffBytes = len / 10;
@@ -1482,11 +1503,34 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     if (!_forceUpdateWithFullDocument && !_isLogged && len > kMinLengthForDiff &&
         len <= old_length + kMaxDiffBytes) {
         int nentries = kMaxEntries;
-        std::vector<WT_MODIFY> entries(nentries);
+        std::vector<WT_MODIFY> entries;
+
+        if (damages) {
+            size_t damageBytes = 0;
+            for (const auto& damage : *damages) {
+                damageBytes += damage.sourceSize;
+            }
+            if (damageBytes <= static_cast<size_t>(kMaxDiffBytes)) {
+                entries.resize(damages->size());
+                for (size_t i = 0; i < damages->size(); ++i) {
+                    const auto& damage = (*damages)[i];
+                    entries[i].data.data = data + damage.sourceOffset;
+                    entries[i].data.size = damage.sourceSize;
+                    entries[i].offset = damage.targetOffset;
+                    entries[i].size = damage.targetSize;
+                }
+                nentries = entries.size();
+                ret = 0;
+            } else {
+                ret = WT_NOTFOUND;
+            }
+        } else {
+            entries.resize(nentries);
+            ret = wiredtiger_calc_modify(
+                c->session, &old_value, value.Get(), kMaxDiffBytes, entries.data(), &nentries);
+        }
 
-        if ((ret = wiredtiger_calc_modify(
-                 c->session, &old_value, value.Get(), kMaxDiffBytes, entries.data(), &nentries)) ==
-            0) {
+        if (ret == 0) {
             invariantWTOK(WT_OP_CHECK(
                 nentries == 0 ? c->reserve(c)
                               : wiredTigerCursorModify(opCtx, c, entries.data(), nentries)));
@@ -1598,6 +1642,34 @@ Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     return Status::OK();
 }
 
+Status WiredTigerRecordStore::rangeTruncate(OperationContext* opCtx,
+                                            const RecordId& minRecordId,
+                                            const RecordId& maxRecordId,
+                                            int64_t numRecords,
+                                            int64_t dataSize) {
+    invariant(!_oplogStones);
+    invariant(minRecordId <= maxRecordId);
+
+    // The bounds do not need to name existing records. WiredTiger removes every key between them
+    // without returning the values, which avoids a separate remove call per record.
+    WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* start = startWrap.get();
+    CursorKey startKey = makeCursorKey(minRecordId, _keyFormat);
+    setKey(start, &startKey);
+
+    WiredTigerCursor stopWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* stop = stopWrap.get();
+    CursorKey stopKey = makeCursorKey(maxRecordId, _keyFormat);
+    setKey(stop, &stopKey);
+
+    WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    invariantWTOK(WT_OP_CHECK(session->truncate(session, nullptr, start, stop, nullptr)));
+
+    _changeNumRecords(opCtx, -numRecords);
+    _increaseDataSize(opCtx, -dataSize);
+    return Status::OK();
+}
+
 Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
     dassert(opCtx->lockState()->isWriteLocked());
 
@@ -1972,9 +2044,12 @@ Status WiredTigerRecordStore::oplogDiskLocRegister(OperationContext* opCtx,
     opCtx->recoveryUnit()->setOrderedCommit(orderedCommit);
 
     if (!orderedCommit) {
+        // Optimes are reserved in order, so the oplog holes are registered in order.
+        WiredTigerRecoveryUnit::get(opCtx)->registerOplogHole(ts);
+
         // This labels the current transaction with a timestamp.
-        // This is required for oplog visibility to work correctly, as WiredTiger uses the
-        // transaction list to determine where there are holes in the oplog.
+        // This is required for the oplog visibility thread to work correctly, as WiredTiger uses
+        // the transaction list to determine where there are holes in the oplog.
         return opCtx->recoveryUnit()->setTimestamp(ts);
     }
 
@@ -2060,10 +2135,30 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
     metricsCollector.incrementOneDocRead(value.size);
 
+    if (_readAhead) {
+        _readAhead->onNext(id, value.size);
+    }
+
     _lastReturnedId = id;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::enableReadAhead() {
+    const auto windowBytes = gWiredTigerReadAheadBytes.load();
+    // In-memory tables have no reads to overlap, and oplog scans are served from its most recent
+    // entries, which are typically in the cache.
+    if (windowBytes == 0 || _rs._isEphemeral || _rs._isOplog || _readAhead) {
+        return;
+    }
+
+    auto pool = _rs._kvEngine->getReadAheadPool();
+    if (!pool) {
+        return;
+    }
+    _readAhead = std::make_unique<WiredTigerReadAhead>(
+        pool, _rs.getURI(), _rs.keyFormat(), _forward, windowBytes);
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
     invariant(_hasRestored);
     if (_forward && _oplogVisibleTs && id.getLong() > *_oplogVisibleTs) {
@@ -157,6 +157,12 @@ public:
                                 const char* data,
                                 int len);
 
+    virtual Status updateRecordWithDamageHint(OperationContext* opCtx,
+                                              const RecordId& recordId,
+                                              const char* data,
+                                              int len,
+                                              const mutablebson::DamageVector& damages);
+
     virtual bool updateWithDamagesSupported() const;
 
     virtual StatusWith<RecordData> updateWithDamages(OperationContext* opCtx,
@@ -172,6 +178,12 @@ public:
 
     virtual Status truncate(OperationContext* opCtx);
 
+    virtual Status rangeTruncate(OperationContext* opCtx,
+                                 const RecordId& minRecordId,
+                                 const RecordId& maxRecordId,
+                                 int64_t numRecords,
+                                 int64_t dataSize);
+
     virtual bool compactSupported() const {
         return !_isEphemeral;
     }
@@ -318,6 +330,16 @@ private:
     void _changeNumRecords(OperationContext* opCtx, int64_t diff);
     void _increaseDataSize(OperationContext* opCtx, int64_t amount);
 
+    /**
+     * Shared implementation of updateRecord() and updateRecordWithDamageHint(). When 'damages' is
+     * provided it is used to modify the record in place of a difference computed by WiredTiger.
+     */
+    Status _updateRecord(OperationContext* opCtx,
+                         const RecordId& id,
+                         const char* data,
+                         int len,
+                         const mutablebson::DamageVector* damages);
+
     const std::string _uri;
     const uint64_t _tableId;  // not persisted
 
@@ -402,6 +424,8 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx);
 
+    void enableReadAhead();
+
 protected:
     virtual RecordId getKey(WT_CURSOR* cursor) const = 0;
 
@@ -421,6 +445,9 @@ protected:
     RecordId _lastReturnedId;  // If null, need to seek to first/last record.
     bool _hasRestored = true;
 
+    // Set once the owner of this cursor requested read-ahead.
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;
+
 private:
     bool isVisible(const RecordId& id);
 
@@ -41,6 +41,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context_noop.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
@@ -203,6 +204,83 @@ TEST(WiredTigerRecordStoreTest, Isolation2) {
     }
 }
 
+TEST(WiredTigerRecordStoreTest, ReadAheadDoesNotChangeScanResults) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    // Use a window of a few records so that the scan schedules many of them.
+    const auto originalReadAheadBytes = gWiredTigerReadAheadBytes.load();
+    gWiredTigerReadAheadBytes.store(64);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadAheadBytes.store(originalReadAheadBytes); });
+
+    const int numRecords = 1000;
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < numRecords; i++) {
+            std::string data = "record " + std::to_string(i);
+            auto res = rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    for (bool forward : {true, false}) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get(), forward);
+        cursor->enableReadAhead();
+
+        for (int i = 0; i < numRecords; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(ids[forward ? i : numRecords - 1 - i], record->id);
+        }
+        ASSERT_FALSE(cursor->next());
+    }
+}
+
+TEST(WiredTigerRecordStoreTest, VerifyWaitsForReadAheadToStop) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    const auto uri = checked_cast<WiredTigerRecordStore*>(rs.get())->getURI();
+
+    const auto originalReadAheadBytes = gWiredTigerReadAheadBytes.load();
+    gWiredTigerReadAheadBytes.store(64);
+    ON_BLOCK_EXIT([&] { gWiredTigerReadAheadBytes.store(originalReadAheadBytes); });
+
+    const int numRecords = 1000;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < numRecords; i++) {
+            std::string data = "record " + std::to_string(i);
+            auto res = rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+        }
+        uow.commit();
+    }
+
+    for (int attempt = 0; attempt < 10; attempt++) {
+        // Leave the windows scheduled by the scan in progress when the cursor goes away.
+        {
+            ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+            auto cursor = rs->getCursor(opCtx.get());
+            cursor->enableReadAhead();
+            for (int i = 0; i < numRecords / 2; i++) {
+                ASSERT(cursor->next());
+            }
+        }
+
+        // Verify requires exclusive access to the table, which the sessions of the read-ahead
+        // must not prevent.
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        std::vector<std::string> errors;
+        ASSERT_EQ(0, WiredTigerUtil::verifyTable(opCtx.get(), uri, &errors));
+    }
+}
+
 StatusWith<RecordId> insertBSON(ServiceContext::UniqueOperationContext& opCtx,
                                 unique_ptr<RecordStore>& rs,
                                 const Timestamp& opTime) {
@@ -231,8 +309,8 @@ RecordId _oplogOrderInsertOplog(OperationContext* opCtx,
     return res.getValue();
 }
 
-// Test that even when the oplog durability loop is paused, we can still advance the commit point as
-// long as the commit for each insert comes before the next insert starts.
+// Test that even when the oplog visibility loop is paused, each oplog entry becomes visible as soon
+// as it commits when no earlier entry is in flight.
 TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityInOrder) {
     ON_BLOCK_EXIT([] { WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::off); });
     WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::alwaysOn);
@@ -247,7 +325,7 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityInOrder) {
         RecordId id = _oplogOrderInsertOplog(opCtx.get(), rs, 1);
         ASSERT(wtrs->isOpHidden_forTest(id));
         uow.commit();
-        ASSERT(wtrs->isOpHidden_forTest(id));
+        ASSERT(!wtrs->isOpHidden_forTest(id));
     }
 
     {
@@ -256,8 +334,39 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityInOrder) {
         RecordId id = _oplogOrderInsertOplog(opCtx.get(), rs, 2);
         ASSERT(wtrs->isOpHidden_forTest(id));
         uow.commit();
-        ASSERT(wtrs->isOpHidden_forTest(id));
+        ASSERT(!wtrs->isOpHidden_forTest(id));
+    }
+}
+
+// Test that an oplog entry which rolls back while the oplog visibility loop is paused does not
+// hold back the visibility of later entries.
+TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityAfterRollback) {
+    ON_BLOCK_EXIT([] { WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::off); });
+    WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::alwaysOn);
+
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+    auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+
+    ServiceContext::UniqueOperationContext longLivedOp(harnessHelper->newOperationContext());
+    boost::optional<WriteUnitOfWork> rolledBackUow;
+    rolledBackUow.emplace(longLivedOp.get());
+    RecordId rolledBackId = _oplogOrderInsertOplog(longLivedOp.get(), rs, 1);
+
+    RecordId id;
+    {
+        auto innerClient = harnessHelper->serviceContext()->makeClient("inner");
+        ServiceContext::UniqueOperationContext opCtx(
+            harnessHelper->newOperationContext(innerClient.get()));
+        WriteUnitOfWork uow(opCtx.get());
+        id = _oplogOrderInsertOplog(opCtx.get(), rs, 2);
+        uow.commit();
     }
+    ASSERT(wtrs->isOpHidden_forTest(id));
+
+    rolledBackUow.reset();
+    ASSERT(!wtrs->isOpHidden_forTest(id));
+    ASSERT(!wtrs->isOpHidden_forTest(rolledBackId));
 }
 
 // Test that Oplog entries inserted while there are hidden entries do not become visible until the
@@ -291,22 +400,20 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityOutOfOrder) {
     ASSERT(wtrs->isOpHidden_forTest(id1));
     ASSERT(wtrs->isOpHidden_forTest(id2));
 
-    uow.commit();
-
-    ASSERT(wtrs->isOpHidden_forTest(id1));
-    ASSERT(wtrs->isOpHidden_forTest(id2));
-
-    // Wait a bit and check again to make sure they don't become visible automatically.
+    // Wait a bit and check again to make sure the later entry does not become visible while the
+    // earlier one is in flight.
     sleepsecs(1);
     ASSERT(wtrs->isOpHidden_forTest(id1));
     ASSERT(wtrs->isOpHidden_forTest(id2));
 
-    WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::off);
-
-    rs->waitForAllEarlierOplogWritesToBeVisible(longLivedOp.get());
+    // Committing the earliest entry makes every committed entry visible, even though the oplog
+    // visibility loop is paused.
+    uow.commit();
 
     ASSERT(!wtrs->isOpHidden_forTest(id1));
     ASSERT(!wtrs->isOpHidden_forTest(id2));
+
+    rs->waitForAllEarlierOplogWritesToBeVisible(longLivedOp.get());
 }
 
 TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
@@ -33,6 +33,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
@@ -461,18 +463,27 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
             22413, 3, "WT rollback_transaction", "snapshotId"_attr = getSnapshotId().toNumber());
     }
 
-    if (_isTimestamped) {
-        if (!_orderedCommit) {
-            // We only need to update oplog visibility where commits can be out-of-order with
-            // respect to their assigned optime. This will ensure the oplog read timestamp gets
-            // updated when oplog 'holes' are filled: the last commit filling the last hole will
-            // prompt the oplog read timestamp to be forwarded.
-            //
-            // This should happen only on primary nodes.
-            _oplogManager->triggerOplogVisibilityUpdate();
+    if (_oplogHoleTimestamp) {
+        // Filling the hole forwards the oplog read timestamp inline when this was the earliest
+        // transaction still writing to the oplog.
+        boost::optional<Timestamp> lastWritten;
+        if (commit && wtRet == 0) {
+            lastWritten = std::max({*_oplogHoleTimestamp,
+                                    _lastTimestampSet.value_or(Timestamp()),
+                                    _commitTimestamp,
+                                    _durableTimestamp});
         }
-        _isTimestamped = false;
-    }
+        _oplogManager->fillOplogHole(*_oplogHoleTimestamp, lastWritten);
+        _oplogHoleTimestamp = boost::none;
+    } else if (_isTimestamped && !_orderedCommit) {
+        // We only need to update oplog visibility where commits can be out-of-order with respect
+        // to their assigned optime. Transactions which did not register an oplog hole prompt the
+        // oplog visibility thread to recompute the oplog read timestamp from WiredTiger.
+        //
+        // This should happen only on primary nodes.
+        _oplogManager->triggerOplogVisibilityUpdate();
+    }
+    _isTimestamped = false;
     invariantWTOK(wtRet);
 
     invariant(!_lastTimestampSet || _commitTimestamp.isNull(),
@@ -769,6 +780,16 @@ void WiredTigerRecoveryUnit::_updateMultiTimestampConstraint(Timestamp timestamp
     timestampOrder.push(timestamp);
 }
 
+void WiredTigerRecoveryUnit::registerOplogHole(Timestamp ts) {
+    invariant(_inUnitOfWork(), toString(_getState()));
+    if (_oplogHoleTimestamp) {
+        return;
+    }
+
+    _oplogManager->registerOplogHole(ts);
+    _oplogHoleTimestamp = ts;
+}
+
 Status WiredTigerRecoveryUnit::setTimestamp(Timestamp timestamp) {
     _ensureSession();
     LOGV2_DEBUG(22415,
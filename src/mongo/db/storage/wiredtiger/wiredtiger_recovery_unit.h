@@ -216,6 +216,13 @@ public:
 
     boost::optional<int64_t> getOplogVisibilityTs();
 
+    /**
+     * Hides the oplog entries at and after 'ts' from forward oplog readers until this transaction
+     * commits or rolls back, for a transaction which may commit out of order with respect to the
+     * optimes it writes. Only the first call in a transaction has any effect.
+     */
+    void registerOplogHole(Timestamp ts);
+
     static WiredTigerRecoveryUnit* get(OperationContext* opCtx) {
         return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
     }
@@ -302,6 +309,10 @@ private:
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
     boost::optional<int64_t> _oplogVisibleTs = boost::none;
+
+    // The timestamp this transaction registered as an oplog hole with the oplog manager, which
+    // must be filled when the transaction commits or rolls back.
+    boost::optional<Timestamp> _oplogHoleTimestamp;
 };
 
 }  // namespace mongo
@@ -45,9 +45,24 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
+namespace {
+
+// Upper bound on the number of session cache shards, whatever the number of cores.
+const size_t kMaxSessionCacheShards = 64;
+
+size_t numSessionCacheShards() {
+    return std::max<size_t>(
+        1, std::min<size_t>(ProcessInfo::getNumAvailableCores(), kMaxSessionCacheShards));
+}
+
+// Hands out home shards to threads in turn.
+AtomicWord<size_t> nextHomeShard{0};
+
+}  // namespace
 
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
@@ -205,6 +220,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(new Shard[_numShards]),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -212,6 +229,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numShards(numSessionCacheShards()),
+      _shards(new Shard[_numShards]),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -377,25 +396,34 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<Latch> lock(_shards[i].lock);
+        for (auto session : _shards[i].sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
-    // Increment the cursor epoch so that all cursors from this epoch are closed.
+    // Increment the cursor epoch so that all cursors from this epoch are closed. Sessions released
+    // into a shard after it has been visited below see the new epoch in releaseSession().
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<Latch> lock(_shards[i].lock);
+        for (auto session : _shards[i].sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t i = 0; i < _numShards; i++) {
+        stdx::lock_guard<Latch> lock(_shards[i].lock);
+        count += _shards[i].sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,15 +435,17 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t i = 0; i < _numShards; i++) {
+        auto& shard = _shards[i];
+        stdx::lock_guard<Latch> lock(shard.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = shard.sessions.erase(it);
                 sessionsToClose.push_back(session);
+                _numIdleSessions.fetchAndSubtract(1);
             } else {
                 ++it;
             }
@@ -430,13 +460,18 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any shard is emptied, so a session of the old epoch cannot be released into a shard that has
+    // already been emptied.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t i = 0; i < _numShards; i++) {
+        auto& shard = _shards[i];
+        stdx::lock_guard<Latch> lock(shard.lock);
+        _numIdleSessions.fetchAndSubtract(shard.sessions.size());
+        swap.insert(swap.end(), shard.sessions.begin(), shard.sessions.end());
+        shard.sessions.clear();
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -444,6 +479,33 @@ void WiredTigerSessionCache::closeAll() {
     }
 }
 
+size_t WiredTigerSessionCache::_getHomeShard() const {
+    static thread_local const size_t homeShard = nextHomeShard.fetchAndAdd(1);
+    return homeShard % _numShards;
+}
+
+WiredTigerSession* WiredTigerSessionCache::_popSession(Shard& shard, SessionCache* staleSessions) {
+    stdx::lock_guard<Latch> lock(shard.lock);
+    while (!shard.sessions.empty()) {
+        // Get the most recently used session so that if we discard sessions, we're
+        // discarding older ones
+        WiredTigerSession* cachedSession = shard.sessions.back();
+        shard.sessions.pop_back();
+        _numIdleSessions.fetchAndSubtract(1);
+
+        // A concurrent closeAll() may not have emptied this shard yet.
+        if (cachedSession->_getEpoch() != _epoch.load()) {
+            staleSessions->push_back(cachedSession);
+            continue;
+        }
+
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return cachedSession;
+    }
+    return nullptr;
+}
+
 bool WiredTigerSessionCache::isEphemeral() {
     return _engine && _engine->isEphemeral();
 }
@@ -453,15 +515,22 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
+    SessionCache staleSessions;
+    ON_BLOCK_EXIT([&] {
+        for (auto session : staleSessions) {
+            delete session;
+        }
+    });
+
+    // Look in the home shard first, then steal from the other shards.
+    const size_t homeShard = _getHomeShard();
+    for (size_t i = 0; i < _numShards; i++) {
+        if (i > 0 && _numIdleSessions.load() == 0) {
+            break;
+        }
+
+        auto& shard = _shards[(homeShard + i) % _numShards];
+        if (auto cachedSession = _popSession(shard, &staleSessions)) {
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -521,10 +590,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _shards[_getHomeShard()];
+        stdx::lock_guard<Latch> lock(shard.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
+            _numIdleSessions.fetchAndAdd(1);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
 
 #include <wiredtiger.h>
@@ -38,6 +39,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -209,6 +211,11 @@ private:
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Idle sessions are kept in several shards, each with its own lock, so that concurrent
+ *  getSession() and releaseSession() calls do not all contend on a single mutex. Each thread is
+ *  assigned a home shard. It takes sessions from that shard and releases them into it, and it
+ *  steals from the other shards when its home shard is empty.
  */
 class WiredTigerSessionCache {
 public:
@@ -379,9 +386,32 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // This alignment is a best effort approach to ensure that each shard falls on a separate cache
+    // line in order to avoid false sharing.
+    struct alignas(stdx::hardware_destructive_interference_size) Shard {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::Shard::lock");
+        SessionCache sessions;
+    };
+
+    /**
+     * Returns the home shard of the calling thread.
+     */
+    size_t _getHomeShard() const;
+
+    /**
+     * Pops an idle session of the current epoch from the given shard, or returns nullptr. Sessions
+     * of an earlier epoch are appended to 'staleSessions' for the caller to close.
+     */
+    WiredTigerSession* _popSession(Shard& shard, SessionCache* staleSessions);
+
+    const size_t _numShards;
+    std::unique_ptr<Shard[]> _shards;
+
+    // Number of sessions across all shards. Allows getSession() to skip looking through the other
+    // shards when there is nothing to steal.
+    AtomicWord<size_t> _numIdleSessions{0};
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -0,0 +1,244 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+int AdaptiveTicketLimit::adjust(int current,
+                                const Sample& sample,
+                                int minTickets,
+                                int maxTickets) {
+    const double throughput = sample.elapsed > Milliseconds(0)
+        ? sample.released * 1000.0 / durationCount<Milliseconds>(sample.elapsed)
+        : 0;
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    Decision decision = Decision::kHold;
+    int next = current;
+    if (sample.cachePressure) {
+        decision = Decision::kDecrease;
+        next = static_cast<int>(current * kDecreaseFactor);
+    } else if (sample.queued > 0) {
+        if (_lastDecision == Decision::kIncrease &&
+            throughput < _lastThroughput * (1 - kThroughputTolerance)) {
+            decision = Decision::kBackOff;
+            next = current - kIncreaseStep;
+            _intervalsUntilIncrease = kIntervalsAfterBackOff;
+        } else if (_intervalsUntilIncrease > 0) {
+            _intervalsUntilIncrease--;
+        } else {
+            decision = Decision::kIncrease;
+            next = current + kIncreaseStep;
+        }
+    }
+
+    // The bounds may have changed since the last interval, in which case the current number of
+    // tickets is brought within them even if the load does not call for it.
+    next = std::max(minTickets, std::min(next, std::max(minTickets, maxTickets)));
+    if (next == current) {
+        decision = Decision::kHold;
+    } else if (decision == Decision::kHold) {
+        decision = next > current ? Decision::kIncrease : Decision::kDecrease;
+    }
+
+    switch (decision) {
+        case Decision::kIncrease:
+            _numIncreases++;
+            break;
+        case Decision::kDecrease:
+            _numDecreases++;
+            break;
+        case Decision::kBackOff:
+            _numBackOffs++;
+            break;
+        case Decision::kHold:
+            break;
+    }
+
+    _lastDecision = decision;
+    _lastThroughput = throughput;
+    return next;
+}
+
+void AdaptiveTicketLimit::report(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("lastDecision", decisionName(_lastDecision));
+    builder->append("lastThroughputPerSec", _lastThroughput);
+    builder->append("increases", _numIncreases);
+    builder->append("decreases", _numDecreases);
+    builder->append("backOffs", _numBackOffs);
+}
+
+StringData AdaptiveTicketLimit::decisionName(Decision decision) {
+    switch (decision) {
+        case Decision::kHold:
+            return "hold"_sd;
+        case Decision::kIncrease:
+            return "increase"_sd;
+        case Decision::kDecrease:
+            return "decrease"_sd;
+        case Decision::kBackOff:
+            return "backOff"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+WiredTigerTicketController::WiredTigerTicketController(WiredTigerSessionCache* sessionCache,
+                                                       Tickets readTickets,
+                                                       Tickets writeTickets)
+    : BackgroundJob(false /* deleteSelf */),
+      _sessionCache(sessionCache),
+      _readTickets(readTickets),
+      _writeTickets(writeTickets) {}
+
+void WiredTigerTicketController::run() {
+    ThreadClient tc(name(), getGlobalServiceContext());
+    LOGV2_DEBUG(5962400, 1, "Starting thread", "name"_attr = name());
+
+    Counters previous = _sampleCounters();
+    Timer timer;
+    while (!_shuttingDown.load()) {
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+            _condvar.wait_for(
+                lock,
+                Milliseconds(gWiredTigerAdaptiveConcurrentTransactionsIntervalMillis.load())
+                    .toSystemDuration(),
+                [&] { return _shuttingDown.load(); });
+        }
+        if (_shuttingDown.load()) {
+            break;
+        }
+
+        const Counters current = _sampleCounters();
+        const Milliseconds elapsed(timer.millis());
+        timer.reset();
+
+        // Keep sampling while disabled, so that the first interval after enabling only covers
+        // the load observed since the previous one.
+        if (gWiredTigerAdaptiveConcurrentTransactions.load()) {
+            const bool cachePressure = current.appEvictions > previous.appEvictions;
+            _adjust("read"_sd,
+                    _readTickets,
+                    {elapsed,
+                     current.readReleased - previous.readReleased,
+                     current.readQueued - previous.readQueued,
+                     cachePressure});
+            _adjust("write"_sd,
+                    _writeTickets,
+                    {elapsed,
+                     current.writeReleased - previous.writeReleased,
+                     current.writeQueued - previous.writeQueued,
+                     cachePressure});
+        }
+        previous = current;
+    }
+    LOGV2_DEBUG(5962401, 1, "Stopping thread", "name"_attr = name());
+}
+
+void WiredTigerTicketController::shutdown() {
+    _shuttingDown.store(true);
+    {
+        stdx::unique_lock<Latch> lock(_mutex);
+        _condvar.notify_one();
+    }
+    wait();
+}
+
+WiredTigerTicketController::Counters WiredTigerTicketController::_sampleCounters() const {
+    Counters counters;
+    counters.readReleased = _readTickets.holder->totalReleased();
+    counters.readQueued = _readTickets.holder->totalQueued();
+    counters.writeReleased = _writeTickets.holder->totalReleased();
+    counters.writeQueued = _writeTickets.holder->totalQueued();
+
+    // Without the statistic, the cache is never considered under pressure.
+    auto session = _sessionCache->getSession();
+    auto appEvictions = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                           "statistics:",
+                                                           "statistics=(fast)",
+                                                           WT_STAT_CONN_CACHE_EVICTION_APP);
+    counters.appEvictions = appEvictions.isOK() ? appEvictions.getValue() : 0;
+    return counters;
+}
+
+void WiredTigerTicketController::_adjust(StringData kind,
+                                         const Tickets& tickets,
+                                         const AdaptiveTicketLimit::Sample& sample) {
+    const int current = tickets.holder->outof();
+    const int next =
+        tickets.limit->adjust(current,
+                              sample,
+                              gWiredTigerAdaptiveConcurrentTransactionsMin.load(),
+                              gWiredTigerAdaptiveConcurrentTransactionsMax.load());
+    if (next == current) {
+        return;
+    }
+
+    LOGV2_DEBUG(5962402,
+                1,
+                "Adjusting the number of concurrent transactions",
+                "kind"_attr = kind,
+                "from"_attr = current,
+                "to"_attr = next,
+                "released"_attr = sample.released,
+                "queued"_attr = sample.queued,
+                "cachePressure"_attr = sample.cachePressure,
+                "elapsed"_attr = sample.elapsed);
+
+    // Shrinking waits for enough tickets to be released.
+    Status status = tickets.holder->resize(next);
+    if (!status.isOK()) {
+        LOGV2_WARNING(5962403,
+                      "Failed to adjust the number of concurrent transactions",
+                      "kind"_attr = kind,
+                      "to"_attr = next,
+                      "error"_attr = status);
+    }
+}
+
+}  // namespace mongo
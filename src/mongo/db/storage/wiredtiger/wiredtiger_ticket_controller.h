@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/background.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class TicketHolder;
+class WiredTigerSessionCache;
+
+/**
+ * Decides the number of tickets of a TicketHolder from the load observed over successive
+ * intervals, in the style of AIMD congestion control.
+ *
+ * While operations have to queue for tickets, the number of tickets is probed upwards by a fixed
+ * step. If the throughput of an interval drops compared to the interval before an increase, the
+ * increase is undone and no further increase is probed for a while. If the WiredTiger cache is
+ * under pressure, the number of tickets is cut by a constant factor, because more concurrent
+ * operations then only add to the eviction work done by application threads.
+ *
+ * Thread-safe.
+ */
+class AdaptiveTicketLimit {
+    AdaptiveTicketLimit(const AdaptiveTicketLimit&) = delete;
+    AdaptiveTicketLimit& operator=(const AdaptiveTicketLimit&) = delete;
+
+public:
+    // Number of tickets added by each increase, and undone by a back-off.
+    static constexpr int kIncreaseStep = 8;
+
+    // Fraction of the tickets kept by a decrease.
+    static constexpr double kDecreaseFactor = 0.75;
+
+    // Drop in throughput after an increase below which the increase is considered not to help.
+    static constexpr double kThroughputTolerance = 0.05;
+
+    // Number of intervals without any increase after a back-off.
+    static constexpr int kIntervalsAfterBackOff = 10;
+
+    enum class Decision { kHold, kIncrease, kDecrease, kBackOff };
+
+    /**
+     * Signals observed over one interval.
+     */
+    struct Sample {
+        // Duration of the interval.
+        Milliseconds elapsed{0};
+
+        // Tickets released during the interval.
+        long long released = 0;
+
+        // Acquisitions which had to wait for a ticket during the interval.
+        long long queued = 0;
+
+        // Whether application threads had to evict pages from the WiredTiger cache during the
+        // interval.
+        bool cachePressure = false;
+    };
+
+    AdaptiveTicketLimit() = default;
+
+    /**
+     * Returns the number of tickets to use for the next interval, within [minTickets, maxTickets],
+     * given the number 'current' used during the interval in which 'sample' was observed.
+     */
+    int adjust(int current, const Sample& sample, int minTickets, int maxTickets);
+
+    /**
+     * Appends the last decision and the number of decisions of each kind.
+     */
+    void report(BSONObjBuilder* builder) const;
+
+    static StringData decisionName(Decision decision);
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AdaptiveTicketLimit::_mutex");
+
+    Decision _lastDecision = Decision::kHold;
+
+    // Operations per second during the last interval.
+    double _lastThroughput = 0;
+
+    int _intervalsUntilIncrease = 0;
+
+    long long _numIncreases = 0;
+    long long _numDecreases = 0;
+    long long _numBackOffs = 0;
+};
+
+/**
+ * Background thread which periodically samples the read and write ticket holders and the
+ * WiredTiger cache, and resizes the ticket holders as decided by their AdaptiveTicketLimit. Only
+ * resizes them while the wiredTigerAdaptiveConcurrentTransactions parameter is set, starting from
+ * their current size, which is initially the one set through wiredTigerConcurrentReadTransactions
+ * and wiredTigerConcurrentWriteTransactions.
+ *
+ * There is one instance per WiredTigerKVEngine. It must be shut down before the session cache.
+ */
+class WiredTigerTicketController : public BackgroundJob {
+public:
+    struct Tickets {
+        TicketHolder* holder;
+        AdaptiveTicketLimit* limit;
+    };
+
+    WiredTigerTicketController(WiredTigerSessionCache* sessionCache,
+                               Tickets readTickets,
+                               Tickets writeTickets);
+
+    std::string name() const override {
+        return "WTTicketController";
+    }
+
+    void run() override;
+
+    /**
+     * Stops the thread and waits for it to exit.
+     */
+    void shutdown();
+
+private:
+    struct Counters {
+        long long readReleased;
+        long long readQueued;
+        long long writeReleased;
+        long long writeQueued;
+        long long appEvictions;
+    };
+
+    Counters _sampleCounters() const;
+
+    void _adjust(StringData kind,
+                 const Tickets& tickets,
+                 const AdaptiveTicketLimit::Sample& sample);
+
+    WiredTigerSessionCache* const _sessionCache;
+    const Tickets _readTickets;
+    const Tickets _writeTickets;
+
+    AtomicWord<bool> _shuttingDown{false};
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketController::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+};
+
+}  // namespace mongo
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const int kMin = 16;
+const int kMax = 512;
+
+AdaptiveTicketLimit::Sample makeSample(long long released, long long queued, bool cachePressure) {
+    AdaptiveTicketLimit::Sample sample;
+    sample.elapsed = Milliseconds(1000);
+    sample.released = released;
+    sample.queued = queued;
+    sample.cachePressure = cachePressure;
+    return sample;
+}
+
+std::string lastDecision(const AdaptiveTicketLimit& limit) {
+    BSONObjBuilder builder;
+    limit.report(&builder);
+    return builder.obj()["lastDecision"].str();
+}
+
+TEST(AdaptiveTicketLimitTest, HoldsWhileNoOperationQueues) {
+    AdaptiveTicketLimit limit;
+    ASSERT_EQ(128, limit.adjust(128, makeSample(1000, 0, false), kMin, kMax));
+    ASSERT_EQ("hold", lastDecision(limit));
+}
+
+TEST(AdaptiveTicketLimitTest, IncreasesWhileQueueingAndThroughputKeepsUp) {
+    AdaptiveTicketLimit limit;
+    int tickets = 128;
+    for (int i = 1; i <= 3; ++i) {
+        tickets = limit.adjust(tickets, makeSample(1000 * i, 10, false), kMin, kMax);
+        ASSERT_EQ(128 + i * AdaptiveTicketLimit::kIncreaseStep, tickets);
+        ASSERT_EQ("increase", lastDecision(limit));
+    }
+}
+
+TEST(AdaptiveTicketLimitTest, BacksOffWhenIncreaseLowersThroughput) {
+    AdaptiveTicketLimit limit;
+    int tickets = limit.adjust(128, makeSample(1000, 10, false), kMin, kMax);
+    ASSERT_EQ(128 + AdaptiveTicketLimit::kIncreaseStep, tickets);
+
+    // Throughput drops with the extra tickets, so the increase is undone
+    tickets = limit.adjust(tickets, makeSample(800, 10, false), kMin, kMax);
+    ASSERT_EQ(128, tickets);
+    ASSERT_EQ("backOff", lastDecision(limit));
+
+    // No increase is probed for a while, even though operations still queue
+    for (int i = 0; i < AdaptiveTicketLimit::kIntervalsAfterBackOff; ++i) {
+        ASSERT_EQ(128, limit.adjust(tickets, makeSample(1000, 10, false), kMin, kMax));
+    }
+    ASSERT_EQ(128 + AdaptiveTicketLimit::kIncreaseStep,
+              limit.adjust(tickets, makeSample(1000, 10, false), kMin, kMax));
+}
+
+TEST(AdaptiveTicketLimitTest, DecreasesUnderCachePressure) {
+    AdaptiveTicketLimit limit;
+    ASSERT_EQ(96, limit.adjust(128, makeSample(1000, 10, true), kMin, kMax));
+    ASSERT_EQ("decrease", lastDecision(limit));
+    ASSERT_EQ(72, limit.adjust(96, makeSample(1000, 0, true), kMin, kMax));
+
+    BSONObjBuilder builder;
+    limit.report(&builder);
+    ASSERT_EQ(2, builder.obj()["decreases"].numberLong());
+}
+
+TEST(AdaptiveTicketLimitTest, StaysWithinBounds) {
+    AdaptiveTicketLimit limit;
+    ASSERT_EQ(kMin, limit.adjust(kMin + 1, makeSample(1000, 10, true), kMin, kMax));
+    ASSERT_EQ(kMax, limit.adjust(kMax - 1, makeSample(2000, 10, false), kMin, kMax));
+    ASSERT_EQ(kMax, limit.adjust(kMax, makeSample(3000, 10, false), kMin, kMax));
+    ASSERT_EQ("hold", lastDecision(limit));
+
+    // Tickets set outside of the bounds are brought within them
+    ASSERT_EQ(kMax, limit.adjust(1000, makeSample(1000, 0, false), kMin, kMax));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -595,6 +595,12 @@ WT_EVENT_HANDLER defaultEventHandlers() {
     handlers.handle_progress = mdb_handle_progress;
     return handlers;
 }
+
+// Returns null when the session cache belongs to no KV engine, as in some unit tests.
+WiredTigerReadAheadPool* getReadAheadPool(WiredTigerSessionCache* sessionCache) {
+    auto engine = sessionCache->getKVEngine();
+    return engine ? engine->getReadAheadPool() : nullptr;
+}
 }  // namespace
 
 WiredTigerEventHandler::WiredTigerEventHandler() {
@@ -653,6 +659,8 @@ int WiredTigerUtil::verifyTable(OperationContext* opCtx,
     invariantWTOK(conn->open_session(conn, &eventHandler, nullptr, &session));
     ON_BLOCK_EXIT([&] { session->close(session, ""); });
 
+    WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(getReadAheadPool(sessionCache));
+
     // Do the verify. Weird parens prevent treating "verify" as a macro.
     return (session->verify)(session, uri.c_str(), nullptr);
 }
@@ -704,6 +712,7 @@ Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::strin
 
     // Use a dedicated session for alter operations to avoid transaction issues.
     WiredTigerSession session(sessionCache->conn());
+    WiredTigerReadAheadPool::SuspendBlock suspendReadAhead(getReadAheadPool(sessionCache));
     return setTableLogging(session.getSession(), uri, on);
 }
 
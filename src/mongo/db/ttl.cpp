@@ -39,8 +39,10 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/truncate_range.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -52,8 +54,10 @@
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_access_blocker_registry.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/db/ttl_gen.h"
@@ -61,6 +65,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log_with_sampling.h"
 
 namespace mongo {
@@ -71,6 +76,32 @@ namespace {
 
 const auto getTTLMonitor = ServiceContext::declareDecoration<std::unique_ptr<TTLMonitor>>();
 
+// How long the TTL monitor waits before the next pass when a collection was left with expired
+// documents, either because it used up its time budget or because deletes were throttled.
+const Seconds kBacklogPassInterval{1};
+
+// Upper bound on the number of expired documents counted when estimating a collection's backlog.
+const long long kBacklogEstimateLimit = 100 * 1000;
+
+/**
+ * Tracks the deletion of expired documents from a single collection during a TTL pass.
+ */
+struct CollectionSlice {
+    // Time at which the collection yields to the next pass. Date_t::max() means no time budget.
+    Date_t deadline = Date_t::max();
+
+    long long numDeleted = 0;
+
+    // Set when the deadline was reached before all expired documents could be deleted, in which
+    // case 'backlog' holds the number of expired documents left, up to kBacklogEstimateLimit.
+    bool budgetExhausted = false;
+    long long backlog = 0;
+
+    bool hasBudget() const {
+        return deadline != Date_t::max();
+    }
+};
+
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
@@ -83,9 +114,61 @@ ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocume
                                                               &ttlDeletedDocuments);
 using MtabType = TenantMigrationAccessBlocker::BlockerType;
 
+long long deleteExpiredWithRangeTruncate(OperationContext* opCtx,
+                                         const CollectionPtr& collection,
+                                         const RecordId& endId,
+                                         Date_t deadline,
+                                         bool* deadlineReached) {
+    Timer timer;
+    long long numDeleted = 0;
+    RecordId startId;
+    while (true) {
+        const auto result =
+            writeConflictRetry(opCtx, "ttlRangeTruncate", collection->ns().ns(), [&] {
+                WriteUnitOfWork wuow(opCtx);
+                auto result = uassertStatusOK(truncateRange(
+                    opCtx, collection, startId, endId, ttlMonitorRangeTruncateBatchSize.load()));
+                wuow.commit();
+                return result;
+            });
+
+        numDeleted += result.numRecords;
+        ttlDeletedDocuments.increment(result.numRecords);
+        if (result.numRecords < ttlMonitorRangeTruncateBatchSize.load() ||
+            *result.lastRecordId == endId) {
+            break;
+        }
+
+        if (Date_t::now() >= deadline) {
+            *deadlineReached = true;
+            break;
+        }
+
+        // Each batch is its own storage transaction. Check for interrupts between batches so that
+        // stepdown or shutdown do not wait for the whole expired range.
+        opCtx->checkForInterrupt();
+        startId = *result.lastRecordId;
+    }
+
+    const auto duration = Milliseconds(timer.millis());
+    if (shouldLogSlowOpWithSampling(opCtx,
+                                    logv2::LogComponent::kIndex,
+                                    duration,
+                                    Milliseconds(serverGlobalParams.slowMS))
+            .first) {
+        LOGV2(5961800,
+              "Deleted expired documents using range truncates",
+              logAttrs(collection->ns()),
+              "numDeleted"_attr = numDeleted,
+              "duration"_attr = duration);
+    }
+    return numDeleted;
+}
+
 class TTLMonitor : public BackgroundJob {
 public:
-    explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
+    explicit TTLMonitor()
+        : BackgroundJob(false /* selfDelete */), _workers(_makeWorkerPoolOptions()) {}
 
     static TTLMonitor* get(ServiceContext* serviceCtx) {
         return getTTLMonitor(serviceCtx).get();
@@ -115,10 +198,21 @@ public:
             tc.get()->setSystemOperationKillableByStepdown(lk);
         }
 
+        _workers.startup();
+        ON_BLOCK_EXIT([&] {
+            _workers.shutdown();
+            _workers.join();
+        });
+
         while (true) {
             {
-                // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
-                auto deadline = Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+                // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested. Passes
+                // follow each other more closely while collections are left with expired data.
+                Milliseconds sleep = Seconds(ttlMonitorSleepSecs.load());
+                if (_expiredDataRemaining.load()) {
+                    sleep = std::min(sleep, Milliseconds(kBacklogPassInterval));
+                }
+                auto deadline = Date_t::now() + sleep;
                 stdx::unique_lock<Latch> lk(_stateMutex);
 
                 MONGO_IDLE_THREAD_BLOCK;
@@ -171,9 +265,67 @@ public:
         LOGV2(3684101, "Finished shutting down TTL collection monitor thread");
     }
 
+    /**
+     * Appends the TTL deletion state of collections which were left with expired documents or
+     * whose deletes were throttled during the most recent pass.
+     */
+    void appendStats(BSONObjBuilder* builder) const {
+        builder->append("workers", ttlMonitorNumWorkers);
+
+        BSONObjBuilder collectionsBuilder(builder->subobjStart("collections"));
+        stdx::lock_guard<Latch> lk(_statsMutex);
+        for (const auto& [uuid, stats] : _collectionStats) {
+            if (stats.backlog == 0 && !stats.throttled) {
+                continue;
+            }
+
+            BSONObjBuilder collBuilder(collectionsBuilder.subobjStart(stats.nss.ns()));
+            collBuilder.append("backlog", stats.backlog);
+            collBuilder.append("backlogIsLowerBound", stats.backlogIsLowerBound);
+            collBuilder.append("throttled", stats.throttled);
+            collBuilder.append("deletedDocuments", stats.deletedDocuments);
+            collBuilder.append("lastSliceMillis", durationCount<Milliseconds>(stats.lastSlice));
+        }
+    }
+
 private:
     /**
-     * Gets all TTL specifications for every collection and deletes expired documents.
+     * Per-collection TTL deletion state reported in serverStatus.
+     */
+    struct CollectionStats {
+        NamespaceString nss;
+
+        // Estimate of the expired documents left in the collection after its most recent slice.
+        long long backlog = 0;
+        bool backlogIsLowerBound = false;
+
+        // Whether the most recent pass skipped the collection because of adaptive throttling.
+        bool throttled = false;
+
+        long long deletedDocuments = 0;
+        Milliseconds lastSlice{0};
+    };
+
+    static ThreadPool::Options _makeWorkerPoolOptions() {
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorWorkers";
+        options.minThreads = 0;
+        options.maxThreads = ttlMonitorNumWorkers;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+            auto client = Client::getCurrent();
+            AuthorizationSession::get(*client)->grantInternalAuthorization(client);
+
+            stdx::lock_guard<Client> lk(*client);
+            client->setSystemOperationKillableByStepdown(lk);
+        };
+        return options;
+    }
+
+    /**
+     * Gets all TTL specifications for every collection and deletes expired documents. Collections
+     * are spread across the TTL workers, and the pass completes once each of them has had its
+     * slice.
      */
     void doTTLPass() {
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
@@ -191,50 +343,179 @@ private:
         // Increment the metric after the TTL work has been finished.
         ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
 
+        {
+            // Forget about collections which are no longer TTL.
+            stdx::lock_guard<Latch> lk(_statsMutex);
+            for (auto it = _collectionStats.begin(); it != _collectionStats.end();) {
+                if (ttlInfos.count(it->first)) {
+                    ++it;
+                } else {
+                    _collectionStats.erase(it++);
+                }
+            }
+        }
+
+        _expiredDataRemaining.store(false);
+
+        // Set by the first collection to be interrupted, after which the rest of the pass is
+        // skipped.
+        AtomicWord<bool> interrupted{false};
+
         // Perform a pass for every collection and index described as being TTL.
         for (const auto& [uuid, infos] : ttlInfos) {
-            for (const auto& info : infos) {
-                // Skip collections that have not been made visible yet. The TTLCollectionCache
-                // already has the index information available, so we want to avoid removing it
-                // until the collection is visible.
-                auto collectionCatalog = CollectionCatalog::get(opCtx);
-                if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
-                    continue;
-                }
+            _workers.schedule(
+                [this, &ttlCollectionCache, &interrupted, uuid = uuid, &infos = infos](
+                    Status status) {
+                    if (!status.isOK() || interrupted.load()) {
+                        return;
+                    }
+                    deleteExpiredFromCollection(&ttlCollectionCache, uuid, infos, &interrupted);
+                });
+        }
+        _workers.waitForIdle();
+    }
 
-                // The collection was dropped.
-                auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
-                if (!nss) {
-                    ttlCollectionCache.deregisterTTLInfo(uuid, info);
-                    continue;
-                }
+    /**
+     * Deletes expired data on the collection with the given 'uuid' for each of its TTL
+     * specifications, within the time budget of a single collection. Runs on a TTL worker.
+     */
+    void deleteExpiredFromCollection(TTLCollectionCache* ttlCollectionCache,
+                                     const UUID& uuid,
+                                     const std::vector<TTLCollectionCache::Info>& infos,
+                                     AtomicWord<bool>* interrupted) {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxPtr.get();
 
-                try {
-                    deleteExpired(opCtx, &ttlCollectionCache, uuid, *nss, info);
-                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                    LOGV2_WARNING(22537,
-                                  "TTLMonitor was interrupted, waiting before doing another pass",
-                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                    return;
-                } catch (const DBException& ex) {
-                    LOGV2_ERROR(5400703,
-                                "Error running TTL job on collection",
-                                logAttrs(*nss),
-                                "error"_attr = ex);
-                    continue;
-                }
+        // Expired documents only have to be removed eventually, so TTL passes should not hold up
+        // client operations waiting for a ticket.
+        opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+
+        const bool throttled = shouldThrottle(opCtx);
+
+        CollectionSlice slice;
+        const auto budget = Milliseconds(ttlMonitorCollectionTimeBudgetMS.load());
+        if (budget > Milliseconds(0)) {
+            slice.deadline = Date_t::now() + budget;
+        }
+
+        Timer timer;
+        boost::optional<NamespaceString> nss;
+        for (const auto& info : infos) {
+            // Skip collections that have not been made visible yet. The TTLCollectionCache
+            // already has the index information available, so we want to avoid removing it
+            // until the collection is visible.
+            auto collectionCatalog = CollectionCatalog::get(opCtx);
+            if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
+                continue;
+            }
+
+            // The collection was dropped.
+            nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
+            if (!nss) {
+                ttlCollectionCache->deregisterTTLInfo(uuid, info);
+                continue;
+            }
+
+            if (throttled) {
+                break;
+            }
+
+            try {
+                deleteExpired(opCtx, ttlCollectionCache, uuid, *nss, info, &slice);
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                LOGV2_WARNING(22537,
+                              "TTLMonitor was interrupted, waiting before doing another pass",
+                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+                interrupted->store(true);
+                return;
+            } catch (const WriteConflictException&) {
+                LOGV2_DEBUG(5961900, 1, "got WriteConflictException", logAttrs(*nss));
+                continue;
+            } catch (const DBException& ex) {
+                LOGV2_ERROR(5400703,
+                            "Error running TTL job on collection",
+                            logAttrs(*nss),
+                            "error"_attr = ex);
+                continue;
+            }
+
+            if (slice.budgetExhausted) {
+                break;
             }
         }
+
+        if (!nss) {
+            return;
+        }
+
+        if (throttled || slice.budgetExhausted) {
+            _expiredDataRemaining.store(true);
+        }
+
+        stdx::lock_guard<Latch> lk(_statsMutex);
+        auto& stats = _collectionStats[uuid];
+        stats.nss = *nss;
+        stats.throttled = throttled;
+        if (throttled) {
+            // The backlog was not examined, so keep the previous estimate.
+            return;
+        }
+        stats.backlog = slice.budgetExhausted ? slice.backlog : 0;
+        stats.backlogIsLowerBound = slice.backlog >= kBacklogEstimateLimit;
+        stats.deletedDocuments += slice.numDeleted;
+        stats.lastSlice = Milliseconds(timer.millis());
     }
 
     /**
-     * Deletes expired data on the given collection with the provided information.
+     * Returns true if the deletion of expired documents should be postponed. TTL deletes are
+     * replicated and dirty the storage engine cache, so they back off while the majority commit
+     * point lags behind this node or while the cache is filled with dirty data.
+     */
+    bool shouldThrottle(OperationContext* opCtx) const {
+        const auto maxLag = Seconds(ttlMonitorMaxReplicationLagSecs.load());
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (maxLag > Seconds(0) &&
+            replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet) {
+            const auto myLastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+            const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+            const auto lag = myLastApplied.wallTime - lastCommitted.wallTime;
+            if (lag > maxLag) {
+                LOGV2_DEBUG(5961901,
+                            1,
+                            "Throttling TTL deletes because of replication lag",
+                            "lag"_attr = lag,
+                            "maxLag"_attr = maxLag);
+                return true;
+            }
+        }
+
+        const auto maxCacheDirtyPercent = ttlMonitorMaxCacheDirtyPercent.load();
+        if (maxCacheDirtyPercent > 0) {
+            const auto cacheDirtyPercent =
+                opCtx->getServiceContext()->getStorageEngine()->getCacheDirtyPercentage();
+            if (cacheDirtyPercent && *cacheDirtyPercent > maxCacheDirtyPercent) {
+                LOGV2_DEBUG(5961902,
+                            1,
+                            "Throttling TTL deletes because of storage engine cache pressure",
+                            "cacheDirtyPercent"_attr = *cacheDirtyPercent,
+                            "maxCacheDirtyPercent"_attr = maxCacheDirtyPercent);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Deletes expired data on the given collection with the provided information, accounting for
+     * the work in 'slice'.
      */
     void deleteExpired(OperationContext* opCtx,
                        TTLCollectionCache* ttlCollectionCache,
                        const UUID& uuid,
                        const NamespaceString& nss,
-                       const TTLCollectionCache::Info& info) {
+                       const TTLCollectionCache::Info& info,
+                       CollectionSlice* slice) {
         if (nss.isTemporaryReshardingCollection()) {
             // For resharding, the donor shard primary is responsible for performing the TTL
             // deletions.
@@ -288,10 +569,11 @@ private:
         stdx::visit(
             visit_helper::Overloaded{
                 [&](const TTLCollectionCache::ClusteredId&) {
-                    deleteExpiredWithCollscan(opCtx, ttlCollectionCache, collection);
+                    deleteExpiredWithCollscan(opCtx, ttlCollectionCache, collection, slice);
                 },
                 [&](const TTLCollectionCache::IndexName& indexName) {
-                    deleteExpiredWithIndex(opCtx, ttlCollectionCache, collection, indexName);
+                    deleteExpiredWithIndex(
+                        opCtx, ttlCollectionCache, collection, indexName, slice);
                 }},
             info);
     }
@@ -324,7 +606,8 @@ private:
     void deleteExpiredWithIndex(OperationContext* opCtx,
                                 TTLCollectionCache* ttlCollectionCache,
                                 const CollectionPtr& collection,
-                                std::string indexName) {
+                                std::string indexName,
+                                CollectionSlice* slice) {
         if (!collection->isIndexPresent(indexName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
             return;
@@ -404,6 +687,7 @@ private:
 
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
+        params->returnDeleted = slice->hasBudget();
         params->canonicalQuery = canonicalQuery.getValue().get();
 
         Timer timer;
@@ -419,8 +703,20 @@ private:
                                                  direction);
 
         try {
-            const auto numDeleted = exec->executeDelete();
-            ttlDeletedDocuments.increment(numDeleted);
+            const auto numDeleted = executeDeleteWithinBudget(exec.get(), slice);
+
+            if (slice->budgetExhausted) {
+                slice->backlog = countUpToBacklogEstimateLimit(
+                    InternalPlanner::indexScan(opCtx,
+                                               &collection,
+                                               desc,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                               direction)
+                        .get());
+            }
 
             const auto duration = Milliseconds(timer.millis());
             if (shouldLogSlowOpWithSampling(opCtx,
@@ -446,7 +742,8 @@ private:
      */
     void deleteExpiredWithCollscan(OperationContext* opCtx,
                                    TTLCollectionCache* ttlCollectionCache,
-                                   const CollectionPtr& collection) {
+                                   const CollectionPtr& collection,
+                                   CollectionSlice* slice) {
         const auto& collOptions = collection->getCollectionOptions();
         uassert(5400701,
                 "collection is not clustered by _id but is described as being TTL",
@@ -474,8 +771,37 @@ private:
 
         const auto endId = record_id_helpers::keyForOID(endOID);
 
+        if (canDeleteExpiredWithRangeTruncate(collection)) {
+            slice->numDeleted += deleteExpiredWithRangeTruncate(
+                opCtx, collection, endId, slice->deadline, &slice->budgetExhausted);
+        } else {
+            deleteExpiredWithClusteredDelete(opCtx, collection, endId, slice);
+        }
+
+        if (slice->budgetExhausted) {
+            slice->backlog = countUpToBacklogEstimateLimit(
+                InternalPlanner::collectionScan(opCtx,
+                                                &collection,
+                                                PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                InternalPlanner::Direction::FORWARD,
+                                                boost::none /* resumeAfterRecordId */,
+                                                boost::none /* minRecord */,
+                                                endId)
+                    .get());
+        }
+    }
+
+    /**
+     * Removes the documents of a collection clustered by _id whose RecordIds are at most 'endId'
+     * with a bounded collection scan.
+     */
+    void deleteExpiredWithClusteredDelete(OperationContext* opCtx,
+                                          const CollectionPtr& collection,
+                                          const RecordId& endId,
+                                          CollectionSlice* slice) {
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
+        params->returnDeleted = slice->hasBudget();
 
         // Deletes records using a bounded collection scan from the beginning of time to the
         // expiration time (inclusive).
@@ -490,8 +816,7 @@ private:
                                                       endId);
 
         try {
-            const auto numDeleted = exec->executeDelete();
-            ttlDeletedDocuments.increment(numDeleted);
+            const auto numDeleted = executeDeleteWithinBudget(exec.get(), slice);
 
             const auto duration = Milliseconds(timer.millis());
             if (shouldLogSlowOpWithSampling(opCtx,
@@ -511,6 +836,73 @@ private:
         }
     }
 
+    /**
+     * Returns true if expired documents of 'collection', which is clustered by _id, can be removed
+     * with range truncates. Shard servers are excluded because chunk migrations and resharding
+     * track deletes through the individual delete oplog entries, as are collections which record
+     * pre-images for each delete.
+     */
+    bool canDeleteExpiredWithRangeTruncate(const CollectionPtr& collection) const {
+        return feature_flags::gTTLRangeTruncate.isEnabled(
+                   serverGlobalParams.featureCompatibility) &&
+            serverGlobalParams.clusterRole != ClusterRole::ShardServer &&
+            !collection->getRecordPreImages();
+    }
+
+    /**
+     * Runs the delete plan 'exec' until it has deleted every expired document or until the
+     * deadline of 'slice' passes. Returns the number of deleted documents.
+     */
+    long long executeDeleteWithinBudget(PlanExecutor* exec, CollectionSlice* slice) {
+        long long numDeleted = 0;
+        if (!slice->hasBudget()) {
+            numDeleted = exec->executeDelete();
+        } else {
+            // The delete plan returns each deleted document, giving a chance to check the
+            // deadline between deletes.
+            while (exec->getNext(nullptr, nullptr) == PlanExecutor::ADVANCED) {
+                ++numDeleted;
+                if (Date_t::now() >= slice->deadline) {
+                    slice->budgetExhausted = true;
+                    break;
+                }
+            }
+        }
+
+        slice->numDeleted += numDeleted;
+        ttlDeletedDocuments.increment(numDeleted);
+        return numDeleted;
+    }
+
+    /**
+     * Returns the number of results of 'exec', a scan over the expired documents left in a
+     * collection, up to kBacklogEstimateLimit.
+     */
+    long long countUpToBacklogEstimateLimit(PlanExecutor* exec) {
+        long long count = 0;
+        try {
+            while (count < kBacklogEstimateLimit &&
+                   exec->getNext(nullptr, nullptr) == PlanExecutor::ADVANCED) {
+                ++count;
+            }
+        } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
+            // The collection was dropped while counting, so nothing is left to expire.
+            return 0;
+        }
+        return count;
+    }
+
+    // Runs the deletion of expired documents, one task per collection.
+    ThreadPool _workers;
+
+    // Set when a collection is left with expired documents at the end of a pass.
+    AtomicWord<bool> _expiredDataRemaining{false};
+
+    // Protects _collectionStats.
+    mutable Mutex _statsMutex = MONGO_MAKE_LATCH("TTLMonitorStatsMutex");
+
+    stdx::unordered_map<UUID, CollectionStats, UUID::Hash> _collectionStats;
+
     // Protects the state below.
     mutable Mutex _stateMutex = MONGO_MAKE_LATCH("TTLMonitorStateMutex");
 
@@ -521,6 +913,28 @@ private:
     bool _shuttingDown = false;
 };
 
+namespace {
+
+class TTLServerStatusSection : public ServerStatusSection {
+public:
+    TTLServerStatusSection() : ServerStatusSection("ttl") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto ttlMonitor = TTLMonitor::get(opCtx->getServiceContext())) {
+            ttlMonitor->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} ttlServerStatusSection;
+
+}  // namespace
+
 void startTTLMonitor(ServiceContext* serviceContext) {
     std::unique_ptr<TTLMonitor> ttlMonitor = std::make_unique<TTLMonitor>();
     ttlMonitor->go();
@@ -29,8 +29,13 @@
 
 #pragma once
 
+#include "mongo/util/time_support.h"
+
 namespace mongo {
 
+class CollectionPtr;
+class OperationContext;
+class RecordId;
 class ServiceContext;
 
 /**
@@ -44,4 +49,19 @@ void startTTLMonitor(ServiceContext* serviceContext);
  */
 void shutdownTTLMonitor(ServiceContext* serviceContext);
 
+/**
+ * Removes the documents of 'collection', which must be clustered by _id, whose RecordIds are at
+ * most 'endId' with range truncates of up to 'ttlMonitorRangeTruncateBatchSize' records. Each
+ * truncate is its own storage transaction and is replicated as a single 'truncateRange' oplog
+ * entry. Once 'deadline' has passed, stops between truncates and sets 'deadlineReached'. Returns
+ * the number of documents removed.
+ *
+ * The caller must hold the collection lock in MODE_IX. Exposed for testing.
+ */
+long long deleteExpiredWithRangeTruncate(OperationContext* opCtx,
+                                         const CollectionPtr& collection,
+                                         const RecordId& endId,
+                                         Date_t deadline,
+                                         bool* deadlineReached);
+
 }  // namespace mongo
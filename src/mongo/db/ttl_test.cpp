@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ttl.h"
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/op_observer_noop.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/record_id_helpers.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/ttl_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Records the ranges reported through onTruncateRange(), each of which is logged as one
+ * 'truncateRange' oplog entry by the OpObserverImpl.
+ */
+class TruncateRangeOpObserver : public OpObserverNoop {
+public:
+    struct Range {
+        RecordId minRecordId;
+        RecordId maxRecordId;
+        int64_t numRecords;
+    };
+
+    void onTruncateRange(OperationContext* opCtx,
+                         const NamespaceString& collectionName,
+                         OptionalCollectionUUID uuid,
+                         const RecordId& minRecordId,
+                         const RecordId& maxRecordId,
+                         int64_t numRecordsDeleted) override {
+        ranges.push_back({minRecordId, maxRecordId, numRecordsDeleted});
+    }
+
+    std::vector<Range> ranges;
+};
+
+class TTLRangeTruncateTest : public CatalogTestFixture {
+protected:
+    void setUp() override {
+        CatalogTestFixture::setUp();
+
+        auto opObserver = std::make_unique<TruncateRangeOpObserver>();
+        _opObserver = opObserver.get();
+        auto opObserverRegistry =
+            dynamic_cast<OpObserverRegistry*>(getServiceContext()->getOpObserver());
+        opObserverRegistry->addObserver(std::move(opObserver));
+
+        CollectionOptions options;
+        options.clusteredIndex = true;
+        ASSERT_OK(storageInterface()->createCollection(
+            operationContext(), _nss, options, false /* createIdIndex */));
+
+        _originalBatchSize = ttlMonitorRangeTruncateBatchSize.load();
+    }
+
+    void tearDown() override {
+        ttlMonitorRangeTruncateBatchSize.store(_originalBatchSize);
+        CatalogTestFixture::tearDown();
+    }
+
+    /**
+     * Inserts 'count' documents whose _ids were generated one second apart, and returns their
+     * RecordIds in increasing order.
+     */
+    std::vector<RecordId> insertDocuments(int count) {
+        std::vector<RecordId> recordIds;
+        for (int i = 0; i < count; ++i) {
+            OID oid;
+            oid.init(Date_t::fromMillisSinceEpoch((i + 1) * 1000));
+            ASSERT_OK(storageInterface()->insertDocument(
+                operationContext(), _nss, {BSON("_id" << oid)}, 0 /* term */));
+            recordIds.push_back(record_id_helpers::keyForOID(oid));
+        }
+        return recordIds;
+    }
+
+    long long deleteExpired(const RecordId& endId, Date_t deadline, bool* deadlineReached) {
+        AutoGetCollection collection(operationContext(), _nss, MODE_IX);
+        return deleteExpiredWithRangeTruncate(
+            operationContext(), collection.getCollection(), endId, deadline, deadlineReached);
+    }
+
+    long long numRecords() {
+        AutoGetCollectionForRead collection(operationContext(), _nss);
+        return collection->numRecords(operationContext());
+    }
+
+    void assertRange(size_t index,
+                     const RecordId& minRecordId,
+                     const RecordId& maxRecordId,
+                     int64_t numRecords) {
+        ASSERT_LT(index, _opObserver->ranges.size());
+        const auto& range = _opObserver->ranges[index];
+        ASSERT_EQ(minRecordId, range.minRecordId);
+        ASSERT_EQ(maxRecordId, range.maxRecordId);
+        ASSERT_EQ(numRecords, range.numRecords);
+    }
+
+    const NamespaceString _nss{"test.ttl"};
+    TruncateRangeOpObserver* _opObserver = nullptr;
+
+private:
+    int _originalBatchSize = 0;
+};
+
+TEST_F(TTLRangeTruncateTest, RemovesExpiredDocumentsInFullBatches) {
+    ttlMonitorRangeTruncateBatchSize.store(2);
+    auto recordIds = insertDocuments(5);
+
+    bool deadlineReached = false;
+    ASSERT_EQ(4, deleteExpired(recordIds[3], Date_t::max(), &deadlineReached));
+    ASSERT_FALSE(deadlineReached);
+    ASSERT_EQ(1, numRecords());
+
+    // The last batch ends on 'endId', so no empty truncate follows it.
+    ASSERT_EQ(2U, _opObserver->ranges.size());
+    assertRange(0, recordIds[0], recordIds[1], 2);
+    assertRange(1, recordIds[2], recordIds[3], 2);
+}
+
+TEST_F(TTLRangeTruncateTest, StopsAfterAPartialBatch) {
+    ttlMonitorRangeTruncateBatchSize.store(3);
+    auto recordIds = insertDocuments(5);
+
+    bool deadlineReached = false;
+    ASSERT_EQ(4, deleteExpired(recordIds[3], Date_t::max(), &deadlineReached));
+    ASSERT_FALSE(deadlineReached);
+    ASSERT_EQ(1, numRecords());
+
+    ASSERT_EQ(2U, _opObserver->ranges.size());
+    assertRange(0, recordIds[0], recordIds[2], 3);
+    assertRange(1, recordIds[3], recordIds[3], 1);
+}
+
+TEST_F(TTLRangeTruncateTest, LogsNothingWithoutExpiredDocuments) {
+    insertDocuments(3);
+
+    OID beforeAll;
+    beforeAll.init(Date_t::fromMillisSinceEpoch(0), true /* max */);
+    const auto endId = record_id_helpers::keyForOID(beforeAll);
+    bool deadlineReached = false;
+    ASSERT_EQ(0, deleteExpired(endId, Date_t::max(), &deadlineReached));
+    ASSERT_FALSE(deadlineReached);
+    ASSERT_EQ(3, numRecords());
+    ASSERT_EQ(0U, _opObserver->ranges.size());
+}
+
+TEST_F(TTLRangeTruncateTest, StopsBetweenBatchesOnceTheDeadlinePasses) {
+    ttlMonitorRangeTruncateBatchSize.store(1);
+    auto recordIds = insertDocuments(4);
+
+    // A deadline in the past still lets one batch through.
+    bool deadlineReached = false;
+    ASSERT_EQ(1, deleteExpired(recordIds[3], Date_t::now(), &deadlineReached));
+    ASSERT_TRUE(deadlineReached);
+    ASSERT_EQ(3, numRecords());
+
+    ASSERT_EQ(1U, _opObserver->ranges.size());
+    assertRange(0, recordIds[0], recordIds[0], 1);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,291 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file tests db/exec/column_scan.cpp and the keys generated by
+ * db/index/column_store_access_method.cpp.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <memory>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/column_scan.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/column_store_access_method.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/storage/execution_context.h"
+#include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace query_stage_column_scan {
+
+using Cell = ColumnStoreAccessMethod::Cell;
+using CellKind = ColumnStoreAccessMethod::CellKind;
+
+static const NamespaceString nss{"unittests.QueryStageColumnScan"};
+static const std::string kIndexName = "columnstore_index";
+
+class QueryStageColumnScanTest : public unittest::Test {
+public:
+    QueryStageColumnScanTest() : _client(&_opCtx) {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+        _client.insert(nss.ns(), fromjson("{_id: 0, a: 1, b: {c: 10, d: 'x'}}"));
+        _client.insert(nss.ns(), fromjson("{_id: 1, a: 2}"));
+        _client.insert(nss.ns(), fromjson("{_id: 2, a: 3, b: [{c: 1}, {c: 2}]}"));
+
+        ASSERT_OK(dbtests::createIndexFromSpec(&_opCtx,
+                                               nss.ns(),
+                                               BSON("v" << 2 << "name" << kIndexName << "key"
+                                                        << BSON("a"
+                                                                << "columnstore"
+                                                                << "b.c"
+                                                                << "columnstore"))));
+    }
+
+    virtual ~QueryStageColumnScanTest() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+        _client.dropCollection(nss.ns());
+    }
+
+    const IndexDescriptor* getIndex(const CollectionPtr& collection) {
+        auto desc = collection->getIndexCatalog()->findIndexByName(&_opCtx, kIndexName);
+        ASSERT(desc);
+        return desc;
+    }
+
+    /**
+     * Generates the cells of 'doc' as though it were stored at 'recordId' and returns them in key
+     * order, which is the order of the index's paths.
+     */
+    std::vector<BSONObj> getCells(const BSONObj& doc, const RecordId& recordId) {
+        AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+        auto accessMethod = collection->getIndexCatalog()
+                                ->getEntry(getIndex(collection.getCollection()))
+                                ->accessMethod();
+
+        auto& executionCtx = StorageExecutionContext::get(&_opCtx);
+        auto keys = executionCtx.keys();
+        accessMethod->getKeys(&_opCtx,
+                              collection.getCollection(),
+                              executionCtx.pooledBufferBuilder(),
+                              doc,
+                              IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                              IndexAccessMethod::GetKeysContext::kAddingKeys,
+                              keys.get(),
+                              nullptr,
+                              nullptr,
+                              recordId,
+                              IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        const auto ordering = accessMethod->getSortedDataInterface()->getOrdering();
+        std::vector<BSONObj> cells;
+        for (auto&& keyString : *keys) {
+            cells.push_back(KeyString::toBson(keyString, ordering));
+        }
+        return cells;
+    }
+
+    /**
+     * Runs a COLUMN_SCAN over the test collection with the given filter and returns the
+     * documents it produces along with its stats.
+     */
+    std::vector<BSONObj> runColumnScan(const BSONObj& filterObj, ColumnScanStats* statsOut) {
+        AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+
+        auto statusWithMatcher = MatchExpressionParser::parse(filterObj, _expCtx);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        auto filterExpr = std::move(statusWithMatcher.getValue());
+
+        WorkingSet ws;
+        ColumnScan scan(_expCtx.get(),
+                        collection.getCollection(),
+                        getIndex(collection.getCollection()),
+                        &ws,
+                        filterExpr.get());
+
+        std::vector<BSONObj> results;
+        while (!scan.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = scan.work(&id);
+            if (PlanStage::ADVANCED == state) {
+                WorkingSetMember* member = ws.get(id);
+                results.push_back(member->doc.value().toBson());
+                ws.free(id);
+            }
+        }
+
+        *statsOut = *static_cast<const ColumnScanStats*>(scan.getSpecificStats());
+        return results;
+    }
+
+    void update(const BSONObj& query, const BSONObj& update) {
+        _client.update(nss.ns(), query, update);
+    }
+
+protected:
+    // Column store indexes cannot be built unless the feature flag is enabled. This must be
+    // declared first so that it outlives the index built by the constructor.
+    RAIIServerParameterControllerForTest _featureFlagController{"featureFlagColumnstoreIndexes",
+                                                                true};
+
+    const ServiceContext::UniqueOperationContext _txnPtr = cc().makeOperationContext();
+    OperationContext& _opCtx = *_txnPtr;
+
+    boost::intrusive_ptr<ExpressionContext> _expCtx =
+        make_intrusive<ExpressionContext>(&_opCtx, nullptr, nss);
+
+private:
+    DBDirectClient _client;
+};
+
+TEST_F(QueryStageColumnScanTest, GetKeysMakesOneValueCellPerPath) {
+    const RecordId recordId(7);
+    auto cells = getCells(fromjson("{_id: 0, a: 1, b: {c: 10, d: 'x'}}"), recordId);
+    ASSERT_EQ(2U, cells.size());
+
+    Cell aCell = ColumnStoreAccessMethod::decodeCell(cells[0]);
+    ASSERT_EQ(0U, aCell.pathIndex);
+    ASSERT_EQ(recordId, aCell.recordId);
+    ASSERT(aCell.kind == CellKind::kValue);
+    ASSERT_EQ(1, aCell.value.numberInt());
+
+    Cell bcCell = ColumnStoreAccessMethod::decodeCell(cells[1]);
+    ASSERT_EQ(1U, bcCell.pathIndex);
+    ASSERT_EQ(recordId, bcCell.recordId);
+    ASSERT(bcCell.kind == CellKind::kValue);
+    ASSERT_EQ(10, bcCell.value.numberInt());
+}
+
+TEST_F(QueryStageColumnScanTest, GetKeysMakesMissingCellForAbsentPath) {
+    auto cells = getCells(fromjson("{_id: 1, a: 2}"), RecordId(8));
+    ASSERT_EQ(2U, cells.size());
+
+    ASSERT(ColumnStoreAccessMethod::decodeCell(cells[0]).kind == CellKind::kValue);
+
+    Cell bcCell = ColumnStoreAccessMethod::decodeCell(cells[1]);
+    ASSERT_EQ(1U, bcCell.pathIndex);
+    ASSERT(bcCell.kind == CellKind::kMissing);
+}
+
+TEST_F(QueryStageColumnScanTest, GetKeysMakesUncoveredCellForArrayInTheMiddleOfAPath) {
+    auto cells = getCells(fromjson("{_id: 2, a: 3, b: [{c: 1}, {c: 2}]}"), RecordId(9));
+    ASSERT_EQ(2U, cells.size());
+
+    ASSERT(ColumnStoreAccessMethod::decodeCell(cells[0]).kind == CellKind::kValue);
+
+    Cell bcCell = ColumnStoreAccessMethod::decodeCell(cells[1]);
+    ASSERT_EQ(1U, bcCell.pathIndex);
+    ASSERT(bcCell.kind == CellKind::kUncovered);
+}
+
+TEST_F(QueryStageColumnScanTest, GetKeysStoresArrayAtTheEndOfAPathAsAValue) {
+    auto cells = getCells(fromjson("{_id: 3, a: [1, 2], b: {c: 4}}"), RecordId(10));
+    ASSERT_EQ(2U, cells.size());
+
+    Cell aCell = ColumnStoreAccessMethod::decodeCell(cells[0]);
+    ASSERT(aCell.kind == CellKind::kValue);
+    ASSERT_BSONOBJ_EQ(BSON_ARRAY(1 << 2), aCell.value.Obj());
+}
+
+TEST_F(QueryStageColumnScanTest, ColumnScanAssemblesCoveredDocumentsAndFetchesTheRest) {
+    ColumnScanStats stats;
+    auto results = runColumnScan(BSONObj(), &stats);
+
+    // Documents are assembled from the index's paths only, and a document with an array in the
+    // middle of an indexed path is read in full from the record store.
+    ASSERT_EQ(3U, results.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, b: {c: 10}}"), results[0]);
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 2}"), results[1]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, a: 3, b: [{c: 1}, {c: 2}]}"), results[2]);
+
+    ASSERT_EQ(2U, stats.docsAssembled);
+    ASSERT_EQ(1U, stats.docsFetched);
+    ASSERT_EQ(3U, stats.docsTested);
+    ASSERT_EQ(6U, stats.keysExamined);
+}
+
+TEST_F(QueryStageColumnScanTest, ColumnScanAppliesFilter) {
+    ColumnScanStats stats;
+    auto results = runColumnScan(fromjson("{a: {$gte: 2}}"), &stats);
+
+    ASSERT_EQ(2U, results.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 2}"), results[0]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, a: 3, b: [{c: 1}, {c: 2}]}"), results[1]);
+
+    // Every document is still tested against the filter.
+    ASSERT_EQ(3U, stats.docsTested);
+}
+
+TEST_F(QueryStageColumnScanTest, ColumnScanDoesNotReturnDocumentAgainAfterUpdateDuringYield) {
+    dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+    const CollectionPtr& coll = ctx.getCollection();
+
+    WorkingSet ws;
+    ColumnScan scan(_expCtx.get(), coll, getIndex(coll), &ws, nullptr);
+
+    std::vector<BSONObj> results;
+    auto workUntilAdvanced = [&] {
+        while (!scan.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED == scan.work(&id)) {
+                results.push_back(ws.get(id)->doc.value().toBson());
+                ws.free(id);
+                return;
+            }
+        }
+    };
+
+    workUntilAdvanced();
+    ASSERT_EQ(1U, results.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, b: {c: 10}}"), results[0]);
+
+    // The new value of 'a' moves the cell of the first document after the position of the scan in
+    // that column.
+    scan.saveState();
+    update(BSON("_id" << 0), fromjson("{$set: {a: 100}}"));
+    scan.restoreState(&coll);
+
+    while (!scan.isEOF()) {
+        workUntilAdvanced();
+    }
+    ASSERT_EQ(3U, results.size());
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 2}"), results[1]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, a: 3, b: [{c: 1}, {c: 2}]}"), results[2]);
+}
+
+}  // namespace query_stage_column_scan
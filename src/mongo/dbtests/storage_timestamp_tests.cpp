@@ -81,12 +81,14 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_catalog_mongod.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/storage_engine_impl.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/transaction_participant_gen.h"
 #include "mongo/db/vector_clock_mutable.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/stdx/future.h"
@@ -1805,6 +1807,174 @@ public:
     }
 };
 
+/**
+ * Inserts batches of timestamped documents, whose index keys are written in key order rather than
+ * record order, and checks that each key is visible from the timestamp of its record on.
+ */
+class BatchedIndexInsertTest : public StorageTimestampTest {
+protected:
+    /**
+     * Inserts 'docs' in a single WriteUnitOfWork, the i-th at 'firstInsertTime' + i ticks.
+     */
+    Status insertBatch(const CollectionPtr& coll,
+                       const std::vector<BSONObj>& docs,
+                       const LogicalTime& firstInsertTime) {
+        std::vector<InsertStatement> stmts;
+        for (size_t i = 0; i < docs.size(); ++i) {
+            stmts.emplace_back(docs[i], firstInsertTime.addTicks(i).asTimestamp(), presentTerm);
+        }
+
+        WriteUnitOfWork wunit(_opCtx);
+        auto status = coll->insertDocuments(_opCtx, stmts.begin(), stmts.end(), nullptr);
+        if (status.isOK()) {
+            wunit.commit();
+        }
+        return status;
+    }
+
+    /**
+     * Returns the values of the keys of the single field index 'indexName' at 'ts', in key order.
+     */
+    std::vector<int> getIndexKeysAtTimestamp(const CollectionPtr& coll,
+                                             StringData indexName,
+                                             const Timestamp& ts) {
+        OneOffRead oor(_opCtx, ts);
+
+        auto indexCatalog = coll->getIndexCatalog();
+        auto desc = indexCatalog->findIndexByName(_opCtx, indexName);
+        ASSERT(desc) << indexName;
+        auto sortedData = indexCatalog->getEntry(desc)->accessMethod()->getSortedDataInterface();
+
+        std::vector<int> keys;
+        auto cursor = sortedData->newCursor(_opCtx);
+        for (auto entry = cursor->seek(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                 BSONObj(),
+                 sortedData->getKeyStringVersion(),
+                 sortedData->getOrdering(),
+                 true /* forward */,
+                 true /* inclusive */));
+             entry;
+             entry = cursor->next()) {
+            keys.push_back(entry->key.firstElement().numberInt());
+        }
+        return keys;
+    }
+
+    // Batches of two records or more take the batched path.
+    RAIIServerParameterControllerForTest _batchedKeyInsertionController{
+        "internalIndexBatchedKeyInsertionMinRecords", 2};
+};
+
+class BatchedInsertTimestampsUniqueIndexKeys : public BatchedIndexInsertTest {
+public:
+    void run() {
+        // In order for the inserts to be written at the timestamps of their statements, we must be
+        // in non-replicated mode.
+        repl::UnreplicatedWritesBlock uwb(_opCtx);
+
+        NamespaceString nss("unittests.batchedInsertTimestampsUniqueIndexKeys");
+        reset(nss);
+
+        AutoGetCollection autoColl(_opCtx, nss, LockMode::MODE_IX);
+        auto indexName = "u_1";
+        auto indexSpec = BSON("name" << indexName << "key" << BSON("u" << 1) << "unique" << true
+                                     << "v" << static_cast<int>(kIndexVersion));
+        ASSERT_OK(dbtests::createIndexFromSpec(_opCtx, nss.ns(), indexSpec));
+
+        // Each record has a smaller key than the one before it, so the keys are written in the
+        // reverse order of their timestamps.
+        const int numDocs = 5;
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < numDocs; ++i) {
+            docs.push_back(BSON("_id" << i << "u" << numDocs - i));
+        }
+        const LogicalTime firstInsertTime = _clock->tickClusterTime(numDocs);
+        ASSERT_OK(insertBatch(autoColl.getCollection(), docs, firstInsertTime));
+
+        ASSERT(getIndexKeysAtTimestamp(
+                   autoColl.getCollection(), indexName, firstInsertTime.addTicks(-1).asTimestamp())
+                   .empty());
+        for (int i = 0; i < numDocs; ++i) {
+            std::vector<int> expectedKeys;
+            for (int u = numDocs - i; u <= numDocs; ++u) {
+                expectedKeys.push_back(u);
+            }
+            ASSERT(expectedKeys ==
+                   getIndexKeysAtTimestamp(autoColl.getCollection(),
+                                           indexName,
+                                           firstInsertTime.addTicks(i).asTimestamp()))
+                << "i is " << i;
+        }
+
+        // A batch with a duplicate key fails as a whole, and leaves the index unchanged.
+        const LogicalTime secondInsertTime = _clock->tickClusterTime(2);
+        ASSERT_EQ(ErrorCodes::DuplicateKey,
+                  insertBatch(autoColl.getCollection(),
+                              {BSON("_id" << numDocs << "u" << 0),
+                               BSON("_id" << numDocs + 1 << "u" << 1)},
+                              secondInsertTime));
+        ASSERT_EQ(static_cast<size_t>(numDocs),
+                  getIndexKeysAtTimestamp(autoColl.getCollection(), indexName, Timestamp()).size());
+    }
+};
+
+class BatchedInsertTimestampsMultikeyIndexKeys : public BatchedIndexInsertTest {
+public:
+    void run() {
+        // In order for the inserts to be written at the timestamps of their statements, we must be
+        // in non-replicated mode.
+        repl::UnreplicatedWritesBlock uwb(_opCtx);
+
+        NamespaceString nss("unittests.batchedInsertTimestampsMultikeyIndexKeys");
+        reset(nss);
+
+        AutoGetCollection autoColl(_opCtx, nss, LockMode::MODE_IX);
+        auto indexName = "a_1";
+        auto indexSpec = BSON("name" << indexName << "key" << BSON("a" << 1) << "v"
+                                     << static_cast<int>(kIndexVersion));
+        ASSERT_OK(dbtests::createIndexFromSpec(_opCtx, nss.ns(), indexSpec));
+
+        // The second record makes the index multikey. Each record has smaller keys than the one
+        // before it, so the keys are written in the reverse order of their timestamps.
+        std::vector<BSONObj> docs{BSON("_id" << 0 << "a" << 40),
+                                  BSON("_id" << 1 << "a" << BSON_ARRAY(30 << 31)),
+                                  BSON("_id" << 2 << "a" << 20),
+                                  BSON("_id" << 3 << "a" << BSON_ARRAY(10 << 11))};
+        const LogicalTime firstInsertTime = _clock->tickClusterTime(docs.size());
+        ASSERT_OK(insertBatch(autoColl.getCollection(), docs, firstInsertTime));
+
+        const std::vector<std::vector<int>> expectedKeys{
+            {40}, {30, 31, 40}, {20, 30, 31, 40}, {10, 11, 20, 30, 31, 40}};
+        for (size_t i = 0; i < docs.size(); ++i) {
+            ASSERT(expectedKeys[i] ==
+                   getIndexKeysAtTimestamp(autoColl.getCollection(),
+                                           indexName,
+                                           firstInsertTime.addTicks(i).asTimestamp()))
+                << "i is " << i;
+        }
+
+        // The index is multikey from the timestamp of the first multikey record on.
+        assertMultikeyPaths(_opCtx,
+                            autoColl.getCollection(),
+                            indexName,
+                            firstInsertTime.asTimestamp(),
+                            false,
+                            {{}});
+        assertMultikeyPaths(_opCtx,
+                            autoColl.getCollection(),
+                            indexName,
+                            firstInsertTime.addTicks(1).asTimestamp(),
+                            true,
+                            {{0}});
+        assertMultikeyPaths(_opCtx,
+                            autoColl.getCollection(),
+                            indexName,
+                            firstInsertTime.addTicks(docs.size() - 1).asTimestamp(),
+                            true,
+                            {{0}});
+    }
+};
+
 class InitializeMinValid : public StorageTimestampTest {
 public:
     void run() {
@@ -4209,6 +4379,8 @@ public:
         addIf<PrimarySetIndexMultikeyOnInsert>();
         addIf<PrimarySetIndexMultikeyOnInsertUnreplicated>();
         addIf<PrimarySetsMultikeyInsideMultiDocumentTransaction>();
+        addIf<BatchedInsertTimestampsUniqueIndexKeys>();
+        addIf<BatchedInsertTimestampsMultikeyIndexKeys>();
         addIf<InitializeMinValid>();
         addIf<SetMinValidInitialSyncFlag>();
         addIf<SetMinValidToAtLeast>();
@@ -102,6 +102,15 @@ public:
         _value.store(newValue);
     }
 
+    /**
+     * Sets the value of this AtomicWord to "newValue".
+     *
+     * Has relaxed semantics.
+     */
+    void storeRelaxed(WordType newValue) {
+        _value.store(newValue, std::memory_order_relaxed);
+    }
+
     /**
      * Atomically swaps the current value of this with "newValue".
      *
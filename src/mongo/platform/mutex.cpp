@@ -29,8 +29,19 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/stdx/chrono.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MONGO_LATCH_CALLER_ADDRESS() reinterpret_cast<uintptr_t>(_ReturnAddress())
+#else
+#define MONGO_LATCH_CALLER_ADDRESS() reinterpret_cast<uintptr_t>(__builtin_return_address(0))
+#endif
 
 namespace mongo::latch_detail {
 
@@ -51,6 +62,43 @@ void Identity::serialize(BSONObjBuilder* bob) const {
     bob->appendNumber("line"_sd, static_cast<long long>(line));
 }
 
+void ContentionStats::recordWait(Microseconds wait) {
+    const auto micros = std::max(durationCount<Microseconds>(wait), Microseconds::rep{0});
+    const size_t bucket = micros == 0
+        ? 0
+        : std::min<size_t>(64 - countLeadingZerosNonZero64(micros), kNumWaitBuckets - 1);
+    _waitBuckets[bucket].fetchAndAddRelaxed(1);
+    _totalWaitMicros.fetchAndAddRelaxed(micros);
+}
+
+void ContentionStats::recordHolderSite(uintptr_t address) {
+    stdx::lock_guard lk(_holderSitesMutex);  // NOLINT
+    for (auto& site : _holderSites) {
+        if (site.count == 0) {
+            site.address = address;
+        }
+        if (site.address == address) {
+            ++site.count;
+            return;
+        }
+    }
+    ++_otherHolderSitesCount;
+}
+
+std::vector<ContentionStats::HolderSite> ContentionStats::holderSites(
+    long long* otherSitesCount) const {
+    std::vector<HolderSite> sites;
+    stdx::lock_guard lk(_holderSitesMutex);  // NOLINT
+    for (auto& site : _holderSites) {
+        if (site.count == 0) {
+            break;
+        }
+        sites.push_back(site);
+    }
+    *otherSitesCount = _otherHolderSitesCount;
+    return sites;
+}
+
 Mutex::Mutex(std::shared_ptr<Data> data) : _data{std::move(data)} {
     invariant(_data);
 
@@ -64,15 +112,30 @@ Mutex::~Mutex() {
 }
 
 void Mutex::lock() {
+    const auto callerAddress = MONGO_LATCH_CALLER_ADDRESS();
     if (_mutex.try_lock()) {
         _isLocked = true;
+        _holderSite.storeRelaxed(callerAddress);
         _onQuickLock();
         return;
     }
 
     _onContendedLock();
+
+    auto& contentionStats = _data->contentionStats();
+    if (contentionStats.shouldSampleHolder()) {
+        // The holder may release the Mutex, and another thread acquire it, between the failed
+        // try_lock() and this load, which makes the sample slightly imprecise but never invalid.
+        contentionStats.recordHolderSite(_holderSite.loadRelaxed());
+    }
+
+    const auto waitStart = stdx::chrono::steady_clock::now();
     _mutex.lock();
+    contentionStats.recordWait(
+        duration_cast<Microseconds>(stdx::chrono::steady_clock::now() - waitStart));
+
     _isLocked = true;
+    _holderSite.storeRelaxed(callerAddress);
     _onSlowLock();
 }
 
@@ -87,6 +150,7 @@ bool Mutex::try_lock() {
     }
 
     _isLocked = true;
+    _holderSite.storeRelaxed(MONGO_LATCH_CALLER_ADDRESS());
     _onQuickLock();
     return true;
 }
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -207,6 +209,79 @@ void installDiagnosticListener() {
     invariant(!state.isFinalized.load());
 }
 
+/**
+ * Always-on accounting of the contended acquisitions of a latch: how long they waited, and, for a
+ * sample of them, the call site which held the latch when they started to wait.
+ *
+ * Recording a wait costs a few relaxed atomic increments, which is negligible next to blocking on
+ * the latch. Recording a holder site takes a mutex, so only one in kHolderSampleInterval contended
+ * acquisitions does it.
+ */
+class ContentionStats {
+public:
+    /**
+     * Bucket 0 counts waits shorter than 1 microsecond and bucket i > 0 counts waits of at least
+     * 2^(i-1) microseconds. The last bucket has no upper bound.
+     */
+    static constexpr size_t kNumWaitBuckets = 24;
+
+    static constexpr int kHolderSampleInterval = 16;
+    static constexpr size_t kMaxHolderSites = 8;
+
+    struct HolderSite {
+        uintptr_t address = 0;
+        long long count = 0;
+    };
+
+    /**
+     * Return the smallest wait in microseconds counted by the given bucket
+     */
+    static long long bucketLowerBoundMicros(size_t bucket) {
+        return bucket == 0 ? 0 : 1LL << (bucket - 1);
+    }
+
+    /**
+     * Account for a contended acquisition which waited for the given duration
+     */
+    void recordWait(Microseconds wait);
+
+    /**
+     * Return true if the holder site should be recorded for the contended acquisition starting now
+     */
+    bool shouldSampleHolder() {
+        return _numSampleCandidates.fetchAndAddRelaxed(1) % kHolderSampleInterval == 0;
+    }
+
+    /**
+     * Account for a sampled contended acquisition which found the latch held from the given
+     * address. Once kMaxHolderSites sites are known, any other site is only counted in aggregate.
+     */
+    void recordHolderSite(uintptr_t address);
+
+    long long waitCount(size_t bucket) const {
+        return _waitBuckets[bucket].loadRelaxed();
+    }
+
+    long long totalWaitMicros() const {
+        return _totalWaitMicros.loadRelaxed();
+    }
+
+    /**
+     * Return the known holder sites, and in 'otherSitesCount' the number of samples which found the
+     * latch held from any other site.
+     */
+    std::vector<HolderSite> holderSites(long long* otherSitesCount) const;
+
+private:
+    std::array<AtomicWord<long long>, kNumWaitBuckets> _waitBuckets{};
+    AtomicWord<long long> _totalWaitMicros{0};
+    AtomicWord<long long> _numSampleCandidates{0};
+
+    mutable stdx::mutex _holderSitesMutex;  // NOLINT
+    std::array<HolderSite, kMaxHolderSites> _holderSites;
+    long long _otherHolderSitesCount = 0;
+};
+
 /**
  * This class holds working data for a latchable resource
  *
@@ -228,6 +303,14 @@ public:
         return _identity;
     }
 
+    auto& contentionStats() {
+        return _contentionStats;
+    }
+
+    const auto& contentionStats() const {
+        return _contentionStats;
+    }
+
 private:
     const Identity _identity;
 
@@ -241,6 +324,7 @@ private:
     };
 
     Counts _counts;
+    ContentionStats _contentionStats;
 };
 
 /**
@@ -357,6 +441,10 @@ private:
 
     stdx::mutex _mutex;  // NOLINT
     bool _isLocked = false;
+
+    // The return address of the lock() or try_lock() call which last acquired this Mutex. It is
+    // read without holding the Mutex by contended acquisitions sampling where it is held from.
+    AtomicWord<uintptr_t> _holderSite{0};
 };
 }  // namespace latch_detail
 
@@ -31,6 +31,8 @@
 
 #include "mongo/config.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 TEST(MutexTest, BasicSingleThread) {
@@ -67,6 +69,77 @@ TEST(MutexTest, Macros) {
     static_assert(std::is_same_v<decltype(gMutex), Mutex>);
     ASSERT_EQ(gMutex.getName(), latch_detail::kAnonymousName);
 }
+
+TEST(MutexTest, ContentionStatsBucketsWaitsByPowersOfTwo) {
+    using ContentionStats = latch_detail::ContentionStats;
+    ContentionStats stats;
+    stats.recordWait(Microseconds(0));
+    stats.recordWait(Microseconds(1));
+    stats.recordWait(Microseconds(3));
+    stats.recordWait(Microseconds(4));
+    stats.recordWait(Hours(1));
+
+    ASSERT_EQ(stats.waitCount(0), 1);
+    ASSERT_EQ(stats.waitCount(1), 1);
+    ASSERT_EQ(stats.waitCount(2), 1);
+    ASSERT_EQ(stats.waitCount(3), 1);
+    ASSERT_EQ(stats.waitCount(ContentionStats::kNumWaitBuckets - 1), 1);
+    ASSERT_EQ(stats.totalWaitMicros(), 8 + durationCount<Microseconds>(Hours(1)));
+
+    ASSERT_EQ(ContentionStats::bucketLowerBoundMicros(0), 0);
+    ASSERT_EQ(ContentionStats::bucketLowerBoundMicros(1), 1);
+    ASSERT_EQ(ContentionStats::bucketLowerBoundMicros(3), 4);
+}
+
+TEST(MutexTest, ContentionStatsCountsHolderSitesBeyondTheTableInAggregate) {
+    using ContentionStats = latch_detail::ContentionStats;
+    ContentionStats stats;
+    for (uintptr_t address = 1; address <= ContentionStats::kMaxHolderSites + 2; ++address) {
+        stats.recordHolderSite(address);
+        stats.recordHolderSite(1);
+    }
+
+    long long otherSitesCount = 0;
+    auto sites = stats.holderSites(&otherSitesCount);
+    ASSERT_EQ(sites.size(), ContentionStats::kMaxHolderSites);
+    ASSERT_EQ(sites[0].address, 1U);
+    ASSERT_EQ(sites[0].count, static_cast<long long>(ContentionStats::kMaxHolderSites + 3));
+    ASSERT_EQ(sites[1].count, 1);
+    ASSERT_EQ(otherSitesCount, 2);
+}
+
+TEST(MutexTest, ContendedLockIsAccounted) {
+    auto data = MONGO_GET_LATCH_DATA("contendedLatchForTest");
+    Mutex m(data);
+
+    m.lock();
+    stdx::thread waiter([&] {
+        m.lock();
+        m.unlock();
+    });
+    while (data->counts().contended.load() == 0) {
+        sleepmillis(1);
+    }
+    sleepmillis(10);
+    m.unlock();
+    waiter.join();
+
+    auto& stats = data->contentionStats();
+    long long numWaits = 0;
+    for (size_t i = 0; i < latch_detail::ContentionStats::kNumWaitBuckets; ++i) {
+        numWaits += stats.waitCount(i);
+    }
+    ASSERT_EQ(numWaits, 1);
+    ASSERT_GT(stats.totalWaitMicros(), 0);
+
+    // The first contended acquisition is always sampled, and found the Mutex held from here.
+    long long otherSitesCount = 0;
+    auto sites = stats.holderSites(&otherSitesCount);
+    ASSERT_EQ(sites.size(), 1U);
+    ASSERT_NE(sites[0].address, 0U);
+    ASSERT_EQ(sites[0].count, 1);
+    ASSERT_EQ(otherSitesCount, 0);
+}
 #endif
 
 }  // namespace mongo
@@ -43,7 +43,9 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/concurrency/thread_name.h"
@@ -58,6 +60,13 @@ using namespace fmt::literals;
 // Counter used to assign unique names to otherwise-unnamed thread pools.
 AtomicWord<int> nextUnnamedThreadPoolId{1};
 
+// The pool, and the index of the queue, of the work-stealing worker running on this thread, if any.
+struct WorkStealingWorker {
+    const void* pool = nullptr;
+    size_t queueIndex = 0;
+};
+thread_local WorkStealingWorker currentWorker;
+
 std::string threadIdToString(stdx::thread::id id) {
     std::ostringstream oss;
     oss << id;
@@ -94,6 +103,13 @@ ThreadPool::Options cleanUpOptions(ThreadPool::Options&& options) {
                     "minThreads"_attr = options.minThreads,
                     "maxThreads"_attr = options.maxThreads);
     }
+    if (options.workStealing && options.maxThreads == ThreadPool::Options::kUnlimited) {
+        LOGV2_FATAL(5962404,
+                    "Cannot create work-stealing pool {poolName} with an unlimited number of "
+                    "threads",
+                    "Cannot create work-stealing pool with an unlimited number of threads",
+                    "poolName"_attr = options.poolName);
+    }
     return {std::move(options)};
 }
 
@@ -129,8 +145,20 @@ private:
      */
     enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
 
+    /**
+     * Queue of the tasks of one worker thread of a work-stealing pool. Each queue is on its own
+     * cache line, so that workers taking tasks from their own queue do not contend.
+     */
+    struct alignas(stdx::hardware_destructive_interference_size) WorkerQueue {
+        Mutex mutex = MONGO_MAKE_LATCH("ThreadPool::WorkerQueue::mutex");
+        std::deque<Task> tasks;
+
+        // Set when the pool is joined, after which no more tasks may be queued.
+        bool closed = false;
+    };
+
     /** The thread body for worker threads. */
-    void _workerThreadBody(const std::string& threadName) noexcept;
+    void _workerThreadBody(const std::string& threadName, size_t queueIndex) noexcept;
 
     /**
      * Starts a worker thread, unless _options.maxThreads threads are already running or
@@ -143,6 +171,30 @@ private:
      */
     void _consumeTasks();
 
+    /**
+     * Implementation of schedule for work-stealing pools, which does not take _mutex unless a
+     * worker has to be woken up.
+     */
+    void _scheduleWorkStealing(Task task);
+
+    /**
+     * The run loop of a worker thread of a work-stealing pool, which owns the queue at
+     * 'queueIndex' in _workerQueues.
+     */
+    void _consumeTasksWorkStealing(size_t queueIndex);
+
+    /**
+     * Runs one task from the queue at 'queueIndex', or else from the queue of another worker
+     * chosen with 'random'. Returns false if no task was found.
+     */
+    bool _runOneTaskWorkStealing(size_t queueIndex, PseudoRandom* random);
+
+    /**
+     * Takes the oldest task out of "queue" into "task", counting it as running. Returns false if
+     * the queue is empty.
+     */
+    bool _popTask(WorkerQueue* queue, Task* task);
+
     /**
      * Implementation of shutdown once _mutex is locked.
      */
@@ -153,6 +205,11 @@ private:
      */
     void _join_inlock(stdx::unique_lock<Latch>* lk);
 
+    /**
+     * Implementation of join for work-stealing pools, once _state is joining.
+     */
+    void _joinWorkStealing_inlock(stdx::unique_lock<Latch>* lk);
+
     /**
      * Runs the remaining tasks on a new thread as part of the join process, blocking until
      * complete. Caller must not hold the mutex!
@@ -218,9 +275,32 @@ private:
 
     // The last time that _pendingTasks.size() grew to be at least _threads.size().
     Date_t _lastFullUtilizationDate;
+
+    // The queues of the workers of a work-stealing pool, which replace _pendingTasks. Empty for
+    // other pools.
+    std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+
+    // Whether _state allows scheduling tasks, readable without _mutex.
+    AtomicWord<bool> _acceptingTasks{true};
+
+    // Number of tasks in _workerQueues, and number of tasks taken out of them which are running.
+    AtomicWord<size_t> _numQueuedTasks{0};
+    AtomicWord<size_t> _numRunningTasks{0};
+
+    // Number of workers of a work-stealing pool waiting on _workAvailable.
+    AtomicWord<size_t> _numSleepingWorkers{0};
+
+    // Used to spread the tasks scheduled from outside a work-stealing pool across _workerQueues.
+    AtomicWord<size_t> _nextWorkerQueue{0};
 };
 
-ThreadPool::Impl::Impl(Options options) : _options(cleanUpOptions(std::move(options))) {}
+ThreadPool::Impl::Impl(Options options) : _options(cleanUpOptions(std::move(options))) {
+    if (_options.workStealing) {
+        for (size_t i = 0; i < _options.maxThreads; ++i) {
+            _workerQueues.push_back(std::make_unique<WorkerQueue>());
+        }
+    }
+}
 
 ThreadPool::Impl::~Impl() {
     stdx::unique_lock<Latch> lk(_mutex);
@@ -234,6 +314,7 @@ ThreadPool::Impl::~Impl() {
     }
     invariant(_threads.empty());
     invariant(_pendingTasks.empty());
+    invariant(_numQueuedTasks.load() == 0);
 }
 
 void ThreadPool::Impl::startup() {
@@ -246,7 +327,9 @@ void ThreadPool::Impl::startup() {
     }
     _setState_inlock(running);
     invariant(_threads.empty());
-    size_t numToStart = std::clamp(_pendingTasks.size(), _options.minThreads, _options.maxThreads);
+    size_t numToStart = _options.workStealing
+        ? _options.maxThreads
+        : std::clamp(_pendingTasks.size(), _options.minThreads, _options.maxThreads);
     for (size_t i = 0; i < numToStart; ++i) {
         _startWorkerThread_inlock();
     }
@@ -297,6 +380,11 @@ void ThreadPool::Impl::_join_inlock(stdx::unique_lock<Latch>* lk) {
     }
 
     _setState_inlock(joining);
+    if (_options.workStealing) {
+        _joinWorkStealing_inlock(lk);
+        return;
+    }
+
     ++_numIdleThreads;
     if (!_pendingTasks.empty()) {
         lk->unlock();
@@ -315,6 +403,28 @@ void ThreadPool::Impl::_join_inlock(stdx::unique_lock<Latch>* lk) {
     _setState_inlock(shutdownComplete);
 }
 
+void ThreadPool::Impl::_joinWorkStealing_inlock(stdx::unique_lock<Latch>* lk) {
+    // The workers run the tasks left in the queues before exiting.
+    auto threadsToJoin = std::exchange(_threads, {});
+    lk->unlock();
+    for (auto& t : threadsToJoin) {
+        t.join();
+    }
+
+    // Tasks may still have been queued by callers which saw the pool running just before it shut
+    // down. Once the queues are closed, the tasks left in them are the last ones.
+    for (auto& queue : _workerQueues) {
+        stdx::lock_guard<Latch> queueLk(queue->mutex);
+        queue->closed = true;
+    }
+    if (_numQueuedTasks.load() > 0) {
+        _drainPendingTasks();
+    }
+    lk->lock();
+    invariant(_state == joining);
+    _setState_inlock(shutdownComplete);
+}
+
 void ThreadPool::Impl::_drainPendingTasks() {
     // Tasks cannot be run inline because they can create OperationContexts and the join() caller
     // may already have one associated with the thread.
@@ -323,6 +433,12 @@ void ThreadPool::Impl::_drainPendingTasks() {
         setThreadName(threadName);
         if (_options.onCreateThread)
             _options.onCreateThread(threadName);
+        if (_options.workStealing) {
+            PseudoRandom random(SecureRandom().nextInt64());
+            while (_runOneTaskWorkStealing(0, &random)) {
+            }
+            return;
+        }
         stdx::unique_lock<Latch> lock(_mutex);
         while (!_pendingTasks.empty()) {
             _doOneTask(&lock);
@@ -332,6 +448,11 @@ void ThreadPool::Impl::_drainPendingTasks() {
 }
 
 void ThreadPool::Impl::schedule(Task task) {
+    if (_options.workStealing) {
+        _scheduleWorkStealing(std::move(task));
+        return;
+    }
+
     stdx::unique_lock<Latch> lk(_mutex);
 
     switch (_state) {
@@ -366,6 +487,40 @@ void ThreadPool::Impl::schedule(Task task) {
     _workAvailable.notify_one();
 }
 
+void ThreadPool::Impl::_scheduleWorkStealing(Task task) {
+    auto rejectTask = [&] {
+        task(Status(ErrorCodes::ShutdownInProgress,
+                    "Shutdown of thread pool {} in progress"_format(_options.poolName)));
+    };
+    if (!_acceptingTasks.load()) {
+        rejectTask();
+        return;
+    }
+
+    // Workers keep the tasks they schedule, which are likely to use the same data, for themselves.
+    const size_t queueIndex = currentWorker.pool == this
+        ? currentWorker.queueIndex
+        : _nextWorkerQueue.fetchAndAdd(1) % _workerQueues.size();
+    auto& queue = *_workerQueues[queueIndex];
+    {
+        stdx::unique_lock<Latch> queueLk(queue.mutex);
+        if (queue.closed) {
+            queueLk.unlock();
+            rejectTask();
+            return;
+        }
+        queue.tasks.emplace_back(std::move(task));
+        _numQueuedTasks.fetchAndAdd(1);
+    }
+
+    // A worker counts itself as sleeping before it checks for queued tasks one last time, so
+    // either it sees this task, or this sees it sleeping.
+    if (_numSleepingWorkers.load() > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workAvailable.notify_one();
+    }
+}
+
 void ThreadPool::Impl::waitForIdle() {
     stdx::unique_lock<Latch> lk(_mutex);
     // True when there are no `_pendingTasks` and all `_threads` are idle, or when the ThreadPool
@@ -373,6 +528,10 @@ void ThreadPool::Impl::waitForIdle() {
     // before shutdown(), there is no guarantee that there will still be no pending tasks when the
     // function returns.
     auto isIdle = [this] {
+        if (_options.workStealing) {
+            return (_numQueuedTasks.load() == 0 && _numRunningTasks.load() == 0) ||
+                _state == joinRequired;
+        }
         return (_pendingTasks.empty() && _numIdleThreads >= _threads.size()) ||
             _state == joinRequired;
     };
@@ -386,11 +545,17 @@ ThreadPool::Stats ThreadPool::Impl::getStats() const {
     result.numThreads = _threads.size();
     result.numIdleThreads = _numIdleThreads;
     result.numPendingTasks = _pendingTasks.size();
+    if (_options.workStealing) {
+        result.numIdleThreads =
+            _threads.size() - std::min(_threads.size(), _numRunningTasks.load());
+        result.numPendingTasks = _numQueuedTasks.load();
+    }
     result.lastFullUtilizationDate = _lastFullUtilizationDate;
     return result;
 }
 
-void ThreadPool::Impl::_workerThreadBody(const std::string& threadName) noexcept {
+void ThreadPool::Impl::_workerThreadBody(const std::string& threadName,
+                                         size_t queueIndex) noexcept {
     setThreadName(threadName);
     if (_options.onCreateThread)
         _options.onCreateThread(threadName);
@@ -400,7 +565,11 @@ void ThreadPool::Impl::_workerThreadBody(const std::string& threadName) noexcept
                 "Starting thread",
                 "threadName"_attr = threadName,
                 "poolName"_attr = _options.poolName);
-    _consumeTasks();
+    if (_options.workStealing) {
+        _consumeTasksWorkStealing(queueIndex);
+    } else {
+        _consumeTasks();
+    }
     LOGV2_DEBUG(23105,
                 1,
                 "Shutting down thread {threadName} in pool {poolName}",
@@ -511,6 +680,80 @@ void ThreadPool::Impl::_consumeTasks() {
     _retiredThreads.splice(_retiredThreads.end(), _threads, pos);
 }
 
+void ThreadPool::Impl::_consumeTasksWorkStealing(size_t queueIndex) {
+    currentWorker = {this, queueIndex};
+    PseudoRandom random(SecureRandom().nextInt64());
+    while (true) {
+        if (_runOneTaskWorkStealing(queueIndex, &random)) {
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        if (_state != running) {
+            break;
+        }
+        _numSleepingWorkers.fetchAndAdd(1);
+        MONGO_IDLE_THREAD_BLOCK;
+        _workAvailable.wait(lk, [&] { return _state != running || _numQueuedTasks.load() > 0; });
+        _numSleepingWorkers.subtractAndFetch(1);
+    }
+
+    // The pool is shutting down, so this thread lends a hand in running the tasks left in the
+    // queues, and returns so it can be joined.
+    while (_runOneTaskWorkStealing(queueIndex, &random)) {
+    }
+    currentWorker = {};
+}
+
+bool ThreadPool::Impl::_runOneTaskWorkStealing(size_t queueIndex, PseudoRandom* random) {
+    Task task;
+    if (!_popTask(_workerQueues[queueIndex].get(), &task)) {
+        if (_numQueuedTasks.load() == 0) {
+            return false;
+        }
+
+        // Starting from a random queue spreads the workers looking for tasks across the queues.
+        const size_t numQueues = _workerQueues.size();
+        const size_t start = random->nextInt64(numQueues);
+        for (size_t i = 0; i < numQueues && !task; ++i) {
+            const size_t victim = (start + i) % numQueues;
+            if (victim != queueIndex) {
+                _popTask(_workerQueues[victim].get(), &task);
+            }
+        }
+        if (!task) {
+            return false;
+        }
+    }
+
+    // Note that if the task throws, the task destructor will run before the exception hits the
+    // noexcept boundary.
+    task(Status::OK());
+
+    // Reset the task and run the dtor before the pool may be seen as idle.
+    task = {};
+    if (_numRunningTasks.subtractAndFetch(1) == 0 && _numQueuedTasks.load() == 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _poolIsIdle.notify_all();
+    }
+    return true;
+}
+
+bool ThreadPool::Impl::_popTask(WorkerQueue* queue, Task* task) {
+    stdx::lock_guard<Latch> lk(queue->mutex);
+    if (queue->tasks.empty()) {
+        return false;
+    }
+    *task = std::move(queue->tasks.front());
+    queue->tasks.pop_front();
+
+    // The task counts as running before it stops counting as queued, so that waitForIdle() does
+    // not see the pool as idle in between.
+    _numRunningTasks.fetchAndAdd(1);
+    _numQueuedTasks.subtractAndFetch(1);
+    return true;
+}
+
 void ThreadPool::Impl::_doOneTask(stdx::unique_lock<Latch>* lk) noexcept {
     invariant(!_pendingTasks.empty());
     LOGV2_DEBUG(23109,
@@ -574,8 +817,10 @@ void ThreadPool::Impl::_startWorkerThread_inlock() {
     }
     invariant(_threads.size() < _options.maxThreads);
     std::string threadName = "{}{}"_format(_options.threadNamePrefix, _nextThreadId++);
+    const size_t queueIndex = _threads.size();
     try {
-        _threads.emplace_back([this, threadName] { _workerThreadBody(threadName); });
+        _threads.emplace_back(
+            [this, threadName, queueIndex] { _workerThreadBody(threadName, queueIndex); });
         ++_numIdleThreads;
     } catch (const std::exception& ex) {
         LOGV2_ERROR(23113,
@@ -594,6 +839,7 @@ void ThreadPool::Impl::_setState_inlock(const LifecycleState newState) {
         return;
     }
     _state = newState;
+    _acceptingTasks.store(newState == preStart || newState == running);
     _stateChange.notify_all();
 }
 
@@ -100,6 +100,15 @@ public:
         // a thread.
         Milliseconds maxIdleThreadAge = Seconds{30};
 
+        // If true, each worker thread has its own queue of tasks, and takes tasks from the queue
+        // of another, randomly chosen, worker when its own is empty, instead of all of them
+        // sharing one queue under the pool mutex. Tasks scheduled by a worker go to its own queue,
+        // and other tasks are spread across the queues.
+        //
+        // A work-stealing pool runs exactly maxThreads threads from startup until it is joined,
+        // so minThreads and maxIdleThreadAge do not apply, and maxThreads must be limited.
+        bool workStealing = false;
+
         /** If callable, called before each worker thread begins consuming tasks. */
         std::function<void(const std::string&)> onCreateThread;
 
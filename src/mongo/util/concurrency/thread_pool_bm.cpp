@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Runs small tasks which each schedule several smaller ones, as when a batch of oplog entries is
+ * split across the writer threads, on a pool of 'threads' threads, which shares one task queue or
+ * steals work from per-thread queues depending on 'workStealing'.
+ */
+void BM_ThreadPoolFanOut(benchmark::State& state) {
+    constexpr int kNumTasks = 1000;
+    constexpr int kTasksPerTask = 10;
+
+    ThreadPool::Options options;
+    options.workStealing = state.range(0);
+    options.minThreads = state.range(1);
+    options.maxThreads = state.range(1);
+    ThreadPool pool(options);
+    pool.startup();
+
+    AtomicWord<long long> counter{0};
+    for (auto _ : state) {
+        for (int i = 0; i < kNumTasks; ++i) {
+            pool.schedule([&](Status) {
+                for (int j = 0; j < kTasksPerTask; ++j) {
+                    pool.schedule([&](Status) { counter.fetchAndAdd(1); });
+                }
+            });
+        }
+        pool.waitForIdle();
+    }
+
+    pool.shutdown();
+    pool.join();
+    state.SetItemsProcessed(state.iterations() * kNumTasks * (1 + kTasksPerTask));
+}
+
+BENCHMARK(BM_ThreadPoolFanOut)
+    ->ArgNames({"workStealing", "threads"})
+    ->ArgsProduct({{0, 1}, {1, 4, 16, 64}})
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -57,6 +57,14 @@ MONGO_INITIALIZER(ThreadPoolCommonTests)(InitializerContext*) {
                           []() { return std::make_unique<ThreadPool>(ThreadPool::Options()); });
 }
 
+MONGO_INITIALIZER(ThreadPoolWorkStealingCommonTests)(InitializerContext*) {
+    addTestsForThreadPool("ThreadPoolWorkStealingCommon", []() {
+        ThreadPool::Options options;
+        options.workStealing = true;
+        return std::make_unique<ThreadPool>(options);
+    });
+}
+
 class ThreadPoolTest : public unittest::Test {
 protected:
     ThreadPool& makePool(ThreadPool::Options options) {
@@ -328,4 +336,42 @@ TEST(ThreadPoolTest, SafeToCallWaitForIdleBeforeShutdown) {
     pool.waitForIdle();
 }
 
+TEST(ThreadPoolTest, WorkStealingPoolRunsTasksScheduledByItsWorkers) {
+    ThreadPool::Options options;
+    options.maxThreads = 4;
+    options.workStealing = true;
+    ThreadPool pool(options);
+    pool.startup();
+    ASSERT_EQ(pool.getStats().numThreads, 4U);
+
+    // Each task schedules more tasks, which stay in the queue of its worker until they are run by
+    // that worker or stolen by another.
+    const int fanOut = 8;
+    const int depth = 3;
+    AtomicWord<int> executed{0};
+    std::function<void(int)> runTask = [&](int level) {
+        executed.fetchAndAdd(1);
+        if (level == depth) {
+            return;
+        }
+        for (int i = 0; i < fanOut; ++i) {
+            pool.schedule([&, level](Status status) {
+                ASSERT_OK(status);
+                runTask(level + 1);
+            });
+        }
+    };
+    runTask(0);
+    pool.waitForIdle();
+
+    ASSERT_EQ(executed.load(), 1 + fanOut + fanOut * fanOut + fanOut * fanOut * fanOut);
+    const auto stats = pool.getStats();
+    ASSERT_EQ(stats.numPendingTasks, 0U);
+    ASSERT_EQ(stats.numIdleThreads, 4U);
+
+    pool.shutdown();
+    pool.join();
+    pool.schedule([](Status status) { ASSERT_EQ(status, ErrorCodes::ShutdownInProgress); });
+}
+
 }  // namespace
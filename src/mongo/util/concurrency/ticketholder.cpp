@@ -27,110 +27,57 @@
  *    it in the license file.
  */
 
-#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
-
 #include "mongo/platform/basic.h"
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
-
-#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/ticketholder_parameters_gen.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
-#if defined(__linux__)
-namespace {
-
-/**
- * Accepts an errno code, prints its error message, and exits.
- */
-void failWithErrno(int err) {
-    LOGV2_FATAL(28604,
-                "error in Ticketholder: {errnoWithDescription_err}",
-                "errnoWithDescription_err"_attr = errnoWithDescription(err));
-}
+struct TicketHolder::Waiter {
+    stdx::condition_variable cv;
+    bool granted = false;
+    std::list<Waiter*>::iterator position;
+};
 
-/*
- * Checks the return value from a Linux semaphore function call, and fails with the set errno if the
- * call was unsucessful.
- */
-void check(int ret) {
-    if (ret == 0)
-        return;
-    failWithErrno(errno);
-}
-
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
-}  // namespace
-
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    check(sem_init(&_sem, 0, num));
-}
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {}
 
-TicketHolder::~TicketHolder() {
-    check(sem_destroy(&_sem));
-}
+TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
-    }
-    return true;
+    // Taking a ticket while others wait for one would cut ahead of them.
+    return _numWaiting.load() == 0 && _tryAcquireAvailable();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
+    // Attempt to get a ticket without queueing in order to avoid taking the mutex and timing. This
+    // is only done when nobody is queued, so that new arrivals never cut ahead of the waiters.
+    if (_numWaiting.load() == 0 && _tryAcquireAvailable()) {
         return true;
     }
+    _totalQueued.fetchAndAdd(1);
 
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
+    auto& stats = _priorityStats[static_cast<int>(priority)];
+    stats.queued.fetchAndAdd(1);
+    Timer timer;
+    ON_BLOCK_EXIT([&] { stats.queuedMicros.fetchAndAdd(timer.micros()); });
 
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
+    return _waitInQueue(opCtx, until, priority);
 }
 
 void TicketHolder::release() {
-    check(sem_post(&_sem));
+    _totalReleased.fetchAndAdd(1);
+    _releaseTicket();
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -138,20 +85,19 @@ Status TicketHolder::resize(int newSize) {
 
     if (newSize < 5)
         return Status(ErrorCodes::BadValue,
-                      str::stream() << "Minimum value for semaphore is 5; given " << newSize);
-
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given " << newSize);
+                      str::stream() << "Minimum number of tickets is 5; given " << newSize);
 
+    // Adds and removes tickets without going through release() and waitForTicketUntil(), so that
+    // they are not counted as released or queued.
     while (_outof.load() < newSize) {
-        release();
         _outof.fetchAndAdd(1);
+        _releaseTicket();
     }
 
     while (_outof.load() > newSize) {
-        waitForTicket();
+        if (!_tryAcquireAvailable()) {
+            invariant(_waitInQueue(nullptr, Date_t::max(), AdmissionPriority::kNormal));
+        }
         _outof.subtractAndFetch(1);
     }
 
@@ -160,9 +106,7 @@ Status TicketHolder::resize(int newSize) {
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    check(sem_getvalue(&_sem, &val));
-    return val;
+    return _available.load();
 }
 
 int TicketHolder::used() const {
@@ -173,90 +117,135 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
+void TicketHolder::appendPriorityStats(BSONObjBuilder* b) const {
+    for (int i = 0; i < kNumAdmissionPriorities; ++i) {
+        const auto& stats = _priorityStats[i];
+        BSONObjBuilder bb(b->subobjStart(toString(static_cast<AdmissionPriority>(i))));
+        bb.append("waiting", stats.waiting.load());
+        bb.append("queued", stats.queued.load());
+        bb.append("totalQueuedMicros", stats.queuedMicros.load());
+        bb.done();
+    }
+}
 
-bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
+bool TicketHolder::_tryAcquireAvailable() {
+    int available = _available.load();
+    while (available > 0) {
+        if (_available.compareAndSwap(&available, available - 1)) {
+            return true;
+        }
+    }
+    return false;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
+bool TicketHolder::_waitInQueue(OperationContext* opCtx, Date_t until, AdmissionPriority priority) {
+    const int index = static_cast<int>(priority);
+    auto& queue = _queues[index];
 
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+    stdx::unique_lock<Latch> lk(_queueMutex);
+
+    // A priority which starts waiting again does not get credit for the time it did not compete
+    // for tickets.
+    if (queue.empty()) {
+        for (int i = 0; i < kNumAdmissionPriorities; ++i) {
+            if (i != index && !_queues[i].empty()) {
+                _virtualTime[index] = std::max(_virtualTime[index], _virtualTime[i]);
+            }
+        }
     }
-}
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
+    Waiter waiter;
+    waiter.position = queue.insert(queue.end(), &waiter);
+    _numWaiting.fetchAndAdd(1);
+    _priorityStats[index].waiting.fetchAndAdd(1);
+
+    // A ticket released after this waiter last tried to take one, but before it was queued, was
+    // made available rather than handed over.
+    _dispatch(lk);
+
+    auto leaveQueue = makeGuard([&] {
+        if (!waiter.granted) {
+            queue.erase(waiter.position);
+            _numWaiting.subtractAndFetch(1);
+            _priorityStats[index].waiting.subtractAndFetch(1);
+            return;
+        }
 
+        // The ticket was handed over after the deadline or the interruption, so pass it on.
+        if (_numWaiting.load() > 0) {
+            _grantToNextWaiter(lk);
+        } else {
+            _available.fetchAndAdd(1);
+        }
+    });
+
+    auto granted = [&] { return waiter.granted; };
+    bool acquired;
     if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
+        acquired = opCtx->waitForConditionOrInterruptUntil(waiter.cv, lk, until, granted);
+    } else if (until == Date_t::max()) {
+        waiter.cv.wait(lk, granted);
+        acquired = true;
     } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+        acquired = waiter.cv.wait_until(lk, until.toSystemTimePoint(), granted);
     }
-}
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
+    if (acquired) {
+        leaveQueue.dismiss();
     }
-    _newTicket.notify_one();
+    return acquired;
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
-
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+void TicketHolder::_releaseTicket() {
+    // Hand the ticket straight to a waiter if there is one, rather than making it available to
+    // whichever operation takes it first.
+    if (_numWaiting.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        if (_numWaiting.load() > 0) {
+            _grantToNextWaiter(lk);
+            return;
+        }
     }
 
-    _outof.store(newSize);
-    _num = _outof.load() - used;
+    _available.fetchAndAdd(1);
 
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
-}
+    // A waiter queues before trying to take an available ticket one last time, so either it sees
+    // the ticket made available above, or this sees the waiter.
+    if (_numWaiting.load() == 0) {
+        return;
+    }
 
-int TicketHolder::available() const {
-    return _num;
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    _dispatch(lk);
 }
 
-int TicketHolder::used() const {
-    return outof() - _num;
+void TicketHolder::_dispatch(WithLock lk) {
+    while (_numWaiting.load() > 0 && _tryAcquireAvailable()) {
+        _grantToNextWaiter(lk);
+    }
 }
 
-int TicketHolder::outof() const {
-    return _outof.load();
-}
+void TicketHolder::_grantToNextWaiter(WithLock) {
+    const int lowSharePercent = gLowPriorityAdmissionMinSharePercent.load();
+    const double weights[kNumAdmissionPriorities] = {double(100 - lowSharePercent),
+                                                     double(lowSharePercent)};
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
+    int next = -1;
+    for (int i = 0; i < kNumAdmissionPriorities; ++i) {
+        if (!_queues[i].empty() && (next < 0 || _virtualTime[i] < _virtualTime[next])) {
+            next = i;
         }
-        return false;
     }
-    _num--;
-    return true;
+    invariant(next >= 0);
+    _virtualTime[next] += 1.0 / weights[next];
+
+    Waiter* waiter = _queues[next].front();
+    _queues[next].pop_front();
+    _numWaiting.subtractAndFetch(1);
+    _priorityStats[next].waiting.subtractAndFetch(1);
+
+    waiter->granted = true;
+    waiter->cv.notify_one();
 }
-#endif
+
 }  // namespace mongo
@@ -28,19 +28,27 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <list>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+/**
+ * Hands out a limited number of tickets. Acquisitions which find no ticket available wait in one
+ * FIFO queue per AdmissionPriority, and each released ticket is handed to the head of one of the
+ * queues, chosen by weighted fair queuing so that low priority waiters receive at least
+ * 'lowPriorityAdmissionMinSharePercent' of the tickets while waiters of both priorities queue.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -56,7 +64,8 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       AdmissionPriority priority = AdmissionPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +77,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            AdmissionPriority priority = AdmissionPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,22 +93,91 @@ public:
 
     int outof() const;
 
+    /**
+     * Number of tickets released since construction, which approximates the number of operations
+     * that completed while holding a ticket.
+     */
+    long long totalReleased() const {
+        return _totalReleased.load();
+    }
+
+    /**
+     * Number of acquisitions since construction which could not get a ticket right away and had
+     * to wait for one, whether or not they eventually got it.
+     */
+    long long totalQueued() const {
+        return _totalQueued.load();
+    }
+
+    /**
+     * Appends, for each admission priority, the number of operations waiting for a ticket, the
+     * number of acquisitions which had to wait since construction and the total time they waited.
+     */
+    void appendPriorityStats(BSONObjBuilder* b) const;
+
 private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    struct Waiter;
+
+    /**
+     * Statistics on the acquisitions of one admission priority which had to wait for a ticket.
+     */
+    struct PriorityStats {
+        AtomicWord<int> waiting{0};
+        AtomicWord<long long> queued{0};
+        AtomicWord<long long> queuedMicros{0};
+    };
+
+    /**
+     * Takes an available ticket without queueing, if there is one.
+     */
+    bool _tryAcquireAvailable();
+
+    /**
+     * Queues behind the waiters of the same priority until a ticket is handed over, 'until' is
+     * reached or 'opCtx' is interrupted.
+     */
+    bool _waitInQueue(OperationContext* opCtx, Date_t until, AdmissionPriority priority);
+
+    /**
+     * Hands a ticket to a waiter if there are any, and otherwise makes it available.
+     */
+    void _releaseTicket();
+
+    /**
+     * Hands the available tickets to the waiters.
+     */
+    void _dispatch(WithLock);
+
+    /**
+     * Hands a ticket which is not available to the next waiter, taken from the queue of the
+     * priority with the least service received relative to its weight. There must be a waiter.
+     */
+    void _grantToNextWaiter(WithLock);
+
+    // Number of tickets neither held nor handed over to a waiter.
+    AtomicWord<int> _available;
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
-#else
-    bool _tryAcquire();
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 
-    AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
-#endif
+    // Number of waiters in all queues. Only changed while holding _queueMutex, and read without
+    // it by releases, which only need to take the mutex when there are waiters.
+    AtomicWord<int> _numWaiting{0};
+
+    Mutex _queueMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_queueMutex");
+    std::list<Waiter*> _queues[kNumAdmissionPriorities];
+
+    // Virtual time of each priority for weighted fair queuing: advanced by the inverse of the
+    // weight of the priority every time one of its waiters gets a ticket.
+    double _virtualTime[kNumAdmissionPriorities] = {};
+
+    PriorityStats _priorityStats[kNumAdmissionPriorities];
+
+    AtomicWord<long long> _totalReleased{0};
+    AtomicWord<long long> _totalQueued{0};
 };
 
 class ScopedTicket {
@@ -32,12 +32,27 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/concurrency/ticketholder_parameters_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 using namespace mongo;
 
+BSONObj getPriorityStats(const TicketHolder& holder, AdmissionPriority priority) {
+    BSONObjBuilder b;
+    holder.appendPriorityStats(&b);
+    return b.obj()[toString(priority)].Obj().getOwned();
+}
+
+void waitForWaiting(const TicketHolder& holder, AdmissionPriority priority, int expected) {
+    while (getPriorityStats(holder, priority)["waiting"].numberInt() != expected) {
+        sleepmillis(1);
+    }
+}
+
 TEST(TicketholderTest, BasicTimeout) {
     TicketHolder holder(1);
     ASSERT_EQ(holder.used(), 0);
@@ -72,4 +87,127 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, CountsReleasedAndQueuedAcquisitions) {
+    TicketHolder holder(5);
+    ASSERT_EQ(0, holder.totalReleased());
+    ASSERT_EQ(0, holder.totalQueued());
+
+    {
+        ScopedTicket ticket(&holder);
+        ASSERT(holder.waitForTicketUntil(Date_t::now()));
+        holder.release();
+    }
+    ASSERT_EQ(2, holder.totalReleased());
+    ASSERT_EQ(0, holder.totalQueued());
+
+    // Only acquisitions which find no ticket available are counted as queued
+    ASSERT_OK(holder.resize(5));
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(1)));
+    ASSERT_EQ(1, holder.totalQueued());
+
+    // Resizing does not count as releasing or acquiring tickets
+    ASSERT_OK(holder.resize(6));
+    ASSERT(holder.waitForTicketUntil(Date_t::now()));
+    for (int i = 0; i < 6; ++i) {
+        holder.release();
+    }
+    ASSERT_EQ(8, holder.totalReleased());
+    ASSERT_EQ(1, holder.totalQueued());
+    ASSERT_EQ(0, holder.used());
+}
+
+TEST(TicketholderTest, LowPriorityWaitersGetTheirMinimumShare) {
+    const int originalSharePercent = gLowPriorityAdmissionMinSharePercent.load();
+    gLowPriorityAdmissionMinSharePercent.store(25);
+    ON_BLOCK_EXIT([&] { gLowPriorityAdmissionMinSharePercent.store(originalSharePercent); });
+
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    const int numWaitersPerPriority = 8;
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<AdmissionPriority> admitted;
+    std::vector<stdx::thread> threads;
+    for (auto priority : {AdmissionPriority::kLow, AdmissionPriority::kNormal}) {
+        for (int i = 0; i < numWaitersPerPriority; ++i) {
+            threads.emplace_back([&, priority] {
+                holder.waitForTicket(nullptr, priority);
+                stdx::lock_guard<Latch> lk(mutex);
+                admitted.push_back(priority);
+            });
+        }
+        waitForWaiting(holder, priority, numWaitersPerPriority);
+    }
+
+    // Each released ticket is handed to a waiter, so that none becomes available.
+    for (int i = 0; i < numWaitersPerPriority; ++i) {
+        holder.release();
+    }
+    ASSERT_EQ(0, holder.available());
+    waitForWaiting(holder, AdmissionPriority::kLow, numWaitersPerPriority - 2);
+    waitForWaiting(holder, AdmissionPriority::kNormal, 2);
+
+    for (int i = 0; i < numWaitersPerPriority; ++i) {
+        holder.release();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(2U * numWaitersPerPriority, admitted.size());
+    ASSERT_EQ(5, holder.used());
+
+    for (auto priority : {AdmissionPriority::kLow, AdmissionPriority::kNormal}) {
+        auto stats = getPriorityStats(holder, priority);
+        ASSERT_EQ(0, stats["waiting"].numberInt()) << stats;
+        ASSERT_EQ(numWaitersPerPriority, stats["queued"].numberLong()) << stats;
+        ASSERT_GT(stats["totalQueuedMicros"].numberLong(), 0) << stats;
+    }
+}
+
+TEST(TicketholderTest, ReleasedTicketsGoToWaitersBeforeNewArrivals) {
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    stdx::thread waiter([&] { holder.waitForTicket(nullptr, AdmissionPriority::kLow); });
+    waitForWaiting(holder, AdmissionPriority::kLow, 1);
+
+    // The released ticket is handed to the waiter, so a new arrival cannot take it, whatever its
+    // priority.
+    holder.release();
+    ASSERT_EQ(0, holder.available());
+    ASSERT_FALSE(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(nullptr, Date_t::now(), AdmissionPriority::kNormal));
+
+    waiter.join();
+    ASSERT_EQ(5, holder.used());
+}
+
+TEST(TicketholderTest, WaitersWhichTimeOutLeaveTheQueue) {
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(10), AdmissionPriority::kLow));
+    auto lowStats = getPriorityStats(holder, AdmissionPriority::kLow);
+    ASSERT_EQ(0, lowStats["waiting"].numberInt()) << lowStats;
+    ASSERT_EQ(1, lowStats["queued"].numberLong()) << lowStats;
+    ASSERT_GT(lowStats["totalQueuedMicros"].numberLong(), 0) << lowStats;
+    ASSERT_EQ(0, getPriorityStats(holder, AdmissionPriority::kNormal)["queued"].numberLong());
+
+    // With no waiter left, a released ticket becomes available.
+    holder.release();
+    ASSERT_EQ(1, holder.available());
+    ASSERT(holder.waitForTicketUntil(nullptr, Date_t::now(), AdmissionPriority::kLow));
+    ASSERT_EQ(5, holder.used());
+}
 }  // namespace
@@ -32,6 +32,7 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/util/future.h"
+#include "mongo/util/out_of_line_executor.h"
 
 namespace mongo {
 
@@ -198,6 +199,55 @@ void BM_futureInt4xDeferredThenChained(benchmark::State& state) {
     }
 }
 
+// Remote requests commonly chain 10 to 20 continuations, such as to check the response, retry on
+// errors and convert the result.
+void BM_futureIntDeferredThenChain(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto pf = makePromiseFuture<int>();
+        auto fut = std::move(pf.future);
+        for (int64_t n = 0; n < state.range(0); ++n) {
+            fut = std::move(fut).then([](int i) { return i + 1; });
+        }
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(std::move(fut).get());
+    }
+}
+
+void BM_futureIntReadyThenChain(benchmark::State& state) {
+    for (auto _ : state) {
+        auto fut = makeReadyFutWithPromise();
+        for (int64_t n = 0; n < state.range(0); ++n) {
+            fut = std::move(fut).then([](int i) { return i + 1; });
+        }
+        benchmark::DoNotOptimize(std::move(fut).get());
+    }
+}
+
+/**
+ * Runs tasks inline, so that only the cost of chaining continuations through an executor is
+ * measured.
+ */
+class InlineExecutor : public OutOfLineExecutor {
+public:
+    void schedule(Task task) override {
+        task(Status::OK());
+    }
+};
+
+void BM_executorFutureIntDeferredThenChain(benchmark::State& state) {
+    auto executor = std::make_shared<InlineExecutor>();
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto pf = makePromiseFuture<int>();
+        auto fut = std::move(pf.future).thenRunOn(executor);
+        for (int64_t n = 0; n < state.range(0); ++n) {
+            fut = std::move(fut).then([](int i) { return i + 1; });
+        }
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(std::move(fut).get());
+    }
+}
 
 BENCHMARK(BM_plainIntReady);
 BENCHMARK(BM_futureIntReady);
@@ -212,5 +262,8 @@ BENCHMARK(BM_futureInt3xDeferredThenNested);
 BENCHMARK(BM_futureInt3xDeferredThenChained);
 BENCHMARK(BM_futureInt4xDeferredThenNested);
 BENCHMARK(BM_futureInt4xDeferredThenChained);
+BENCHMARK(BM_futureIntDeferredThenChain)->Arg(1)->Arg(5)->Arg(10)->Arg(20);
+BENCHMARK(BM_futureIntReadyThenChain)->Arg(1)->Arg(5)->Arg(10)->Arg(20);
+BENCHMARK(BM_executorFutureIntDeferredThenChain)->Arg(1)->Arg(5)->Arg(10)->Arg(20);
 
 }  // namespace mongo
@@ -31,7 +31,9 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
+#include <cstddef>
 #include <forward_list>
+#include <new>
 #include <type_traits>
 
 #include "mongo/base/checked_cast.h"
@@ -359,6 +361,64 @@ enum class SSBState : uint8_t {
     kFinished,
 };
 
+class SharedStateBase;
+
+/**
+ * The callback of a SharedState, which takes the SharedState as input when it is completed.
+ * Callbacks are set at most once and never move, so those that fit in kInlineSize bytes, which
+ * includes the continuations made by then() and its siblings for all but the largest captures,
+ * are stored inline rather than in an allocation of their own.
+ */
+class SharedStateCallback {
+public:
+    static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+    SharedStateCallback() = default;
+    SharedStateCallback(const SharedStateCallback&) = delete;
+    SharedStateCallback& operator=(const SharedStateCallback&) = delete;
+
+    ~SharedStateCallback() {
+        if (_destroyInline) {
+            _destroyInline(&_inline);
+        }
+    }
+
+    template <typename Func>
+    SharedStateCallback& operator=(Func&& func) {
+        using Stored = std::decay_t<Func>;
+        invariant(!*this);
+        if constexpr (sizeof(Stored) <= kInlineSize &&
+                      alignof(Stored) <= alignof(std::max_align_t)) {
+            new (&_inline) Stored(std::forward<Func>(func));
+            _callInline = [](void* stored, SharedStateBase* input) {
+                (*static_cast<Stored*>(stored))(input);
+            };
+            _destroyInline = [](void* stored) { static_cast<Stored*>(stored)->~Stored(); };
+        } else {
+            _outOfLine = std::forward<Func>(func);
+        }
+        return *this;
+    }
+
+    void operator()(SharedStateBase* input) {
+        if (_callInline) {
+            _callInline(&_inline, input);
+        } else {
+            _outOfLine(input);
+        }
+    }
+
+    explicit operator bool() const {
+        return _callInline || _outOfLine;
+    }
+
+private:
+    std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)> _inline;
+    void (*_callInline)(void* stored, SharedStateBase* input) = nullptr;
+    void (*_destroyInline)(void* stored) = nullptr;
+    unique_function<void(SharedStateBase* input)> _outOfLine;
+};
+
 class SharedStateBase : public RefCountable {
 public:
     using Children = std::forward_list<boost::intrusive_ptr<SharedStateBase>>;
@@ -493,7 +553,7 @@ public:
     boost::intrusive_ptr<SharedStateBase> continuation;  // F
 
     // Takes this as argument and usually writes to continuation.
-    unique_function<void(SharedStateBase* input)> callback;  // F
+    SharedStateCallback callback;  // F
 
     // These are only used to signal completion to blocking waiters. Benchmarks showed that it was
     // worth deferring the construction of cv, so it can be avoided when it isn't necessary.
@@ -31,6 +31,8 @@
 
 #include "mongo/util/future.h"
 
+#include <array>
+
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
@@ -342,6 +344,61 @@ TEST(Future_EdgeCases, SharedPromise_CompleteWithUnreadyFuture) {
     sf.get();
 }
 
+// Continuations are stored inline in their SharedState when their captures are small enough, and
+// in an allocation of their own otherwise. Either way, their captures are destroyed exactly once.
+TEST(Future_EdgeCases, Continuations_with_small_and_large_captures) {
+    auto token = std::make_shared<int>(0);
+    std::array<char, 256> largeCapture{};
+    {
+        auto [promise, future] = makePromiseFuture<int>();
+        auto fut = std::move(future)
+                       .then([token](int i) { return i + *token + 1; })
+                       .then([token, largeCapture](int i) { return i + largeCapture[0] + 1; })
+                       .then([token](int i) { return i + 1; });
+        ASSERT_EQ(token.use_count(), 4);
+
+        promise.emplaceValue(0);
+        ASSERT_EQ(std::move(fut).get(), 3);
+    }
+    ASSERT_EQ(token.use_count(), 1);
+}
+
+// A continuation chain is often built on one thread and completed, and so freed, on another, such
+// as a network thread.
+TEST(Future_EdgeCases, Continuations_freed_on_another_thread) {
+    auto token = std::make_shared<int>(0);
+    auto [promise, future] = makePromiseFuture<int>();
+    auto fut = std::move(future)
+                   .then([token](int i) { return i + 1; })
+                   .then([token](int i) { return i + 1; });
+    ASSERT_EQ(token.use_count(), 3);
+
+    stdx::thread thread([&promise = promise, fut = std::move(fut)]() mutable {
+        promise.emplaceValue(0);
+        ASSERT_EQ(std::move(fut).get(), 2);
+    });
+    thread.join();
+    ASSERT_EQ(token.use_count(), 1);
+}
+
+// The SharedStates of a continuation chain may outlive the thread which created them.
+TEST(Future_EdgeCases, Continuations_outlive_the_thread_which_created_them) {
+    auto token = std::make_shared<int>(0);
+    auto [promise, future] = makePromiseFuture<int>();
+    Future<int> fut;
+    stdx::thread thread([&, future = std::move(future)]() mutable {
+        fut = std::move(future)
+                  .then([token](int i) { return i + 1; })
+                  .then([token](int i) { return i + 1; });
+    });
+    thread.join();
+    ASSERT_EQ(token.use_count(), 3);
+
+    promise.emplaceValue(0);
+    ASSERT_EQ(std::move(fut).get(), 2);
+    ASSERT_EQ(token.use_count(), 1);
+}
+
 // Make sure we actually die if someone throws from the getAsync callback.
 //
 // With gcc 5.8 we terminate, but print "terminate() called. No exception is active". This works in